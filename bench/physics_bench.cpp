@@ -0,0 +1,285 @@
+/**
+ * @file physics_bench.cpp
+ * @brief 无窗口运行完整的 PhysicsEngine::update，测量每步耗时、碰撞对数与堆分配次数。
+ *
+ * 场景使用合成的瓦片图层（四周为实体墙，地面按场景生成），不初始化 SDL 视频子系统：
+ * - gravity：平整地面，物体分散在上方自由下落，空中按密度随机放置实体瓦片；
+ * - crowd：物体紧密重叠地堆在地图中央，考察粗检测、窄检测与推离（不使用密度）；
+ * - slopes：起伏的斜坡地形（1x1 与 2x1 斜坡随机出现），密度为每列地面高度变化的概率。
+ *
+ * 用法：sunnyland_physics_bench [场景=gravity|crowd|slopes] [刚体数量=2000] [步数=600]
+ *                               [地图宽=256] [地图高=64] [密度=0.05，slopes 为 0.3] [线程数=1]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <spdlog/spdlog.h>
+#include "../src/engine/component/collider_component.h"
+#include "../src/engine/component/physics_component.h"
+#include "../src/engine/component/tilelayer_component.h"
+#include "../src/engine/component/transform_component.h"
+#include "../src/engine/object/game_object.h"
+#include "../src/engine/physics/collider.h"
+#include "../src/engine/physics/physics_engine.h"
+
+namespace {
+
+	/// 进程内 operator new 的调用次数（只统计，不改变分配行为）
+	std::atomic<std::uint64_t> g_allocation_count{ 0 };
+
+	void* countedAlloc(std::size_t size)
+	{
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+		throw std::bad_alloc();
+	}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+	using engine::component::TileType;
+
+	enum class Scenario { GRAVITY, CROWD, SLOPES };
+
+	struct BenchOptions {
+		Scenario scenario = Scenario::GRAVITY;
+		int body_count = 2000;
+		int steps = 600;
+		glm::ivec2 map_size{ 256, 64 };
+		float density = 0.05f;
+		size_t threads = 1;
+	};
+
+	constexpr glm::ivec2 TILE_SIZE{ 16, 16 };
+	constexpr glm::vec2 BODY_SIZE{ 12.0f, 12.0f };
+
+	const char* scenarioName(Scenario scenario)
+	{
+		switch (scenario) {
+		case Scenario::CROWD: return "crowd";
+		case Scenario::SLOPES: return "slopes";
+		case Scenario::GRAVITY:
+		default: return "gravity";
+		}
+	}
+
+	bool parseScenario(const char* text, Scenario& out)
+	{
+		if (std::strcmp(text, "gravity") == 0) out = Scenario::GRAVITY;
+		else if (std::strcmp(text, "crowd") == 0) out = Scenario::CROWD;
+		else if (std::strcmp(text, "slopes") == 0) out = Scenario::SLOPES;
+		else return false;
+		return true;
+	}
+
+	/**
+	 * @brief 生成瓦片类型网格（行优先）。
+	 * @details 四周为 SOLID。slopes 场景的地面是随机游走的高度场，每列以 density 的概率升高或降低一格，
+	 *          在变化处放置 1x1 或 2x1 斜坡；其余场景地面为最底一行，gravity 场景另在顶部四分之一以下
+	 *          按 density 随机放置 SOLID 瓦片。
+	 */
+	std::vector<TileType> buildTileTypes(const BenchOptions& options, std::mt19937& rng)
+	{
+		const int width = options.map_size.x;
+		const int height = options.map_size.y;
+		std::vector<TileType> types(static_cast<size_t>(width) * static_cast<size_t>(height), TileType::EMPTY);
+		auto at = [&](int x, int y) -> TileType& { return types[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)]; };
+
+		for (int y = 0; y < height; ++y) {
+			at(0, y) = TileType::SOLID;
+			at(width - 1, y) = TileType::SOLID;
+		}
+
+		// 把第 x 列从 top 行到底部填为 SOLID
+		auto fill = [&](int x, int top) { for (int y = top; y < height; ++y) at(x, y) = TileType::SOLID; };
+
+		if (options.scenario == Scenario::SLOPES) {
+			std::bernoulli_distribution change(std::clamp(options.density, 0.0f, 1.0f));
+			std::bernoulli_distribution coin(0.5);
+			const int min_level = height / 2;
+			int level = height - 4; // 当前地面最上层实体瓦片所在行
+			for (int x = 1; x < width - 1; ++x) {
+				if (!change(rng)) {
+					fill(x, level);
+					continue;
+				}
+				const bool wide = x + 2 < width && coin(rng);
+				const bool up = level - 1 >= min_level && (level + 1 >= height || coin(rng));
+				if (up) {
+					// 上坡：斜坡放在当前地面之上，之后的地面升高一格
+					at(x, level - 1) = wide ? TileType::SLOPE_0_2 : TileType::SLOPE_0_1;
+					if (wide) at(x + 1, level - 1) = TileType::SLOPE_2_1;
+					fill(x, level);
+					if (wide) fill(x + 1, level);
+					--level;
+				}
+				else {
+					// 下坡：斜坡占据原地面最上层一行，斜坡下方及之后的地面降低一格
+					at(x, level) = wide ? TileType::SLOPE_1_2 : TileType::SLOPE_1_0;
+					if (wide) at(x + 1, level) = TileType::SLOPE_2_0;
+					fill(x, level + 1);
+					if (wide) fill(x + 1, level + 1);
+					++level;
+				}
+				if (wide) ++x;
+			}
+			return types;
+		}
+
+		for (int x = 0; x < width; ++x) at(x, height - 1) = TileType::SOLID;
+		if (options.scenario != Scenario::GRAVITY) return types;
+
+		std::bernoulli_distribution solid(std::clamp(options.density, 0.0f, 1.0f));
+		for (int y = height / 4; y < height - 2; ++y) {
+			for (int x = 1; x < width - 1; ++x) {
+				if (solid(rng)) at(x, y) = TileType::SOLID;
+			}
+		}
+		return types;
+	}
+
+	/// 创建瓦片图层对象并注册到物理引擎（与 LevelLoader + GameScene 的流程一致）
+	std::unique_ptr<engine::object::GameObject> createTileLayer(const BenchOptions& options,
+		engine::physics::PhysicsEngine& engine, std::mt19937& rng)
+	{
+		const auto types = buildTileTypes(options, rng);
+		// 每种瓦片类型一个原型，原型下标即类型值（EMPTY 为 0）
+		std::vector<engine::component::TileInfo> prototypes;
+		for (int type = 0; type <= static_cast<int>(TileType::LEVEL_EXIT); ++type) {
+			prototypes.emplace_back(engine::render::Sprite(), static_cast<TileType>(type));
+		}
+		std::vector<std::uint16_t> cells;
+		cells.reserve(types.size());
+		for (const auto type : types) {
+			cells.push_back(static_cast<std::uint16_t>(type));
+		}
+
+		auto layer = std::make_unique<engine::object::GameObject>("main");
+		layer->addComponent<engine::component::TransformComponent>(glm::vec2(0.0f));
+		auto* tile_layer = layer->addComponent<engine::component::TileLayerComponent>(TILE_SIZE, options.map_size, std::move(prototypes), std::move(cells));
+		tile_layer->buildStaticColliders();
+		engine.registerCollisionLayer(tile_layer);
+		return layer;
+	}
+
+	/**
+	 * @brief 生成刚体的初始位置与速度。
+	 * @details crowd 场景把物体以小于自身尺寸的间距排成方阵，放在地图中央；
+	 *          其余场景在地图顶部四分之一内随机分布，并带有随机水平速度。
+	 */
+	void spawnBodies(const BenchOptions& options, engine::physics::PhysicsEngine& engine, std::mt19937& rng,
+		std::vector<std::unique_ptr<engine::object::GameObject>>& out_objects)
+	{
+		const glm::vec2 world_size = glm::vec2(options.map_size * TILE_SIZE);
+		const glm::vec2 margin = glm::vec2(TILE_SIZE) * 1.5f;
+		std::uniform_real_distribution<float> x_dist(margin.x, world_size.x - margin.x - BODY_SIZE.x);
+		std::uniform_real_distribution<float> y_dist(margin.y, std::max(margin.y + 1.0f, world_size.y * 0.25f - BODY_SIZE.y));
+		std::uniform_real_distribution<float> speed_dist(-120.0f, 120.0f);
+
+		const int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(options.body_count))));
+		const float spacing = BODY_SIZE.x * 0.75f;
+		const glm::vec2 crowd_origin{ world_size.x * 0.5f - columns * spacing * 0.5f, margin.y };
+
+		out_objects.reserve(out_objects.size() + static_cast<size_t>(options.body_count));
+		for (int i = 0; i < options.body_count; ++i) {
+			glm::vec2 position{ x_dist(rng), y_dist(rng) };
+			glm::vec2 velocity{ speed_dist(rng), 0.0f };
+			if (options.scenario == Scenario::CROWD) {
+				position = crowd_origin + glm::vec2(static_cast<float>(i % columns), static_cast<float>(i / columns)) * spacing;
+				velocity = glm::vec2(0.0f);
+			}
+
+			auto object = std::make_unique<engine::object::GameObject>("body");
+			object->addComponent<engine::component::TransformComponent>(position);
+			object->addComponent<engine::component::ColliderComponent>(std::make_unique<engine::physics::AABBCollider>(BODY_SIZE));
+			auto* physics = object->addComponent<engine::component::PhysicsComponent>(&engine, true);
+			physics->velocity_ = velocity;
+			out_objects.push_back(std::move(object));
+		}
+	}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	if (argc > 1 && !parseScenario(argv[1], options.scenario)) {
+		std::fprintf(stderr, "unknown scenario '%s' (expected gravity, crowd or slopes)\n", argv[1]);
+		return 2;
+	}
+	if (options.scenario == Scenario::SLOPES) options.density = 0.3f;
+	if (argc > 2) options.body_count = std::max(1, std::atoi(argv[2]));
+	if (argc > 3) options.steps = std::max(1, std::atoi(argv[3]));
+	if (argc > 4) options.map_size.x = std::max(8, std::atoi(argv[4]));
+	if (argc > 5) options.map_size.y = std::max(8, std::atoi(argv[5]));
+	if (argc > 6) options.density = static_cast<float>(std::atof(argv[6]));
+	if (argc > 7) options.threads = static_cast<size_t>(std::max(1, std::atoi(argv[7])));
+
+	// 注册/注销刚体会输出 info 日志，基准测试只保留警告与错误
+	spdlog::set_level(spdlog::level::warn);
+
+	std::mt19937 rng(12345);
+	engine::physics::PhysicsEngine engine;
+	engine.setWorkerThreadCount(options.threads);
+	engine.setWorldBounds({ glm::vec2(0.0f), glm::vec2(options.map_size * TILE_SIZE) });
+
+	std::vector<std::unique_ptr<engine::object::GameObject>> objects;
+	objects.push_back(createTileLayer(options, engine, rng));
+	spawnBodies(options, engine, rng, objects);
+
+	const float dt = 1.0f / 60.0f;
+	// 预热一步，排除首次扩容各缓冲区的分配
+	engine.update(dt);
+	engine.resetStats();
+
+	std::uint64_t candidate_pairs = 0;
+	std::uint64_t colliding_pairs = 0;
+	const std::uint64_t allocations_before = g_allocation_count.load(std::memory_order_relaxed);
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < options.steps; ++i) {
+		engine.update(dt);
+		const auto& stats = engine.getStats();
+		candidate_pairs += stats.candidate_pairs;
+		colliding_pairs += stats.colliding_pairs;
+	}
+	const auto end = std::chrono::steady_clock::now();
+	const std::uint64_t allocations = g_allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+	const double total_ns = std::chrono::duration<double, std::nano>(end - start).count();
+	const double steps = static_cast<double>(options.steps);
+	const auto& stats = engine.getStats();
+	std::printf("scenario: %s, bodies: %d, steps: %d, map: %dx%d, density: %.3f, threads: %zu\n",
+		scenarioName(options.scenario), options.body_count, options.steps,
+		options.map_size.x, options.map_size.y, options.density, options.threads);
+	std::printf("time:        %12.1f ns/step  (%.2f ns/body/step)\n", total_ns / steps, total_ns / (steps * options.body_count));
+	std::printf("pairs:       %12.1f candidate/step, %.1f colliding/step, peak %zu\n",
+		static_cast<double>(candidate_pairs) / steps, static_cast<double>(colliding_pairs) / steps, stats.peak_candidate_pairs);
+	std::printf("allocations: %12.2f /step\n", static_cast<double>(allocations) / steps);
+	std::printf("final state: %zu awake, %zu sleeping, hash %016llx\n",
+		stats.awake_bodies, stats.sleeping_bodies, static_cast<unsigned long long>(engine.computeStateHash()));
+
+	// 从后往前销毁，注销刚体时只需删除存储末尾的元素；图层最后销毁
+	while (objects.size() > 1) objects.pop_back();
+	objects.clear();
+	return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file physics_layout_bench.cpp
+ * @brief 对比物理积分在"对象 + 组件指针"布局与 SoA 刚体存储下的耗时。
+ *
+ * 旧布局模拟原先的做法：每个对象单独分配在堆上，组件保存在按类型索引的哈希表中，
+ * 每步通过 getComponent 查找再逐个积分。新布局使用 BodyStorage 与 integrateBodies。
+ *
+ * 用法：sunnyland_layout_bench [刚体数量=10000] [步数=600]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <glm/vec2.hpp>
+#include <glm/glm.hpp>
+#include "../src/engine/physics/body_storage.h"
+
+namespace {
+
+	/// 旧布局中的组件基类
+	struct LegacyComponent {
+		virtual ~LegacyComponent() = default;
+	};
+
+	struct LegacyTransform final : LegacyComponent {
+		glm::vec2 position{ 0.0f, 0.0f };
+	};
+
+	struct LegacyPhysics final : LegacyComponent {
+		glm::vec2 velocity{ 0.0f, 0.0f };
+		glm::vec2 force{ 0.0f, 0.0f };
+		float mass = 1.0f;
+		bool use_gravity = true;
+		bool enabled = true;
+	};
+
+	/// 旧布局中的游戏对象：组件按类型保存在哈希表中
+	struct LegacyObject {
+		std::unordered_map<std::type_index, std::unique_ptr<LegacyComponent>> components;
+
+		template<typename T>
+		T* getComponent() const {
+			const auto it = components.find(std::type_index(typeid(T)));
+			return it != components.end() ? static_cast<T*>(it->second.get()) : nullptr;
+		}
+	};
+
+	/// 按原先 PhysicsEngine::update 的方式积分：F += g * m，v += F / m * dt，再限速
+	void integrateLegacy(const std::vector<std::unique_ptr<LegacyObject>>& objects, const glm::vec2& gravity, float max_speed, float dt)
+	{
+		for (const auto& obj : objects) {
+			auto* pc = obj->getComponent<LegacyPhysics>();
+			if (!pc || !pc->enabled) continue;
+			if (pc->use_gravity) {
+				pc->force += gravity * pc->mass;
+			}
+			pc->velocity += (pc->force / pc->mass) * dt;
+			pc->force = glm::vec2(0.0f);
+			pc->velocity = glm::clamp(pc->velocity, -max_speed, max_speed);
+		}
+	}
+
+	template<typename Fn>
+	double measureMs(int steps, Fn&& fn)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < steps; ++i) fn();
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const int body_count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10000;
+	const int steps = argc > 2 ? std::max(1, std::atoi(argv[2])) : 600;
+	const glm::vec2 gravity{ 0.0f, 980.0f };
+	const float max_speed = 5000.0f;
+	const float dt = 1.0f / 60.0f;
+
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> velocity_dist(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> mass_dist(0.5f, 4.0f);
+	std::bernoulli_distribution gravity_dist(0.8);
+
+	// 1. 旧布局：对象与组件分散在堆上，并穿插一些无关分配以模拟真实的内存碎片
+	std::vector<std::unique_ptr<LegacyObject>> objects;
+	std::vector<std::unique_ptr<char[]>> padding;
+	objects.reserve(static_cast<size_t>(body_count));
+	// 2. 新布局：同样的初始数据写入 SoA 存储
+	engine::physics::BodyStorage storage;
+
+	for (int i = 0; i < body_count; ++i) {
+		const glm::vec2 velocity{ velocity_dist(rng), velocity_dist(rng) };
+		const float mass = mass_dist(rng);
+		const bool use_gravity = gravity_dist(rng);
+
+		auto obj = std::make_unique<LegacyObject>();
+		obj->components[std::type_index(typeid(LegacyTransform))] = std::make_unique<LegacyTransform>();
+		padding.push_back(std::make_unique<char[]>(96));
+		auto physics = std::make_unique<LegacyPhysics>();
+		physics->velocity = velocity;
+		physics->mass = mass;
+		physics->use_gravity = use_gravity;
+		obj->components[std::type_index(typeid(LegacyPhysics))] = std::move(physics);
+		objects.push_back(std::move(obj));
+
+		storage.create(nullptr, nullptr, nullptr);
+		auto& arrays = storage.arrays();
+		arrays.velocity.back() = velocity;
+		arrays.inverse_mass.back() = 1.0f / mass;
+		arrays.gravity_scale.back() = use_gravity ? 1.0f : 0.0f;
+		arrays.flags.back() = engine::physics::body_flag::ENABLED | engine::physics::body_flag::SIMULATE;
+	}
+
+	// 预热一次，排除首次访问的缺页开销
+	integrateLegacy(objects, gravity, max_speed, dt);
+	engine::physics::integrateBodies(storage.arrays(), gravity, max_speed, dt);
+
+	const double legacy_ms = measureMs(steps, [&] { integrateLegacy(objects, gravity, max_speed, dt); });
+	const double soa_ms = measureMs(steps, [&] { engine::physics::integrateBodies(storage.arrays(), gravity, max_speed, dt); });
+
+	// 校验两种布局的结果一致（防止编译器优化掉循环，也确认积分公式等价）
+	double max_diff = 0.0;
+	const auto& arrays = storage.arrays();
+	for (size_t i = 0; i < objects.size(); ++i) {
+		const glm::vec2 diff = glm::abs(objects[i]->getComponent<LegacyPhysics>()->velocity - arrays.velocity[i]);
+		max_diff = std::max(max_diff, static_cast<double>(std::max(diff.x, diff.y)));
+	}
+
+	std::printf("bodies: %d, steps: %d\n", body_count, steps);
+	std::printf("legacy (object + component lookup): %10.3f ms  (%.2f ns/body/step)\n",
+		legacy_ms, legacy_ms * 1.0e6 / (static_cast<double>(body_count) * steps));
+	std::printf("soa (BodyStorage + integrateBodies): %9.3f ms  (%.2f ns/body/step)\n",
+		soa_ms, soa_ms * 1.0e6 / (static_cast<double>(body_count) * steps));
+	std::printf("speedup: %.2fx, max velocity difference: %g\n", legacy_ms / std::max(soa_ms, 1.0e-9), max_diff);
+	return max_diff < 1.0e-2 ? 0 : 1;
+}
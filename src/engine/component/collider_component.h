@@ -8,7 +8,9 @@
 #include <glm/vec2.hpp>
 #include "../utils/alignment.h"
 #include "../utils/math.h"
+#include "../physics/collision_layers.h"
 #include <memory>
+#include <cstdint>
 
 namespace engine {
 	namespace physics {
@@ -44,6 +46,10 @@ namespace engine::component {
 		bool is_trigger_{ false };
 		/// 碰撞体是否启用
 		bool is_active_{ true };
+		/// 碰撞层（单个位）
+		std::uint32_t layer_{ engine::physics::collision_layer::DEFAULT };
+		/// 碰撞掩码，只与掩码中的层产生碰撞
+		std::uint32_t mask_{ engine::physics::collision_layer::ALL };
 
 	public:
 		/**
@@ -135,6 +141,17 @@ namespace engine::component {
 		 */
 		engine::physics::Collider* getCollider() const { return collider_.get(); }
 
+		/**
+		 * @brief 设置碰撞层与掩码。
+		 * @param filter 碰撞过滤器
+		 */
+		void setCollisionFilter(const engine::physics::CollisionFilter& filter) { layer_ = filter.layer; mask_ = filter.mask; }
+
+		void setLayer(std::uint32_t layer) { layer_ = layer; }    ///< @brief 设置碰撞层
+		void setMask(std::uint32_t mask) { mask_ = mask; }        ///< @brief 设置碰撞掩码
+		std::uint32_t getLayer() const { return layer_; }         ///< @brief 获取碰撞层
+		std::uint32_t getMask() const { return mask_; }           ///< @brief 获取碰撞掩码
+
 
 
 	private:
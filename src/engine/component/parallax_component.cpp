@@ -74,7 +74,8 @@ void ParallaxComponent::render(engine::core::Context& context)
 	context.getRenderer().drawParallax(context.getCamera(),
 									   sprite_,transform_->getPosition(), 
 									   parallax_factor_,repeat_,
-									   transform_->getScale());
+									   transform_->getScale(),
+									   engine::render::RenderOrder{ owner_->getRenderLayer() });
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "../object/game_object.h"
 #include "transform_component.h"
 #include "../physics/physics_engine.h"
+#include <glm/glm.hpp>
 
 /**
  * @brief 构造函数，创建一个新的物理组件。
@@ -44,7 +45,7 @@ void engine::component::PhysicsComponent::init()
 		return;
 	}
 	if (physics_engine_) {
-		physics_engine_->registerPhysicsComponent(this);
+		body_handle_ = physics_engine_->registerPhysicsComponent(this);
 		spdlog::trace("PhysicsComponent 初始化完成并注册到 PhysicsEngine");
 	} else {
 		spdlog::error("PhysicsComponent 初始化失败：PhysicsEngine 为空");
@@ -63,6 +64,64 @@ void engine::component::PhysicsComponent::update(float /*deltaTime*/, engine::co
 	// 物理更新由 PhysicsEngine 统一处理
 }
 
+/**
+ * @brief 设置运动学路径，并将物体设为运动学刚体。
+ * @param points 途经点（Transform 位置）
+ * @param speed 移动速率（单位/秒），负值按 0 处理
+ * @param loop 是否首尾循环
+ */
+void engine::component::PhysicsComponent::setKinematicPath(std::vector<glm::vec2> points, float speed, bool loop)
+{
+	path_points_ = std::move(points);
+	path_speed_ = std::max(speed, 0.0f);
+	path_loop_ = loop;
+	path_target_ = 0;
+	path_direction_ = 1;
+	setKinematic(true);
+}
+
+/**
+ * @brief 沿运动学路径前进一步。
+ * @param position 当前 Transform 位置
+ * @param dt 时间步长
+ * @return 本步位移
+ *
+ * 到达途经点后剩余的距离继续用于下一段，因此速率不受途经点间距影响。
+ * 只有一个途经点时到达后停止。
+ */
+glm::vec2 engine::component::PhysicsComponent::advanceKinematicPath(const glm::vec2& position, float dt)
+{
+	if (path_points_.empty()) return glm::vec2(0.0f);
+
+	glm::vec2 current = position;
+	float remaining = path_speed_ * dt;
+	// 途经点重合时一步内可能连续经过多个点，限制段数避免死循环
+	for (size_t segments = 0; remaining > 0.0f && segments <= path_points_.size() * 2; ++segments) {
+		const glm::vec2 target = path_points_[path_target_];
+		const glm::vec2 to_target = target - current;
+		const float distance = glm::length(to_target);
+		if (distance > remaining) {
+			current += to_target * (remaining / distance);
+			break;
+		}
+		current = target;
+		remaining -= distance;
+
+		const size_t count = path_points_.size();
+		if (count < 2) break;
+		if (path_loop_) {
+			path_target_ = (path_target_ + 1) % count;
+		}
+		else {
+			if ((path_direction_ > 0 && path_target_ + 1 >= count) || (path_direction_ < 0 && path_target_ == 0)) {
+				path_direction_ = -path_direction_;
+			}
+			path_target_ = static_cast<size_t>(static_cast<std::ptrdiff_t>(path_target_) + path_direction_);
+		}
+	}
+	return current - position;
+}
+
 /**
  * @brief 组件清理，从物理引擎中注销。
  * 
@@ -71,7 +130,7 @@ void engine::component::PhysicsComponent::update(float /*deltaTime*/, engine::co
  */
 void engine::component::PhysicsComponent::clean()
 {
-	if (physics_engine_) {
+	if (physics_engine_ && body_handle_.isValid()) {
 		physics_engine_->unregisterPhysicsComponent(this);
 		spdlog::trace("PhysicsComponent 已从 PhysicsEngine 注销");
 	}
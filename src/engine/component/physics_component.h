@@ -7,6 +7,8 @@
 #include "component.h"
 #include <glm/vec2.hpp>
 #include <algorithm>
+#include <vector>
+#include "../physics/body_storage.h"
 
 namespace engine {
 	namespace object {
@@ -30,6 +32,7 @@ namespace engine::component {
 	 */
 	class PhysicsComponent : public Component {
 		friend class engine::object::GameObject;
+		friend class engine::physics::PhysicsEngine;
 	public:
 		/// 物体的速度向量（单位：单位/秒）
 		glm::vec2 velocity_{ 0.0f, 0.0f };
@@ -58,8 +61,34 @@ namespace engine::component {
 		bool collided_right_ = false;
 		/// 是否正在攀爬
 		bool is_climbing_ = false;
+		/// 是否启用连续碰撞检测（扫掠 + 子步），仅对高速物体开启
+		bool ccd_enabled_ = false;
+		/// 是否允许自动休眠
+		bool sleep_allowed_ = true;
+		/// 是否处于休眠状态
+		bool sleeping_ = false;
+		/// 连续处于静止状态的步数
+		int rest_steps_ = 0;
+		/// 进入休眠时的位置，用于检测外部瞬移
+		glm::vec2 sleep_position_{ 0.0f, 0.0f };
 		/// 抑制捕捉计时器（秒）
 		float suppress_snap_timer_ = 0.0f;
+		/// 在物理引擎刚体存储中的句柄，未注册时无效
+		engine::physics::BodyHandle body_handle_;
+		/// 是否为运动学刚体（按脚本速度或路径移动，作为固体推开其他物体）
+		bool kinematic_ = false;
+		/// 运动学路径的途经点（Transform 位置），为空时按 velocity_ 移动
+		std::vector<glm::vec2> path_points_;
+		/// 沿路径移动的速率（单位/秒）
+		float path_speed_ = 0.0f;
+		/// 路径是否首尾循环，否则往返
+		bool path_loop_ = false;
+		/// 当前前往的途经点下标
+		size_t path_target_ = 0;
+		/// 往返时的前进方向（1 或 -1）
+		int path_direction_ = 1;
+		/// 上一步站立的运动学刚体，物理步开始时据此携带本物体
+		engine::physics::BodyHandle ground_body_;
 
 	public:
 		/**
@@ -80,7 +109,7 @@ namespace engine::component {
 		PhysicsComponent& operator=(PhysicsComponent&&) = delete;
 
 		// PhysicsEngine使用的物理方法
-		void addForce(const glm::vec2& force) { if (enable_) force_ += force; }    ///< @brief 添加力
+		void addForce(const glm::vec2& force) { if (enable_) { force_ += force; wakeUp(); } } ///< @brief 添加力（会唤醒休眠的物体）
 		void clearForce() { force_ = { 0.0f, 0.0f }; }                                ///< @brief 清除力
 		const glm::vec2& getForce() const { return force_; }                        ///< @brief 获取当前力
 		float getMass() const { return mass_; }                                     ///< @brief 获取质量
@@ -119,6 +148,57 @@ namespace engine::component {
 		 */
 		bool isClimbing() const { return is_climbing_; }
 
+		/**
+		 * @brief 设置是否启用连续碰撞检测 (CCD)。
+		 * @param enabled 是否启用
+		 * @details 启用后，物理引擎会对位移超过一个瓦片的步长拆分子步，
+		 *          并对 "solid" 物体做扫掠 AABB 检测，防止高速物体穿透薄墙。
+		 */
+		void setCCDEnabled(bool enabled) { ccd_enabled_ = enabled; }
+
+		/**
+		 * @brief 获取是否启用连续碰撞检测。
+		 * @return 启用返回true，否则返回false
+		 */
+		bool isCCDEnabled() const { return ccd_enabled_; }
+
+		/**
+		 * @brief 设置是否为运动学刚体。
+		 * @param kinematic 是否为运动学刚体
+		 * @details 运动学刚体不受重力、外力和瓦片碰撞影响，每步按 velocity_ 或路径移动，
+		 *          在物体碰撞中视为固体，并把自身位移施加到站在其上方的物体上。
+		 */
+		void setKinematic(bool kinematic) { kinematic_ = kinematic; wakeUp(); }
+		bool isKinematic() const { return kinematic_; }            ///< @brief 获取是否为运动学刚体
+
+		/**
+		 * @brief 设置运动学路径，并将物体设为运动学刚体。
+		 * @param points 途经点（Transform 位置），物体先移动到第一个点
+		 * @param speed 移动速率（单位/秒）
+		 * @param loop 为 true 时到达终点后回到起点，否则沿原路往返
+		 */
+		void setKinematicPath(std::vector<glm::vec2> points, float speed, bool loop = false);
+
+		/**
+		 * @brief 清除运动学路径，之后按 velocity_ 移动。
+		 */
+		void clearKinematicPath() { path_points_.clear(); path_target_ = 0; path_direction_ = 1; }
+		bool hasKinematicPath() const { return !path_points_.empty(); } ///< @brief 获取是否设置了运动学路径
+
+		/**
+		 * @brief 设置是否允许自动休眠。
+		 * @param allowed 是否允许
+		 * @details 不允许休眠时会立即唤醒。玩家等需要持续响应的物体应关闭休眠。
+		 */
+		void setSleepAllowed(bool allowed) { sleep_allowed_ = allowed; if (!allowed) wakeUp(); }
+		bool isSleepAllowed() const { return sleep_allowed_; }     ///< @brief 获取是否允许自动休眠
+		bool isSleeping() const { return sleeping_; }              ///< @brief 获取是否处于休眠状态
+
+		/**
+		 * @brief 唤醒物体，并重置静止计数。
+		 */
+		void wakeUp() { sleeping_ = false; rest_steps_ = 0; }
+
 		/**
 		 * @brief 设置抑制捕捉的持续时间。
 		 * @param seconds 抑制时间（秒）
@@ -141,7 +221,7 @@ namespace engine::component {
 		 * @brief 设置物体的速度。
 		 * @param velocity 速度向量
 		 */
-		void setVelocity(const glm::vec2& velocity) { velocity_ = velocity; }
+		void setVelocity(const glm::vec2& velocity) { velocity_ = velocity; wakeUp(); }
 
 		/**
 		 * @brief 获取物体的当前速度。
@@ -214,6 +294,14 @@ namespace engine::component {
 		void setCollidedRight(bool collided) { collided_right_ = collided; }
 
 	private:
+		/**
+		 * @brief 沿运动学路径前进一步。
+		 * @param position 当前 Transform 位置
+		 * @param dt 时间步长
+		 * @return 本步位移
+		 */
+		glm::vec2 advanceKinematicPath(const glm::vec2& position, float dt);
+
 		/**
 		 * @brief 组件初始化，获取变换组件并注册到物理引擎。
 		 */
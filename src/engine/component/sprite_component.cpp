@@ -134,7 +134,7 @@ namespace engine::component {
             sprite_size_.x = src_rect.w;
             sprite_size_.y = src_rect.h;
         } else {
-            sprite_size_ = resource_manager_->getTextureSize(sprite_.getTextureId());
+            sprite_size_ = resource_manager_->getTextureSize(sprite_.getTextureHandle());
         }
     }
 
@@ -177,7 +177,7 @@ namespace engine::component {
      * 
      * 渲染过程包括：
      * 1. 检查是否隐藏或缺少必要组件
-     * 2. 计算最终渲染位置（考虑偏移量）
+     * 2. 计算最终渲染位置（按固定步插值系数在上一位姿与当前位姿之间插值，并考虑偏移量）
      * 3. 调用渲染器绘制精灵
      */
     void SpriteComponent::render(engine::core::Context &context)
@@ -185,10 +185,12 @@ namespace engine::component {
         if(is_hidden_ || !transform_ || !resource_manager_) {
             return;
         }
-        const glm::vec2& position = transform_->getPosition() + offset_;
+        const float alpha = context.getInterpolationAlpha();
+        const glm::vec2 position = transform_->getInterpolatedPosition(alpha) + offset_;
         const glm::vec2& scale = transform_->getScale();
-        float rotation = transform_->getRotation();
-        context.getRenderer().drawSprite(context.getCamera(),sprite_, position, scale, rotation);
+        float rotation = transform_->getInterpolatedRotation(alpha);
+        const engine::render::RenderOrder order{ owner_->getRenderLayer(), z_order_, 0 };
+        context.getRenderer().drawSprite(context.getCamera(),sprite_, position, scale, rotation, order);
     }
 
 } // namespace engine::component
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "./component.h"
 #include "../utils/alignment.h"
 #include <string>
+#include <cstdint>
 #include <optional>
 #include <SDL3/SDL_rect.h>
 #include <glm/vec2.hpp>
@@ -39,6 +40,7 @@ namespace engine::component {
 		glm::vec2 sprite_size_ = { 0.0f, 0.0f };                                  ///< @brief 精灵尺寸
 		glm::vec2 offset_ = { 0.0f, 0.0f };                                       ///< @brief 偏移量
 		bool is_hidden_ = false;                                                ///< @brief 是否隐藏
+		std::int16_t z_order_ = 0;                                              ///< @brief 同一渲染层内的前后顺序，越大越靠前
 	public:
 		/**
 		 * @brief 构造一个新的 SpriteComponent。
@@ -92,6 +94,8 @@ namespace engine::component {
 		
 		void setFlipped(bool flipped) { sprite_.setIsFlipped(flipped); }           ///< @brief 设置是否翻转
 		void setHidden(bool hidden) { is_hidden_ = hidden; }                       ///< @brief 设置是否隐藏
+		void setZOrder(std::int16_t z_order) { z_order_ = z_order; }               ///< @brief 设置层内前后顺序
+		std::int16_t getZOrder() const { return z_order_; }                        ///< @brief 获取层内前后顺序
 		
 		/**
 		 * @brief 设置精灵的源矩形。
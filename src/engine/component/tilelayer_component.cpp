@@ -4,9 +4,13 @@
 #include "../core/context.h"
 #include "../render/renderer.h"
 #include "../physics/physics_engine.h"
+#include "../physics/tile_collider_set.h"
 #include "../render/camera.h"
+#include "../render/tile_chunk_cache.h"
 #include <spdlog/spdlog.h>
 #include <glm/ext/vector_int2.hpp> // 修复VCIC001警告
+#include <cmath>
+#include <algorithm>
 
 namespace engine::component {
 
@@ -17,18 +21,40 @@ using engine::component::TileType; // 添加此行以修复未定义标识符"Ti
  * 
  * @param tile_size 单个瓦片的尺寸（如 16x16）
  * @param map_size 地图的网格尺寸（如 100x20）
- * @param tiles 包含所有瓦片数据的向量，大小必须等于 map_size.x * map_size.y
+ * @param prototypes 瓦片原型表，下标 0 必须为空瓦片（为空时自动补上）
+ * @param cells 每个格子的原型下标，大小必须等于 map_size.x * map_size.y
  * @details 创建瓦片图层组件，初始化瓦片数据和尺寸信息
  */
-TileLayerComponent::TileLayerComponent(const glm::ivec2& tile_size, const glm::ivec2& map_size, const std::vector<TileInfo>& tiles)
-:tile_size_(tile_size), map_size_(map_size), tiles_(tiles)
+TileLayerComponent::TileLayerComponent(const glm::ivec2& tile_size, const glm::ivec2& map_size,
+	std::vector<TileInfo> prototypes, std::vector<std::uint16_t> cells)
+:tile_size_(tile_size), map_size_(map_size), prototypes_(std::move(prototypes)), cells_(std::move(cells))
 {
-
-	if (tiles_.size() != static_cast<size_t>(map_size_.x * map_size_.y)) {
+	if (prototypes_.empty()) {
+		prototypes_.emplace_back(engine::render::Sprite(), TileType::EMPTY);
+	}
+	if (cells_.size() != static_cast<size_t>(map_size_.x * map_size_.y)) {
 		spdlog::error("TileLayerComponent: 地图尺寸与提供的瓦片向量大小不匹配。瓦片数据将被清除。");
-		tiles_.clear();
+		cells_.clear();
+		map_size_ = { 0, 0 };
+	}
+	if (std::any_of(cells_.begin(), cells_.end(), [this](std::uint16_t cell) { return cell >= prototypes_.size(); })) {
+		spdlog::error("TileLayerComponent: 格子引用了不存在的瓦片原型。瓦片数据将被清除。");
+		cells_.clear();
 		map_size_ = { 0, 0 };
 	}
+	// 构建紧凑碰撞网格：物理查询只需要类型，不需要精灵信息
+	collision_types_.resize(cells_.size());
+	for (size_t i = 0; i < cells_.size(); ++i) {
+		collision_types_[i] = static_cast<std::uint8_t>(prototypes_[cells_[i]].type);
+	}
+	// 统计瓦片图像超出格子的最大范围：图像从格子左边缘向右延伸，底部与格子底边对齐向上延伸
+	for (const auto& tile : prototypes_) {
+		if (tile.type == TileType::EMPTY || !tile.sprite.getSourceRect().has_value()) continue;
+		const auto& src_rect = tile.sprite.getSourceRect().value();
+		overflow_px_.x = std::max(overflow_px_.x, static_cast<int>(std::ceil(src_rect.w)) - tile_size_.x);
+		overflow_px_.y = std::max(overflow_px_.y, static_cast<int>(std::ceil(src_rect.h)) - tile_size_.y);
+	}
+	chunk_owner_id_ = engine::render::TileChunkCache::nextOwnerId();
 	spdlog::trace("TileLayerComponent 构造完成");
 }
 
@@ -53,11 +79,11 @@ const TileInfo& TileLayerComponent::getTileAt(const glm::ivec2& tile_coords) con
 		return empty_tile;
 	}
 	size_t index = static_cast<size_t>(tile_coords.y) * static_cast<size_t>(map_size_.x) + static_cast<size_t>(tile_coords.x);
-	if (index >= tiles_.size()) {
+	if (index >= cells_.size()) {
 		static const TileInfo empty_tile(engine::render::Sprite(), TileType::EMPTY);
 		return empty_tile;
 	}
-	return tiles_[index];
+	return prototypes_[cells_[index]];
 }
 
 /**
@@ -69,8 +95,44 @@ const TileInfo& TileLayerComponent::getTileAt(const glm::ivec2& tile_coords) con
  */
 TileType TileLayerComponent::getTileTypeAt(const glm::ivec2& tile_coords) const
 {
-	// 返回指定瓦片坐标的瓦片类型
-	return getTileAt(tile_coords).type;
+	// 直接读取紧凑碰撞网格，越界时返回 EMPTY
+	if (tile_coords.x < 0 || tile_coords.y < 0 ||
+		tile_coords.x >= map_size_.x || tile_coords.y >= map_size_.y) {
+		return TileType::EMPTY;
+	}
+	return static_cast<TileType>(collision_types_[static_cast<size_t>(tile_coords.y) * static_cast<size_t>(map_size_.x) + static_cast<size_t>(tile_coords.x)]);
+}
+
+/**
+ * @brief 获取图层左上角的世界坐标
+ * 
+ * @return 图层世界偏移
+ * @details 变换位置与缓存时不同（或偏移量被修改）时才重新计算，避免每次查询都查找 TransformComponent
+ */
+const glm::vec2& TileLayerComponent::getWorldOffset() const
+{
+	const glm::vec2 transform_position = transform_component_ ? transform_component_->getPosition() : glm::vec2(0.0f);
+	if (world_offset_dirty_ || transform_position != cached_transform_position_) {
+		cached_transform_position_ = transform_position;
+		cached_world_offset_ = offset_ + transform_position;
+		world_offset_dirty_ = false;
+	}
+	return cached_world_offset_;
+}
+
+/**
+ * @brief 获取紧凑碰撞视图
+ * 
+ * @return 碰撞视图
+ */
+TileCollisionView TileLayerComponent::getCollisionView() const
+{
+	TileCollisionView view;
+	view.types = collision_types_.empty() ? nullptr : collision_types_.data();
+	view.map_size = map_size_;
+	view.tile_size = glm::vec2(tile_size_);
+	view.world_offset = getWorldOffset();
+	return view;
 }
 
 /**
@@ -83,16 +145,25 @@ TileType TileLayerComponent::getTileTypeAt(const glm::ivec2& tile_coords) const
 TileType TileLayerComponent::getTileTypeAtWorldPos(const glm::vec2& world_pos) const
 {
 	// 计算世界坐标对应的瓦片坐标
-	glm::vec2 layer_world_offset = offset_;
-	if (owner_) {
-		if (auto* tc = owner_->getComponent<engine::component::TransformComponent>()) {
-			layer_world_offset += tc->getPosition();
-		}
-	}
-	glm::ivec2 tile_coords = glm::floor((world_pos - layer_world_offset) / glm::vec2(tile_size_));
+	glm::ivec2 tile_coords = glm::floor((world_pos - getWorldOffset()) / glm::vec2(tile_size_));
 	return getTileTypeAt(tile_coords);
 }
 
+/**
+ * @brief 合并静态碰撞矩形
+ * 
+ * @return 合并后的矩形数量
+ * @details 基于紧凑碰撞网格贪心合并，斜坡与梯子等特殊瓦片不参与合并
+ */
+size_t TileLayerComponent::buildStaticColliders()
+{
+	if (!static_colliders_) {
+		static_colliders_ = std::make_unique<engine::physics::TileColliderSet>();
+	}
+	static_colliders_->build(collision_types_, map_size_, tile_size_);
+	return static_colliders_->getRects().size();
+}
+
 /**
  * @brief 初始化组件
  * 
@@ -103,6 +174,10 @@ void TileLayerComponent::init()
 	if (!owner_) {
 		spdlog::warn("TileLayerComponent 的 owner_ 未设置。");
 	}
+	else {
+		transform_component_ = owner_->getComponent<TransformComponent>();
+	}
+	world_offset_dirty_ = true;
 	spdlog::trace("TileLayerComponent 初始化完成");
 }
 
@@ -110,7 +185,7 @@ void TileLayerComponent::init()
  * @brief 渲染图层
  * 
  * @param context 引擎上下文
- * @details 仅渲染主要摄像机视野范围内的瓦片（Culling），应用底部对齐和像素对齐
+ * @details 分块缓存可用时绘制预烘焙的块，否则逐瓦片绘制视野内的瓦片
  */
 void TileLayerComponent::render(engine::core::Context& context)
 {
@@ -120,51 +195,80 @@ void TileLayerComponent::render(engine::core::Context& context)
 	auto& renderer = context.getRenderer();
 	auto& camera = context.getCamera();
 
+	if (renderer.getTileChunkCache().isEnabled() && !chunk_cache_failed_) {
+		if (renderChunks(renderer, camera)) {
+			return;
+		}
+		spdlog::warn("TileLayerComponent: 无法使用渲染目标纹理，图层退回逐瓦片绘制。");
+		chunk_cache_failed_ = true;
+		renderer.getTileChunkCache().release(chunk_owner_id_);
+	}
+	renderTiles(renderer, camera);
+}
+
+/**
+ * @brief 计算瓦片图像的绘制偏移
+ * 
+ * @param tile 瓦片信息
+ * @return 图像左上角相对于格子左上角的偏移
+ * @details Tiled 规则：如果图片高度 > 瓦片高度（如树木），图片底部应与网格底部对齐
+ */
+glm::vec2 TileLayerComponent::getTileDrawOffset(const TileInfo& tile) const
+{
+	float sprite_h = static_cast<float>(tile_size_.y);
+	// 安全访问 optional
+	if (tile.sprite.getSourceRect().has_value()) {
+		sprite_h = tile.sprite.getSourceRect()->h;
+	}
+
+	// 如果高度不一致，向上偏移差异值
+	if (std::abs(sprite_h - tile_size_.y) > 0.1f) {
+		return { 0.0f, -(sprite_h - static_cast<float>(tile_size_.y)) };
+	}
+	return { 0.0f, 0.0f };
+}
+
+/**
+ * @brief 逐瓦片绘制
+ * 
+ * @param renderer 渲染器
+ * @param camera 相机
+ * @details 仅渲染主要摄像机视野范围内的瓦片（Culling），应用底部对齐和像素对齐
+ */
+void TileLayerComponent::renderTiles(engine::render::Renderer& renderer, const engine::render::Camera& camera)
+{
 	// --- 1. 视锥体剔除 (Culling) ---
 	// 目的：仅渲染摄像机视野内的瓦片，极大提高大地图的渲染性能
 	
-	glm::vec2 cam_pos = camera.getPosition();
+	// 与 worldToScreen 一致，使用插值后的相机位置
+	glm::vec2 cam_pos = camera.getRenderPosition();
 	glm::vec2 cam_size = camera.getViewportSize();
 
-	glm::vec2 layer_world_offset = offset_;
-	if (owner_) {
-		if (auto* tc = owner_->getComponent<engine::component::TransformComponent>()) {
-			layer_world_offset += tc->getPosition();
-		}
-	}
+	const glm::vec2 layer_world_offset = getWorldOffset();
 
-	// 计算视野范围对应的网格坐标 (包含一些冗余量以防边缘闪烁)
-    // 增加渲染范围冗余量，已修正：处理超大图块（如树木、建筑）和负高度偏移
-    // 某些大图块的锚点在网格内，但图像延伸出网格很远。如果只渲染视口内的网格，会导致这些大图块也被剔除。
-    const int extra_padding = 20; 
-	glm::ivec2 start_tile = glm::ivec2(glm::floor((cam_pos - layer_world_offset) / glm::vec2(tile_size_))) - glm::ivec2(extra_padding);
-	glm::ivec2 end_tile = glm::ivec2(glm::ceil((cam_pos + cam_size - layer_world_offset) / glm::vec2(tile_size_))) + glm::ivec2(extra_padding);
+	// 计算视野范围对应的网格坐标
+	// 超大图块（如树木、建筑）的锚点在网格内，但图像向右、向上延伸出网格，
+	// 因此左侧和下方按图层中最大的超出量（换算为格数）扩展，另留 1 格防止边缘闪烁
+	const glm::ivec2 overflow_tiles = (overflow_px_ + tile_size_ - 1) / tile_size_;
+	glm::ivec2 start_tile = glm::ivec2(glm::floor((cam_pos - layer_world_offset) / glm::vec2(tile_size_))) - glm::ivec2(overflow_tiles.x + 1, 1);
+	glm::ivec2 end_tile = glm::ivec2(glm::ceil((cam_pos + cam_size - layer_world_offset) / glm::vec2(tile_size_))) + glm::ivec2(1, overflow_tiles.y + 1);
 
 	// 限制坐标在地图有效范围内 (Intersection)
 	start_tile = glm::max(start_tile, glm::ivec2(0));
 	end_tile = glm::min(end_tile, map_size_);
 
 	// --- 2. 渲染循环 ---
+	// 高大瓦片会盖住上方的格子，以行号作为 z，渲染队列只在同一行内按纹理分组，行与行之间的遮挡关系不变
+	engine::render::RenderOrder row_order{ owner_ ? owner_->getRenderLayer() : engine::render::render_layer::DEFAULT };
 	for (int y = start_tile.y; y < end_tile.y; ++y) {
+		row_order.z = static_cast<std::int16_t>(std::min(y, 32767));
+		const std::uint16_t* row = cells_.data() + static_cast<size_t>(y) * static_cast<size_t>(map_size_.x);
 		for (int x = start_tile.x; x < end_tile.x; ++x) {
-			const TileInfo& tile = getTileAt({ x, y });
+			const TileInfo& tile = prototypes_[row[x]];
 			
 			if (tile.type != TileType::EMPTY) {
-				glm::vec2 tile_world_pos = layer_world_offset + glm::vec2(x * tile_size_.x, y * tile_size_.y);
-				
 				// --- 3. 底部对齐逻辑 (Bottom Alignment) ---
-				// Tiled 规则：如果图片高度 > 瓦片高度（如树木），图片底部应与网格底部对齐
-				
-				float sprite_h = static_cast<float>(tile_size_.y);
-				// 安全访问 optional
-				if (tile.sprite.getSourceRect().has_value()) {
-					sprite_h = tile.sprite.getSourceRect()->h;
-				}
-
-				// 如果高度不一致，向上偏移差异值
-				if (std::abs(sprite_h - tile_size_.y) > 0.1f) {
-					tile_world_pos.y -= (sprite_h - static_cast<float>(tile_size_.y));
-				}
+				glm::vec2 tile_world_pos = layer_world_offset + glm::vec2(x * tile_size_.x, y * tile_size_.y) + getTileDrawOffset(tile);
 
 				// 像素对齐：确保瓦片渲染在整数像素位置上，避免亚像素偏移导致的缝隙
 				// 注意：这里直接对世界坐标进行取整，因为相机的 worldToScreen 会再次处理像素对齐
@@ -178,10 +282,107 @@ void TileLayerComponent::render(engine::core::Context& context)
 				scale.x = (static_cast<float>(tile_size_.x) + overlap_epsilon) / static_cast<float>(tile_size_.x);
 				scale.y = (static_cast<float>(tile_size_.y) + overlap_epsilon) / static_cast<float>(tile_size_.y);
 
-				renderer.drawSprite(camera, tile.sprite, tile_world_pos, scale);
+				renderer.drawSprite(camera, tile.sprite, tile_world_pos, scale, 0.0, row_order);
+			}
+		}
+	}
+}
+
+/**
+ * @brief 通过分块缓存绘制
+ * 
+ * @param renderer 渲染器
+ * @param camera 相机
+ * @return 渲染目标不可用时返回 false
+ * @details 先烘焙所有缺失的可见块，再连续绘制块四边形；块之间没有重叠，
+ *          块内的瓦片已按整数像素烘焙，绘制时只需对块的世界坐标取整
+ */
+bool TileLayerComponent::renderChunks(engine::render::Renderer& renderer, const engine::render::Camera& camera)
+{
+	auto& cache = renderer.getTileChunkCache();
+	chunk_cache_ = &cache;
+
+	const glm::ivec2 bounds_min = getDrawBoundsMin();
+	const glm::ivec2 bounds_size = getDrawBoundsSize();
+	if (bounds_size.x <= 0 || bounds_size.y <= 0) {
+		return true;
+	}
+	const glm::ivec2 chunk_count = (bounds_size + engine::render::TileChunkCache::CHUNK_SIZE - 1) / engine::render::TileChunkCache::CHUNK_SIZE;
+
+	const glm::vec2 layer_world_offset = getWorldOffset();
+	// 绘制经过 worldToScreen（插值后的相机位置），剔除也必须以它为准，否则跨块时边缘的块会提前一步被剔除
+	const glm::vec2 view_min = camera.getRenderPosition() - layer_world_offset - glm::vec2(bounds_min);
+	const glm::vec2 view_max = view_min + camera.getViewportSize();
+	const float chunk_size_f = static_cast<float>(engine::render::TileChunkCache::CHUNK_SIZE);
+	const glm::ivec2 first_chunk = glm::max(glm::ivec2(glm::floor(view_min / chunk_size_f)), glm::ivec2(0));
+	const glm::ivec2 last_chunk = glm::min(glm::ivec2(glm::ceil(view_max / chunk_size_f)), chunk_count);
+
+	// --- 1. 查找或烘焙可见块 ---
+	const size_t frame = renderer.getFrameCount();
+	visible_chunks_.clear();
+	for (int cy = first_chunk.y; cy < last_chunk.y; ++cy) {
+		for (int cx = first_chunk.x; cx < last_chunk.x; ++cx) {
+			const glm::ivec2 chunk{ cx, cy };
+			const glm::ivec2 chunk_origin = bounds_min + chunk * engine::render::TileChunkCache::CHUNK_SIZE;
+			const glm::ivec2 chunk_size = glm::min(glm::ivec2(engine::render::TileChunkCache::CHUNK_SIZE), bounds_min + bounds_size - chunk_origin);
+
+			SDL_Texture* texture = cache.find(chunk_owner_id_, chunk, frame);
+			if (!texture) {
+				texture = cache.create(renderer.getSDLRenderer(), chunk_owner_id_, chunk, chunk_size, frame);
+				if (!texture || !bakeChunk(renderer, texture, chunk_origin, chunk_size)) {
+					return false;
+				}
 			}
+			visible_chunks_.emplace_back(texture, chunk);
+		}
+	}
+
+	// --- 2. 绘制块 ---
+	// 块之间互不重叠，同一图层的块共用一个排序位置
+	const engine::render::RenderOrder chunk_order{ owner_ ? owner_->getRenderLayer() : engine::render::render_layer::DEFAULT };
+	for (const auto& [texture, chunk] : visible_chunks_) {
+		const glm::ivec2 chunk_origin = bounds_min + chunk * engine::render::TileChunkCache::CHUNK_SIZE;
+		const glm::ivec2 chunk_size = glm::min(glm::ivec2(engine::render::TileChunkCache::CHUNK_SIZE), bounds_min + bounds_size - chunk_origin);
+		renderer.drawTexture(camera, texture, glm::vec2(chunk_size), glm::round(layer_world_offset + glm::vec2(chunk_origin)), chunk_order);
+	}
+	return true;
+}
+
+/**
+ * @brief 烘焙一个块
+ * 
+ * @param renderer 渲染器
+ * @param texture 块纹理
+ * @param chunk_origin 块左上角（图层局部坐标）
+ * @param chunk_size 块尺寸
+ * @return 成功返回 true
+ * @details 与块相交的瓦片包括锚点在块左侧、图像向右延伸进块的瓦片，以及锚点在块下方、图像向上延伸进块的瓦片；
+ *          超出块的部分被渲染目标裁掉，由相邻块各自绘制。绘制顺序与逐瓦片绘制相同（行优先），遮挡关系不变。
+ */
+bool TileLayerComponent::bakeChunk(engine::render::Renderer& renderer, SDL_Texture* texture, const glm::ivec2& chunk_origin, const glm::ivec2& chunk_size)
+{
+	if (!renderer.beginTextureTarget(texture)) {
+		return false;
+	}
+
+	const glm::vec2 tile_size_f(tile_size_);
+	const glm::ivec2 start_tile = glm::max(
+		glm::ivec2(glm::floor(glm::vec2(chunk_origin.x - overflow_px_.x, chunk_origin.y) / tile_size_f)), glm::ivec2(0));
+	const glm::ivec2 end_tile = glm::min(
+		glm::ivec2(glm::ceil(glm::vec2(chunk_origin.x + chunk_size.x, chunk_origin.y + chunk_size.y + overflow_px_.y) / tile_size_f)), map_size_);
+
+	for (int y = start_tile.y; y < end_tile.y; ++y) {
+		const std::uint16_t* row = cells_.data() + static_cast<size_t>(y) * static_cast<size_t>(map_size_.x);
+		for (int x = start_tile.x; x < end_tile.x; ++x) {
+			const TileInfo& tile = prototypes_[row[x]];
+			if (tile.type == TileType::EMPTY) continue;
+			const glm::vec2 local_pos = glm::vec2(x * tile_size_.x, y * tile_size_.y) + getTileDrawOffset(tile) - glm::vec2(chunk_origin);
+			renderer.drawUISprite(tile.sprite, glm::round(local_pos));
 		}
 	}
+
+	renderer.endTextureTarget();
+	return true;
 }
 
 /**
@@ -198,13 +399,17 @@ void TileLayerComponent::update(float deltaTime, engine::core::Context& context)
 /**
  * @brief 清理组件资源
  * 
- * @details 清理瓦片图层组件，从物理引擎中注销碰撞图层
+ * @details 清理瓦片图层组件，从物理引擎中注销碰撞图层，并释放分块缓存中本图层的块
  */
 void TileLayerComponent::clean()
 {
 	if (physics_engine_) {
 		physics_engine_->unregisterCollisionLayer(this);
 	}
+	if (chunk_cache_) {
+		chunk_cache_->release(chunk_owner_id_);
+		chunk_cache_ = nullptr;
+	}
 }
 
 }  // namespace engine::component
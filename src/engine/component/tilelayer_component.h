@@ -1,11 +1,18 @@
 #pragma once
 #include "component.h"
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <utility>
 #include <glm/vec2.hpp>
 #include "../render/sprite.h"
 
+struct SDL_Texture;
+
 namespace engine::physics {
 	class PhysicsEngine;
+	class TileColliderSet;
 }
 
 namespace engine::object {
@@ -13,6 +20,9 @@ namespace engine::object {
 }
 namespace engine::render {
 	class Sprite;
+	class Renderer;
+	class Camera;
+	class TileChunkCache;
 }
 namespace engine::component {
 	/**
@@ -54,12 +64,52 @@ namespace engine::component {
 			: sprite(std::move(spr)), type(t) {}
 	};
 
+	class TransformComponent;
+
+	/**
+	 * @struct TileCollisionView
+	 * @brief 瓦片图层的紧凑碰撞视图，供物理查询使用。
+	 *
+	 * 只包含连续存储的 uint8_t 瓦片类型网格与已换算好的世界偏移，
+	 * 避免在物理热路径中读取携带纹理字符串的 TileInfo 以及查找 TransformComponent。
+	 * 视图不持有数据，仅在所属图层存活期间有效。
+	 */
+	struct TileCollisionView {
+		const std::uint8_t* types = nullptr;   ///< 行优先的瓦片类型网格
+		glm::ivec2 map_size{ 0, 0 };           ///< 网格尺寸 (columns, rows)
+		glm::vec2 tile_size{ 0.0f, 0.0f };     ///< 单个瓦片尺寸
+		glm::vec2 world_offset{ 0.0f, 0.0f };  ///< 图层左上角的世界坐标
+
+		/** @brief 视图是否可用（存在数据且瓦片尺寸有效） */
+		bool isValid() const { return types != nullptr && tile_size.x > 0.0f && tile_size.y > 0.0f; }
+
+		/**
+		 * @brief 获取网格坐标处的瓦片类型，越界返回 EMPTY。
+		 */
+		TileType at(int tx, int ty) const {
+			if (tx < 0 || ty < 0 || tx >= map_size.x || ty >= map_size.y) return TileType::EMPTY;
+			return static_cast<TileType>(types[static_cast<size_t>(ty) * static_cast<size_t>(map_size.x) + static_cast<size_t>(tx)]);
+		}
+
+		/** @brief 世界坐标 X 对应的网格列 */
+		int toTileX(float world_x) const { return static_cast<int>(std::floor((world_x - world_offset.x) / tile_size.x)); }
+		/** @brief 世界坐标 Y 对应的网格行 */
+		int toTileY(float world_y) const { return static_cast<int>(std::floor((world_y - world_offset.y) / tile_size.y)); }
+	};
+
 	/**
 	 * @class TileLayerComponent
 	 * @brief 瓦片图层组件，用于管理和渲染由大量瓦片组成的地图层。
 	 * 
-	 * 该组件基于网格系统存储瓦片（TileInfo），支持视锥体剔除（Culling）以优化渲染性能。
+	 * 该组件基于网格系统存储瓦片，支持视锥体剔除（Culling）以优化渲染性能。
 	 * 适用于 Tiled 地图中的 Tile Layer 层。
+	 *
+	 * 同一图层中大量格子重复使用少数几种瓦片，因此每个格子只保存 16 位的原型下标，
+	 * 精灵、类型与源矩形保存在图层的原型表（TileInfo）中，渲染与物理都按下标顺序读取紧凑的网格。
+	 *
+	 * 瓦片加载后不再变化，启用 Renderer 的 TileChunkCache 时图层被切成 TileChunkCache::CHUNK_SIZE 见方的块，
+	 * 块首次进入视野时烘焙为渲染目标纹理，之后每帧只绘制几个块四边形。
+	 * 高于或宽于格子的瓦片（树木、建筑）会烘焙进它覆盖到的每一个块，因此跨越块边界时也能完整显示。
 	 */
 	class TileLayerComponent final : public Component {
 		friend class engine::object::GameObject;
@@ -68,20 +118,35 @@ namespace engine::component {
 		engine::physics::PhysicsEngine* physics_engine_{ nullptr }; ///< 指向物理引擎的指针，用于注册碰撞图层
 		glm::ivec2 tile_size_;          ///< 单个瓦片的像素尺寸 (width, height)
 		glm::ivec2 map_size_;           ///< 地图的网格尺寸 (columns, rows)
-		std::vector<TileInfo> tiles_;   ///< 拍平的一维瓦片数组，行优先存储
+		std::vector<TileInfo> prototypes_;  ///< 瓦片原型表，下标 0 固定为空瓦片
+		std::vector<std::uint16_t> cells_;  ///< 拍平的一维原型下标网格，行优先存储
 		glm::vec2 offset_{ 0.0f, 0.0f };///< 图层相对于世界原点的偏移量
+		std::vector<std::uint8_t> collision_types_; ///< 与 cells_ 一一对应的紧凑瓦片类型网格，供物理查询
+
+		TransformComponent* transform_component_{ nullptr }; ///< 所属对象的变换组件（init 时缓存）
+		mutable glm::vec2 cached_world_offset_{ 0.0f, 0.0f };  ///< 缓存的图层世界偏移 (offset_ + 变换位置)
+		mutable glm::vec2 cached_transform_position_{ 0.0f, 0.0f }; ///< 计算缓存时的变换位置
+		mutable bool world_offset_dirty_{ true };             ///< 世界偏移缓存是否失效
+		std::unique_ptr<engine::physics::TileColliderSet> static_colliders_; ///< 加载时合并的 SOLID/UNISOLID 静态矩形
 
 		bool is_hidden_{ false };       ///< 是否隐藏该图层
+
+		glm::ivec2 overflow_px_{ 0, 0 };       ///< 瓦片图像超出格子的最大像素数（x 向右，y 向上）
+		std::uint32_t chunk_owner_id_{ 0 };    ///< 在分块缓存中的图层 id
+		engine::render::TileChunkCache* chunk_cache_{ nullptr }; ///< 烘焙过块的缓存（clean 时释放本图层的块）
+		bool chunk_cache_failed_{ false };     ///< 渲染目标不可用时退回逐瓦片绘制
+		std::vector<std::pair<SDL_Texture*, glm::ivec2>> visible_chunks_; ///< 本帧可见块的纹理与块坐标（帧间复用）
 	public:
 		/**
 		 * @brief 构造函数
 		 * 
 		 * @param tile_size 单个瓦片的尺寸（如 16x16）
 		 * @param map_size 地图的网格尺寸（如 100x20）
-		 * @param tiles 包含所有瓦片数据的向量，大小必须等于 map_size.x * map_size.y
+		 * @param prototypes 瓦片原型表，下标 0 必须为空瓦片（为空时自动补上）
+		 * @param cells 每个格子的原型下标，大小必须等于 map_size.x * map_size.y
 		 */
 		TileLayerComponent(const glm::ivec2& tile_size, const glm::ivec2& map_size,
-			const std::vector<TileInfo>& tiles);
+			std::vector<TileInfo> prototypes, std::vector<std::uint16_t> cells);
 		~TileLayerComponent();
 
 		// --- Getters and Setters ---
@@ -92,8 +157,11 @@ namespace engine::component {
 		/** @brief 获取地图的网格大小 (cols, rows) */
 		const glm::ivec2& getMapSize() const { return map_size_; }
 		
-		/** @brief 获取所有瓦片数据的只读引用 */
-		const std::vector<TileInfo>& getTiles() const { return tiles_; }
+		/** @brief 获取瓦片原型表的只读引用 */
+		const std::vector<TileInfo>& getPrototypes() const { return prototypes_; }
+
+		/** @brief 获取原型下标网格的只读引用（行优先） */
+		const std::vector<std::uint16_t>& getCells() const { return cells_; }
 		
 		/** @brief 获取图层偏移量 */
 		const glm::vec2& getOffset() const { return offset_; }
@@ -104,7 +172,32 @@ namespace engine::component {
 		}
 		
 		/** @brief 设置图层偏移量 */
-		void setOffset(const glm::vec2& offset) { offset_ = offset; }
+		void setOffset(const glm::vec2& offset) { offset_ = offset; world_offset_dirty_ = true; }
+
+		/**
+		 * @brief 获取图层左上角的世界坐标 (offset_ + 所属对象的变换位置)。
+		 *
+		 * 结果被缓存，仅在偏移量或变换位置发生变化时重新计算。
+		 */
+		const glm::vec2& getWorldOffset() const;
+
+		/**
+		 * @brief 获取供物理查询使用的紧凑碰撞视图。
+		 * @return TileCollisionView 只读视图，仅在本组件存活期间有效。
+		 */
+		TileCollisionView getCollisionView() const;
+
+		/**
+		 * @brief 将 SOLID / UNISOLID 瓦片合并为静态碰撞矩形（加载时调用一次）。
+		 * @return 合并后的矩形数量。
+		 */
+		size_t buildStaticColliders();
+
+		/**
+		 * @brief 获取合并后的静态碰撞矩形集合。
+		 * @return 尚未构建时返回 nullptr，物理引擎将回退为逐格检测。
+		 */
+		const engine::physics::TileColliderSet* getStaticColliders() const { return static_colliders_.get(); }
 		
 		/** @brief 检查图层是否隐藏 */
 		bool isHidden() const { return is_hidden_; }
@@ -155,5 +248,35 @@ namespace engine::component {
 
 		void clean() override;
 
+	private:
+		/** @brief 瓦片图像左上角相对于格子左上角的偏移（图像高于格子时底部对齐） */
+		glm::vec2 getTileDrawOffset(const TileInfo& tile) const;
+
+		/** @brief 图层内容（含超出格子的部分）在图层局部坐标中的左上角 */
+		glm::ivec2 getDrawBoundsMin() const { return { 0, -overflow_px_.y }; }
+
+		/** @brief 图层内容在图层局部坐标中的尺寸 */
+		glm::ivec2 getDrawBoundsSize() const {
+			return { map_size_.x * tile_size_.x + overflow_px_.x, map_size_.y * tile_size_.y + overflow_px_.y };
+		}
+
+		/** @brief 逐瓦片绘制视野内的瓦片 */
+		void renderTiles(engine::render::Renderer& renderer, const engine::render::Camera& camera);
+
+		/**
+		 * @brief 通过分块缓存绘制视野内的块，缺失的块先烘焙。
+		 * @return 渲染目标不可用时返回 false（本帧尚未绘制任何内容）。
+		 */
+		bool renderChunks(engine::render::Renderer& renderer, const engine::render::Camera& camera);
+
+		/**
+		 * @brief 把与块相交的所有瓦片按行优先顺序绘制到块纹理中。
+		 * @param renderer 渲染器。
+		 * @param texture 块纹理。
+		 * @param chunk_origin 块左上角（图层局部坐标）。
+		 * @param chunk_size 块尺寸（像素）。
+		 * @return 成功返回 true。
+		 */
+		bool bakeChunk(engine::render::Renderer& renderer, SDL_Texture* texture, const glm::ivec2& chunk_origin, const glm::ivec2& chunk_size);
 	};
 }  // namespace engine::component
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace engine::component {
 		glm::vec2 position_{ 0.0f, 0.0f }; ///< 位置坐标 (x, y)
 		float rotation_{ 0.0f };            ///< 旋转角度（度）
 		glm::vec2 scale_{ 1.0f, 1.0f };    ///< 缩放比例 (x, y)
+		glm::vec2 previous_position_{ 0.0f, 0.0f }; ///< 上一个固定步开始时的位置，用于渲染插值
+		float previous_rotation_{ 0.0f };            ///< 上一个固定步开始时的旋转角度，用于渲染插值
 	public:
 		/**
 		 * @brief 构造一个新的 TransformComponent 对象。
@@ -24,7 +26,8 @@ namespace engine::component {
 		 * @param scale 初始缩放比例，默认为 (1.0, 1.0)。
 		 */
 		TransformComponent(glm::vec2 position = { 0,0 }, float rotation = 0.0f, glm::vec2 scale = { 1.0f,1.0f })
-			: position_(position), rotation_(rotation), scale_(scale) {
+			: position_(position), rotation_(rotation), scale_(scale),
+			previous_position_(position), previous_rotation_(rotation) {
 		}
 
 		// 禁止拷贝和移动以确保组件生命周期管理的安全性
@@ -49,6 +52,15 @@ namespace engine::component {
 			position_ = position;
 		}
 
+		/**
+		 * @brief 瞬移到指定位置，渲染时不从旧位置过渡。
+		 * @param position 新的位置坐标。
+		 */
+		void teleport(const glm::vec2& position) {
+			position_ = position;
+			resetInterpolation();
+		}
+
 		/**
 		 * @brief 获取旋转角度。
 		 * @return float 当前的旋转角度（度）。
@@ -80,5 +92,35 @@ namespace engine::component {
 		void setScale(const glm::vec2& scale);
 
 		void translate(const glm::vec2& offset);
+
+		/**
+		 * @brief 记录当前位姿作为"上一位姿"，在每个固定步开始时调用。
+		 */
+		void savePreviousPose() {
+			previous_position_ = position_;
+			previous_rotation_ = rotation_;
+		}
+
+		/**
+		 * @brief 丢弃插值历史（瞬移、重生等不希望出现过渡的场合）。
+		 */
+		void resetInterpolation() { savePreviousPose(); }
+
+		/**
+		 * @brief 获取上一位姿与当前位姿之间的插值位置。
+		 * @param alpha 插值系数 [0, 1]，1 表示当前位置。
+		 * @return glm::vec2 用于渲染的位置。
+		 */
+		glm::vec2 getInterpolatedPosition(float alpha) const {
+			return previous_position_ + (position_ - previous_position_) * alpha;
+		}
+
+		/**
+		 * @brief 获取上一位姿与当前位姿之间的插值旋转角度（度）。
+		 * @param alpha 插值系数 [0, 1]，1 表示当前角度。
+		 */
+		float getInterpolatedRotation(float alpha) const {
+			return previous_rotation_ + (rotation_ - previous_rotation_) * alpha;
+		}
 	};
 }
\ No newline at end of file
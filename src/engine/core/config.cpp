@@ -82,6 +82,14 @@ void engine::core::Config::fromJson(const nlohmann::json& j)
     if (j.contains("graphics") && j["graphics"].is_object()) {
         const auto& graphics_config = j["graphics"];
         vsync_enabled_ = graphics_config.value("vsync", vsync_enabled_);
+        sprite_batching_enabled_ = graphics_config.value("sprite_batching", sprite_batching_enabled_);
+        tile_chunk_cache_enabled_ = graphics_config.value("tile_chunk_cache", tile_chunk_cache_enabled_);
+        tile_chunk_cache_budget_mb_ = graphics_config.value("tile_chunk_cache_budget_mb", tile_chunk_cache_budget_mb_);
+        if (tile_chunk_cache_budget_mb_ < 1) {
+            spdlog::warn("配置警告：瓦片分块缓存预算 ({} MB) 必须为正数。已重置为 64。", tile_chunk_cache_budget_mb_);
+            tile_chunk_cache_budget_mb_ = 64;
+        }
+        texture_atlas_enabled_ = graphics_config.value("texture_atlas", texture_atlas_enabled_);
     }
 
     if (j.contains("performance") && j["performance"].is_object()) {
@@ -91,6 +99,37 @@ void engine::core::Config::fromJson(const nlohmann::json& j)
             spdlog::warn("配置警告：目标 FPS ({}) 不能为负数。已重置为 0（无限制）。", target_fps_);
             target_fps_ = 0;
         }
+        fixed_timestep_enabled_ = perf_config.value("fixed_timestep", fixed_timestep_enabled_);
+        fixed_update_rate_ = perf_config.value("fixed_update_rate", fixed_update_rate_);
+        if (fixed_update_rate_ <= 0) {
+            spdlog::warn("配置警告：固定更新频率 ({}) 必须为正数。已重置为 120。", fixed_update_rate_);
+            fixed_update_rate_ = 120;
+        }
+        max_fixed_steps_per_frame_ = perf_config.value("max_steps_per_frame", max_fixed_steps_per_frame_);
+        if (max_fixed_steps_per_frame_ <= 0) {
+            spdlog::warn("配置警告：每帧最大步数 ({}) 必须为正数。已重置为 5。", max_fixed_steps_per_frame_);
+            max_fixed_steps_per_frame_ = 5;
+        }
+        physics_threads_ = perf_config.value("physics_threads", physics_threads_);
+        if (physics_threads_ < 0) {
+            spdlog::warn("配置警告：物理线程数 ({}) 不能为负数。已重置为 0（自动）。", physics_threads_);
+            physics_threads_ = 0;
+        }
+        physics_verify_parallel_ = perf_config.value("physics_verify_parallel", physics_verify_parallel_);
+        deterministic_enabled_ = perf_config.value("deterministic", deterministic_enabled_);
+        random_seed_ = perf_config.value("random_seed", random_seed_);
+        level_preload_enabled_ = perf_config.value("level_preload", level_preload_enabled_);
+        level_preload_upload_budget_ms_ = perf_config.value("level_preload_upload_budget_ms", level_preload_upload_budget_ms_);
+        if (level_preload_upload_budget_ms_ <= 0.0f) {
+            spdlog::warn("配置警告：预加载上传预算 ({} ms) 必须为正数。已重置为 2。", level_preload_upload_budget_ms_);
+            level_preload_upload_budget_ms_ = 2.0f;
+        }
+    }
+
+    if (j.contains("replay") && j["replay"].is_object()) {
+        const auto& replay_config = j["replay"];
+        input_record_path_ = replay_config.value("record", input_record_path_);
+        input_replay_path_ = replay_config.value("play", input_replay_path_);
     }
 
     if (j.contains("audio") && j["audio"].is_object()) {
@@ -142,10 +181,27 @@ nlohmann::ordered_json engine::core::Config::toJson() const
             {"resizable", window_resizable_}
         }},
         {"graphics", {
-            {"vsync", vsync_enabled_}
+            {"vsync", vsync_enabled_},
+            {"sprite_batching", sprite_batching_enabled_},
+            {"tile_chunk_cache", tile_chunk_cache_enabled_},
+            {"tile_chunk_cache_budget_mb", tile_chunk_cache_budget_mb_},
+            {"texture_atlas", texture_atlas_enabled_}
         }},
         {"performance", {
-            {"target_fps", target_fps_}
+            {"target_fps", target_fps_},
+            {"fixed_timestep", fixed_timestep_enabled_},
+            {"fixed_update_rate", fixed_update_rate_},
+            {"max_steps_per_frame", max_fixed_steps_per_frame_},
+            {"physics_threads", physics_threads_},
+            {"physics_verify_parallel", physics_verify_parallel_},
+            {"deterministic", deterministic_enabled_},
+            {"random_seed", random_seed_},
+            {"level_preload", level_preload_enabled_},
+            {"level_preload_upload_budget_ms", level_preload_upload_budget_ms_}
+        }},
+        {"replay", {
+            {"record", input_record_path_},
+            {"play", input_replay_path_}
         }},
         {"audio", {
             {"music_volume", music_volume_},
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 #include <nlohmann/json_fwd.hpp>    // nlohmann_json 提供的前向声明
 
 namespace engine::core {
@@ -30,9 +31,26 @@ namespace engine::core {
 
         // 图形设置
         bool vsync_enabled_ = true;             ///< 是否启用垂直同步
+        bool sprite_batching_enabled_ = true;   ///< 是否把同一纹理的连续精灵合并为一次 SDL_RenderGeometry 调用
+        bool tile_chunk_cache_enabled_ = true;  ///< 是否把静态瓦片图层预烘焙为分块渲染目标纹理
+        int tile_chunk_cache_budget_mb_ = 64;   ///< 瓦片分块纹理的显存预算 (MB)，超出时按 LRU 淘汰
+        bool texture_atlas_enabled_ = true;     ///< 加载关卡时是否把关卡图片打包为纹理图集
 
         // 性能设置
         int target_fps_ = 144;                  ///< 目标 FPS 设置，0 表示不限制
+        bool fixed_timestep_enabled_ = true;    ///< 是否以固定步长更新逻辑与物理（渲染按插值进行）
+        int fixed_update_rate_ = 120;           ///< 固定步长的更新频率 (Hz)
+        int max_fixed_steps_per_frame_ = 5;     ///< 每帧最多执行的固定步数，防止卡顿后"死亡螺旋"
+        int physics_threads_ = 0;               ///< 物理步使用的线程数，0 表示按 CPU 核心数自动选择，1 表示单线程
+        bool physics_verify_parallel_ = false;  ///< 是否校验并行物理步与单线程结果一致（仅调试构建生效）
+        bool deterministic_enabled_ = false;    ///< 确定性模式：每帧恰好推进一个固定步，随机数使用固定种子
+        std::uint32_t random_seed_ = 12345;     ///< 确定性模式下的随机数种子
+        bool level_preload_enabled_ = true;     ///< 接近关卡出口时是否在后台预加载下一关
+        float level_preload_upload_budget_ms_ = 2.0f; ///< 预加载的纹理每帧上传的时间预算 (ms)
+
+        // 输入录制与回放（用于性能回归对比），路径为空表示不启用，两者同时设置时回放优先
+        std::string input_record_path_;         ///< 把本次会话的输入录制到该文件
+        std::string input_replay_path_;         ///< 回放该文件中的输入
 
         // 音频设置
         float master_volume_ = 0.5f;             ///< 主音量 (0.0 - 1.0)
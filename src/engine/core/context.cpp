@@ -6,6 +6,7 @@
 #include "../resource/resource_manager.h"
 #include "../physics/physics_engine.h"
 #include "game_state.h"
+#include "random.h"
 
 #include<spdlog/spdlog.h>
 engine::core::Context::Context(engine::render::Renderer& renderer, 
@@ -14,14 +15,16 @@ engine::core::Context::Context(engine::render::Renderer& renderer,
 							   engine::resource::ResourceManager& resource_manager, 
 							   engine::input::InputManager& input_manager,
 							   engine::physics::PhysicsEngine& physics_engine,
-							   engine::core::GameState& game_state)
+							   engine::core::GameState& game_state,
+							   engine::core::Random& random)
 							 : renderer_(renderer),
 							   text_renderer_(text_renderer),
 							   camera_(camera),
 							   resource_manager_(resource_manager),
 							   input_manager_(input_manager),
 							   physics_engine_(physics_engine),
-							   game_state_(game_state)
+							   game_state_(game_state),
+							   random_(random)
 {
 	spdlog::info("Context created.");
 }
@@ -24,6 +24,7 @@ namespace engine::render
 namespace engine::core
 {
 	class GameState;
+	class Random;
 }
 namespace engine::physics
 {
@@ -56,6 +57,10 @@ namespace engine::core
 		engine::physics::PhysicsEngine& physics_engine_;
 		/// 游戏状态引用
 		engine::core::GameState& game_state_;
+		/// 随机数服务引用
+		engine::core::Random& random_;
+		/// 渲染插值系数：上一固定步到当前固定步之间的比例，非固定步模式下恒为 1
+		float interpolation_alpha_ = 1.0f;
 	public:
 		/**
 		 * @brief 构造函数，初始化上下文并保存各系统引用。
@@ -66,6 +71,7 @@ namespace engine::core
 		 * @param input_manager 输入管理器引用
 		 * @param physics_engine 物理引擎引用
 		 * @param game_state 游戏状态引用
+		 * @param random 随机数服务引用
 		 */
 		Context(engine::render::Renderer& renderer,
 				engine::render::TextRenderer& text_renderer,
@@ -73,7 +79,8 @@ namespace engine::core
 				engine::resource::ResourceManager& resource_manager,
 				engine::input::InputManager& input_manager,
 				engine::physics::PhysicsEngine& physics_engine,
-				engine::core::GameState& game_state);
+				engine::core::GameState& game_state,
+				engine::core::Random& random);
 			
 
 		/// 禁止拷贝构造和移动
@@ -144,6 +151,30 @@ namespace engine::core
 		{
 			return game_state_;
 		}
+		/**
+		 * @brief 获取随机数服务引用。游戏逻辑的随机数都应从这里获取，以便确定性模式下复现。
+		 * @return Random& 随机数服务引用
+		 */
+		engine::core::Random& getRandom()
+		{
+			return random_;
+		}
+		/**
+		 * @brief 获取渲染插值系数。
+		 * @return float [0, 1]，1 表示直接使用当前位姿
+		 */
+		float getInterpolationAlpha() const
+		{
+			return interpolation_alpha_;
+		}
+		/**
+		 * @brief 设置渲染插值系数，由主循环在渲染前写入。
+		 * @param alpha 插值系数 [0, 1]
+		 */
+		void setInterpolationAlpha(float alpha)
+		{
+			interpolation_alpha_ = alpha;
+		}
 	};
 
 }
\ No newline at end of file
@@ -3,21 +3,26 @@
 #include <SDL3/SDL.h>
 #include "Time.h"
 #include "game_state.h"
+#include "random.h"
 #include "../resource/resource_manager.h"
 #include "../render/camera.h"
 #include "../render/renderer.h"
 #include "../render/text_renderer.h"
 #include "config.h"
 #include "../input/input_manager.h"
+#include "../input/input_recording.h"
 #include "../object/game_object.h"
 #include "../component/transform_component.h"
 #include "../component/sprite_component.h"
 #include "context.h"
 #include "../scene/scene_manager.h"
+#include "../scene/level_preloader.h"
 #include "../../game/scene/game_scene.h"
 #include "../../game/scene/title_scene.h"
 #include "../../game/data/session_data.h"
 #include "../physics/physics_engine.h"
+#include <algorithm>
+#include <thread>
 #include "../audio/audio_player.h"
 #include "../audio/audio_locator.h"
 #include "../audio/log_audio_player.h"
@@ -52,15 +57,92 @@ void engine::core::GameApp::run()
 	}
 	time_->setTargetFPS(config_->target_fps_);
 	time_->setTimeScale(1.0);
+
+	// 固定步长：逻辑与物理以恒定 dt 推进，渲染在最近两步的位姿之间插值
+	const bool deterministic = config_->deterministic_enabled_;
+	const bool fixed_timestep = config_->fixed_timestep_enabled_;
+	const float fixed_delta_time = 1.0f / static_cast<float>(config_->fixed_update_rate_);
+	const int max_steps = config_->max_fixed_steps_per_frame_;
+	float accumulator = 0.0f;
+
+	// 确定性模式下统计每帧处理耗时（输入、更新与绘制，不含呈现时的垂直同步等待和帧率限制），用于对比不同构建的性能
+	std::uint64_t frame_count = 0;
+	double total_work_time = 0.0;
+	double max_work_time = 0.0;
+
 	while(is_running_) {
 		time_->update();
 		float delta_time = time_->getDeltaTime();
-		input_manager_->Update();
-		handleEvents();
-		update(delta_time);
+		const Uint64 work_start_time = SDL_GetTicksNS();
+
+		if (deterministic) {
+			// 确定性模式：每帧恰好推进一个固定步，与墙钟时间无关，同样的输入序列得到同样的结果
+			++frame_count;
+			input_manager_->Update();
+			handleEvents();
+			if (is_running_) {
+				float step_delta_time = fixed_delta_time;
+				update(step_delta_time);
+			}
+			context_->setInterpolationAlpha(1.0f);
+		}
+		else if (fixed_timestep) {
+			// 输入在每个固定步内处理：力只作用于一个步长，"刚按下"状态也只被第一个步看到；
+			// 本帧无需推进时不轮询事件，留到下一帧，避免按键边沿丢失
+			accumulator += delta_time;
+			int steps = 0;
+			while (accumulator >= fixed_delta_time && steps < max_steps) {
+				input_manager_->Update();
+				handleEvents();
+				float step_delta_time = fixed_delta_time;
+				update(step_delta_time);
+				accumulator -= fixed_delta_time;
+				++steps;
+			}
+			// 达到步数上限仍有积压时丢弃剩余时间，宁可放慢也不追帧
+			if (accumulator >= fixed_delta_time) {
+				spdlog::debug("固定步长积压 {:.3f}s，已丢弃", accumulator);
+				accumulator = 0.0f;
+			}
+			context_->setInterpolationAlpha(accumulator / fixed_delta_time);
+		}
+		else {
+			input_manager_->Update();
+			handleEvents();
+			update(delta_time);
+			context_->setInterpolationAlpha(1.0f);
+		}
+		camera_->setInterpolationAlpha(context_->getInterpolationAlpha());
 		render();
+		// 第一帧包含场景初始化，不计入统计
+		if (deterministic && frame_count > 1) {
+			const double work_time = static_cast<double>(SDL_GetTicksNS() - work_start_time) / 1e9;
+			total_work_time += work_time;
+			max_work_time = std::max(max_work_time, work_time);
+		}
+		present();
 		//spdlog::info("delta_time: {}", delta_time);
 	}
+
+	if (deterministic) {
+		const double measured = frame_count > 1 ? static_cast<double>(frame_count - 1) : 1.0;
+		spdlog::info("确定性会话结束：{} 帧，平均处理耗时 {:.3f} ms，最大 {:.3f} ms，物理状态校验和 {:016x}",
+			frame_count, total_work_time / measured * 1000.0, max_work_time * 1000.0, physics_engine_->computeStateHash());
+	}
+	if (const size_t rendered_frames = renderer_->getFrameCount(); rendered_frames > 0) {
+		const auto& render_stats = renderer_->getTotalStats();
+		const double frames = static_cast<double>(rendered_frames);
+		spdlog::info("渲染统计（精灵合批{}）：{} 帧，平均每帧 {:.1f} 次绘制调用、{:.1f} 个精灵、{:.1f} 个批次",
+			renderer_->isBatchingEnabled() ? "开启" : "关闭", rendered_frames,
+			static_cast<double>(render_stats.draw_calls) / frames, static_cast<double>(render_stats.sprites) / frames,
+			static_cast<double>(render_stats.batches) / frames);
+		const auto& chunk_cache = renderer_->getTileChunkCache();
+		if (chunk_cache.isEnabled()) {
+			spdlog::info("瓦片分块缓存：烘焙 {} 块，淘汰 {} 块，常驻 {} 块 ({} KB)",
+				chunk_cache.getBakeCount(), chunk_cache.getEvictionCount(), chunk_cache.getResidentCount(), chunk_cache.getUsedBytes() / 1024);
+		}
+	}
+	input_manager_->stopRecording();
 	close();
 }
 
@@ -85,11 +167,15 @@ bool engine::core::GameApp::init()
 		initTextRenderer()&&
 		initCamera()&&
 		initGameState()&&
+		initRandom()&&
 		initPhysicsEngine() &&
 		initContext()&&
 		initSceneManager()) 
 	{
 		spdlog::info("游戏应用程序初始化成功。");
+
+		// 输入回放/录制需要在创建第一个场景之前开始，保证整个会话都被覆盖
+		initInputSession();
 		
 		// 初始化会话数据
 		auto session_data = game::data::SessionData::getInstance();
@@ -146,7 +232,7 @@ void engine::core::GameApp::update(float& delta_time)
 }
 
 /**
- * @brief 渲染游戏画面。
+ * @brief 绘制游戏画面（提交到渲染器，尚未显示）。
  */
 void engine::core::GameApp::render()
 {
@@ -157,8 +243,13 @@ void engine::core::GameApp::render()
 	if (scene_manager_) {
 		scene_manager_->render();
 	}
+}
 
-	// 3. 更新屏幕显示
+/**
+ * @brief 显示本帧画面。开启垂直同步时会在此等待刷新。
+ */
+void engine::core::GameApp::present()
+{
 	renderer_->present();
 }
 
@@ -168,6 +259,10 @@ void engine::core::GameApp::render()
 void engine::core::GameApp::close()
 {
 	spdlog::trace("关闭 GameApp ...");
+	if (renderer_) {
+		// 分块纹理属于 SDL 渲染器，必须在销毁渲染器之前释放
+		renderer_->getTileChunkCache().clear();
+	}
 	if (sdl_renderer_ != nullptr) {
 		SDL_DestroyRenderer(sdl_renderer_);
 		sdl_renderer_ = nullptr;
@@ -258,6 +353,7 @@ bool engine::core::GameApp::initTime()
 bool engine::core::GameApp::initResourceManager() {
 	try {
 		resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_);
+		resource_manager_->setTextureAtlasEnabled(config_->texture_atlas_enabled_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化资源管理器失败: {}", e.what());
@@ -275,6 +371,9 @@ bool engine::core::GameApp::initRenderer()
 {
 	try {
 		renderer_ = std::make_unique<engine::render::Renderer>(sdl_renderer_, resource_manager_.get());
+		renderer_->setBatchingEnabled(config_->sprite_batching_enabled_);
+		renderer_->getTileChunkCache().setEnabled(config_->tile_chunk_cache_enabled_);
+		renderer_->getTileChunkCache().setBudgetBytes(static_cast<size_t>(config_->tile_chunk_cache_budget_mb_) * 1024u * 1024u);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化渲染器失败: {}", e.what());
@@ -291,7 +390,7 @@ bool engine::core::GameApp::initRenderer()
 bool engine::core::GameApp::initTextRenderer()
 {
 	try {
-		text_renderer_ = std::make_unique<engine::render::TextRenderer>(sdl_renderer_, resource_manager_.get());
+		text_renderer_ = std::make_unique<engine::render::TextRenderer>(sdl_renderer_, resource_manager_.get(), renderer_.get());
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化文本渲染器失败: {}", e.what());
@@ -349,7 +448,8 @@ bool engine::core::GameApp::initContext()
 			*resource_manager_,
 			*input_manager_,
 			*physics_engine_,
-			*game_state_);
+			*game_state_,
+			*random_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化上下文失败: {}", e.what());
@@ -393,6 +493,57 @@ bool engine::core::GameApp::initGameState()
 	return true;
 }
 
+/**
+ * @brief 初始化随机数服务。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initRandom()
+{
+	try {
+		const std::uint32_t seed = config_->deterministic_enabled_ ? config_->random_seed_ : Random::makeRandomSeed();
+		random_ = std::make_unique<Random>(seed);
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化随机数服务失败: {}", e.what());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief 按配置开始输入回放或录制。
+ */
+void engine::core::GameApp::initInputSession()
+{
+	if (!config_->input_replay_path_.empty()) {
+		engine::input::InputRecordingInfo info;
+		if (!input_manager_->startReplay(config_->input_replay_path_, &info)) {
+			spdlog::error("输入回放启动失败，使用实时输入。");
+			return;
+		}
+		config_->deterministic_enabled_ = true;
+		if (info.update_rate > 0) {
+			config_->fixed_update_rate_ = static_cast<int>(info.update_rate);
+		}
+		random_->seed(info.random_seed);
+		return;
+	}
+
+	if (!config_->input_record_path_.empty()) {
+		if (!config_->deterministic_enabled_) {
+			spdlog::info("录制输入时自动开启确定性模式，随机数种子 {}", config_->random_seed_);
+			config_->deterministic_enabled_ = true;
+			random_->seed(config_->random_seed_);
+		}
+		engine::input::InputRecordingInfo info;
+		info.random_seed = random_->getSeed();
+		info.update_rate = static_cast<std::uint32_t>(config_->fixed_update_rate_);
+		if (!input_manager_->startRecording(config_->input_record_path_, info)) {
+			spdlog::error("输入录制启动失败，本次会话不录制。");
+		}
+	}
+}
+
 /**
  * @brief 初始化场景管理器。
  * @return 初始化成功返回 true，否则返回 false。
@@ -401,6 +552,8 @@ bool engine::core::GameApp::initSceneManager()
 {
 	try {
 		scene_manager_ = std::make_unique<engine::scene::SceneManager>(*context_);
+		scene_manager_->getLevelPreloader().setEnabled(config_->level_preload_enabled_);
+		scene_manager_->getLevelPreloader().setUploadBudget(config_->level_preload_upload_budget_ms_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化场景管理器失败: {}", e.what());
@@ -418,6 +571,20 @@ bool engine::core::GameApp::initPhysicsEngine()
 	try
 	{
 		physics_engine_ = std::make_unique<engine::physics::PhysicsEngine>();
+
+		// 线程数为 0 时按 CPU 核心数选择；hardware_concurrency 可能返回 0（无法探测），此时单线程
+		size_t physics_threads = static_cast<size_t>(config_->physics_threads_);
+		if (physics_threads == 0) {
+			physics_threads = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+		physics_engine_->setWorkerThreadCount(physics_threads);
+#ifndef NDEBUG
+		physics_engine_->setParallelVerification(config_->physics_verify_parallel_);
+#else
+		if (config_->physics_verify_parallel_) {
+			spdlog::warn("physics_verify_parallel 仅在调试构建中生效，已忽略。");
+		}
+#endif
 	}
 	catch (const std::exception&)
 	{
@@ -38,6 +38,7 @@ namespace engine::core {
     class Config;
     class Context;
     class GameState;
+    class Random;
 
     /**
      * @class GameApp
@@ -82,6 +83,8 @@ namespace engine::core {
         std::unique_ptr<engine::audio::IAudioPlayer> audio_player_;
         /// 游戏状态
         std::unique_ptr<GameState> game_state_;
+        /// 随机数服务
+        std::unique_ptr<Random> random_;
         /// 初始化回调函数
         std::function<void(engine::scene::SceneManager&)> on_init_;
 
@@ -132,9 +135,14 @@ namespace engine::core {
         void update(float& delta_time);
         
         /**
-         * @brief 渲染游戏画面。
+         * @brief 绘制游戏画面（提交到渲染器，尚未显示）。
          */
         void render();
+
+        /**
+         * @brief 显示本帧画面（开启垂直同步时在此等待）。
+         */
+        void present();
         
         /**
          * @brief 关闭游戏，清理资源。
@@ -219,5 +227,17 @@ namespace engine::core {
          */
         [[nodiscard]] bool initGameState();
 
+        /**
+         * @brief 初始化随机数服务，确定性模式下使用配置中的种子。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initRandom();
+
+        /**
+         * @brief 按配置开始输入回放或录制；两者都会开启确定性模式，回放时使用录制文件中的种子与更新频率。
+         * @details 打开文件失败只输出错误，游戏照常以实时输入运行。
+         */
+        void initInputSession();
+
     };
 }
\ No newline at end of file
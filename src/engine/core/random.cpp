@@ -0,0 +1,55 @@
+#include "random.h"
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+Random::Random(std::uint32_t seed)
+{
+    this->seed(seed);
+}
+
+/**
+ * @brief 重新设定种子
+ *
+ * @param seed 种子
+ */
+void Random::seed(std::uint32_t seed)
+{
+    seed_ = seed;
+    engine_.seed(seed);
+    spdlog::debug("随机数种子设置为 {}", seed);
+}
+
+/**
+ * @brief 生成 [min, max] 内的整数
+ *
+ * @details 用 64 位乘法把 32 位随机数映射到区间（Lemire 方法，省略拒绝采样），
+ *          偏差小于 区间长度 / 2^32，对游戏逻辑可以忽略。
+ */
+int Random::range(int min, int max)
+{
+    if (max < min) std::swap(min, max);
+    const auto span = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - static_cast<std::int64_t>(min)) + 1u;
+    const auto offset = (static_cast<std::uint64_t>(nextUInt()) * span) >> 32;
+    return static_cast<int>(static_cast<std::int64_t>(min) + static_cast<std::int64_t>(offset));
+}
+
+/**
+ * @brief 生成 [min, max) 内的浮点数
+ *
+ * @details 取高 24 位构造 [0, 1) 内的 float，所有值都能被精确表示。
+ */
+float Random::range(float min, float max)
+{
+    const float unit = static_cast<float>(nextUInt() >> 8) * (1.0f / 16777216.0f);
+    return min + (max - min) * unit;
+}
+
+std::uint32_t Random::makeRandomSeed()
+{
+    std::random_device device;
+    return device();
+}
+
+} // namespace engine::core
@@ -0,0 +1,64 @@
+#pragma once
+/**
+ * @file random.h
+ * @brief 定义 Random，一个可设定种子的随机数服务。
+ */
+
+#include <cstdint>
+#include <random>
+
+namespace engine::core {
+
+    /**
+     * @class Random
+     * @brief 全局随机数服务，通过 Context 访问。
+     *
+     * 游戏逻辑中的随机数都应从这里获取，而不是各自创建引擎或调用 rand()，
+     * 这样确定性模式下固定种子即可复现整局游戏。
+     * 区间映射不使用 std::uniform_*_distribution（其算法由标准库实现决定），
+     * 因此同一种子在不同编译器与平台上得到相同的序列。
+     */
+    class Random final {
+    private:
+        std::mt19937 engine_;          ///< 序列由标准规定，跨平台一致
+        std::uint32_t seed_ = 0;       ///< 当前种子
+
+    public:
+        /**
+         * @brief 构造函数。
+         * @param seed 初始种子。
+         */
+        explicit Random(std::uint32_t seed);
+
+        Random(const Random&) = delete;
+        Random& operator=(const Random&) = delete;
+        Random(Random&&) = delete;
+        Random& operator=(Random&&) = delete;
+
+        /// 重新设定种子，序列从头开始
+        void seed(std::uint32_t seed);
+        /// 获取当前种子
+        std::uint32_t getSeed() const { return seed_; }
+
+        /// 下一个 32 位随机数
+        std::uint32_t nextUInt() { return static_cast<std::uint32_t>(engine_()); }
+
+        /**
+         * @brief 生成 [min, max] 内的整数。
+         * @details max < min 时交换两者。
+         */
+        int range(int min, int max);
+
+        /**
+         * @brief 生成 [min, max) 内的浮点数。
+         */
+        float range(float min, float max);
+
+        /// 以概率 probability 返回 true
+        bool chance(float probability) { return range(0.0f, 1.0f) < probability; }
+
+        /// 生成一个非确定性的种子（非确定性模式下使用）
+        static std::uint32_t makeRandomSeed();
+    };
+
+} // namespace engine::core
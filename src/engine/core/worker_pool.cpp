@@ -0,0 +1,101 @@
+#include "worker_pool.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+WorkerPool::WorkerPool(size_t thread_count)
+{
+    const size_t worker_count = thread_count > 1 ? thread_count - 1 : 0;
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+    spdlog::trace("WorkerPool 已创建，线程数：{}", getThreadCount());
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief 执行一轮任务
+ *
+ * @param task_count 块数
+ * @param task 块任务
+ * @details 工作线程与调用线程通过原子计数领取块号，调用线程在领取完后等待所有工作线程
+ *          结束本轮，保证返回时 task 不再被引用。
+ */
+void WorkerPool::run(size_t task_count, const std::function<void(size_t)>& task)
+{
+    if (task_count == 0) return;
+    if (workers_.empty()) {
+        for (size_t i = 0; i < task_count; ++i) task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        task_count_ = task_count;
+        next_task_.store(0, std::memory_order_relaxed);
+        pending_workers_ = workers_.size();
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drainTasks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_workers_ == 0; });
+    task_ = nullptr;
+}
+
+size_t WorkerPool::chunkCount(size_t count, size_t min_grain) const
+{
+    if (count == 0) return 0;
+    const size_t grain = std::max<size_t>(min_grain, 1);
+    return std::clamp<size_t>(count / grain, 1, getThreadCount());
+}
+
+/**
+ * @brief 工作线程主循环：等待新一轮任务，领取并执行块，完成后通知调用线程
+ */
+void WorkerPool::workerLoop()
+{
+    std::uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = generation_;
+        }
+
+        drainTasks();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::drainTasks()
+{
+    while (true) {
+        const size_t index = next_task_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= task_count_) return;
+        (*task_)(index);
+    }
+}
+
+} // namespace engine::core
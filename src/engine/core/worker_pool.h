@@ -0,0 +1,96 @@
+#pragma once
+/**
+ * @file worker_pool.h
+ * @brief 定义 WorkerPool，一个为帧内数据并行任务准备的常驻线程池。
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+namespace engine::core {
+
+    /**
+     * @class WorkerPool
+     * @brief 常驻工作线程池，按"分块"执行数据并行任务。
+     *
+     * 调用线程本身也参与执行，因此 N 个线程的池只额外创建 N - 1 个工作线程。
+     * 任务被切成下标连续的块，块号与线程无关：调用方按块号保存各块的输出，
+     * 再按块号顺序拼接，即可得到与单线程遍历完全相同的顺序。
+     *
+     * 同一时刻只能有一个 run() 在执行，任务函数不应抛出异常。
+     */
+    class WorkerPool final {
+    private:
+        std::vector<std::thread> workers_;                 ///< 工作线程（不含调用线程）
+        std::mutex mutex_;
+        std::condition_variable start_cv_;                 ///< 通知工作线程有新任务
+        std::condition_variable done_cv_;                  ///< 通知调用线程所有工作线程已完成
+        const std::function<void(size_t)>* task_ = nullptr; ///< 当前任务（仅在 run() 期间有效）
+        size_t task_count_ = 0;                            ///< 当前任务的块数
+        std::atomic<size_t> next_task_{ 0 };               ///< 下一个待领取的块号
+        std::uint64_t generation_ = 0;                     ///< 每次 run() 递增，唤醒工作线程
+        size_t pending_workers_ = 0;                       ///< 尚未完成本轮的工作线程数
+        bool stopping_ = false;                            ///< 析构时通知工作线程退出
+
+    public:
+        /**
+         * @brief 构造函数。
+         * @param thread_count 参与执行的线程总数（含调用线程），小于 1 时按 1 处理。
+         */
+        explicit WorkerPool(size_t thread_count);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        WorkerPool(WorkerPool&&) = delete;
+        WorkerPool& operator=(WorkerPool&&) = delete;
+
+        /// 参与执行的线程总数（含调用线程）
+        size_t getThreadCount() const { return workers_.size() + 1; }
+
+        /**
+         * @brief 执行 task(0) ... task(task_count - 1)，阻塞直到全部完成。
+         * @param task_count 块数。
+         * @param task 块任务，参数为块号。
+         */
+        void run(size_t task_count, const std::function<void(size_t)>& task);
+
+        /**
+         * @brief 计算 parallelFor 会把 count 个元素切成多少块。
+         * @param count 元素数量。
+         * @param min_grain 每块至少包含的元素数，避免小数据量时的调度开销超过收益。
+         */
+        size_t chunkCount(size_t count, size_t min_grain) const;
+
+        /**
+         * @brief 把 [0, count) 切成连续的块并行执行 fn(begin, end, chunk)。
+         * @details 只有一块时直接在调用线程执行，不唤醒工作线程。
+         *          块的划分只取决于 count、min_grain 和线程数，不受调度影响。
+         */
+        template<typename Fn>
+        void parallelFor(size_t count, size_t min_grain, Fn&& fn) {
+            const size_t chunks = chunkCount(count, min_grain);
+            if (chunks <= 1) {
+                if (count > 0) fn(size_t{ 0 }, count, size_t{ 0 });
+                return;
+            }
+            const size_t chunk_size = (count + chunks - 1) / chunks;
+            const std::function<void(size_t)> task = [&](size_t chunk) {
+                const size_t begin = chunk * chunk_size;
+                const size_t end = begin + chunk_size < count ? begin + chunk_size : count;
+                if (begin < end) fn(begin, end, chunk);
+            };
+            run(chunks, task);
+        }
+
+    private:
+        void workerLoop();
+        void drainTasks();
+    };
+
+} // namespace engine::core
@@ -1,6 +1,8 @@
 #include "input_manager.h"
+#include "input_recording.h"
 #include "spdlog/spdlog.h"
 #include "../core/config.h"
+#include <algorithm>
 
 namespace engine::input {
 
@@ -27,10 +29,13 @@ InputManager::InputManager(SDL_Renderer* sdl_renderer, const engine::core::Confi
 	
 }
 
+InputManager::~InputManager() = default;
+
 /**
  * @brief 更新输入状态
  * 
- * @details 更新动作状态，处理所有 SDL 事件，维护输入状态
+ * @details 更新动作状态，处理所有 SDL 事件，维护输入状态。
+ *          回放时只处理退出事件，动作状态与鼠标位置取自录制文件；录制时把处理后的状态写入文件。
  */
 void InputManager::Update()
 {
@@ -42,10 +47,118 @@ void InputManager::Update()
 			state = ActionState::INACTIVE;
 		}
 	}
+	const glm::vec2 previous_mouse_position = mouse_position_;
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
+		if (replayer_ && event.type != SDL_EVENT_QUIT) continue;
 		processEvent(event);
 	}
+
+	if (replayer_) {
+		applyReplayFrame();
+	}
+	else if (recorder_ && !should_quit_) {
+		recordFrame(mouse_position_ != previous_mouse_position);
+	}
+}
+
+/**
+ * @brief 开始录制输入
+ * 
+ * @param path 录制文件路径
+ * @param info 会话参数
+ * @return 成功返回 true
+ */
+bool InputManager::startRecording(const std::string& path, const InputRecordingInfo& info)
+{
+	if (replayer_) {
+		spdlog::warn("输入录制：正在回放，不能同时录制");
+		return false;
+	}
+	auto recorder = std::make_unique<InputRecorder>();
+	if (!recorder->open(path, action_order_, info)) {
+		return false;
+	}
+	recorder_ = std::move(recorder);
+	return true;
+}
+
+/**
+ * @brief 停止录制
+ */
+void InputManager::stopRecording()
+{
+	if (!recorder_) return;
+	recorder_->close();
+	recorder_.reset();
+}
+
+/**
+ * @brief 开始回放输入
+ * 
+ * @param path 录制文件路径
+ * @param out_info 输出会话参数
+ * @return 成功返回 true
+ * @details 录制文件中的动作按名称对应到当前配置的动作，当前配置中不存在的动作会被忽略。
+ */
+bool InputManager::startReplay(const std::string& path, InputRecordingInfo* out_info)
+{
+	stopRecording();
+	auto replayer = std::make_unique<InputReplayer>();
+	if (!replayer->open(path)) {
+		return false;
+	}
+
+	replay_targets_.clear();
+	for (const auto& action_name : replayer->getActionNames()) {
+		auto it = action_states_.find(action_name);
+		if (it == action_states_.end()) {
+			spdlog::warn("输入回放：当前配置中没有动作 '{}'，忽略", action_name);
+			replay_targets_.push_back(nullptr);
+		}
+		else {
+			replay_targets_.push_back(&it->second);
+		}
+	}
+	if (out_info) *out_info = replayer->getInfo();
+	replayer_ = std::move(replayer);
+	return true;
+}
+
+/**
+ * @brief 用回放文件的下一帧覆盖动作状态
+ */
+void InputManager::applyReplayFrame()
+{
+	bool mouse_moved = false;
+	glm::vec2 mouse_position = mouse_position_;
+	if (!replayer_->readFrame(frame_states_, mouse_moved, mouse_position)) {
+		spdlog::info("输入回放结束，共 {} 帧", replayer_->getFrameCount());
+		replayer_.reset();
+		replay_targets_.clear();
+		should_quit_ = true;
+		return;
+	}
+	for (size_t i = 0; i < frame_states_.size() && i < replay_targets_.size(); ++i) {
+		if (replay_targets_[i]) *replay_targets_[i] = frame_states_[i];
+	}
+	if (mouse_moved) {
+		mouse_position_ = mouse_position;
+	}
+}
+
+/**
+ * @brief 把本帧的动作状态写入录制文件
+ * 
+ * @param mouse_moved 本帧鼠标是否移动
+ */
+void InputManager::recordFrame(bool mouse_moved)
+{
+	frame_states_.clear();
+	for (const auto& action_name : action_order_) {
+		frame_states_.push_back(action_states_.at(action_name));
+	}
+	recorder_->writeFrame(frame_states_, mouse_moved, mouse_position_);
 }
 
 /**
@@ -219,8 +332,10 @@ void InputManager::initializeMapFromConfig(const engine::core::Config* config)
 		actions_to_keyname_["MouseRightClick"] = { "MouseRight" };
 	}
 
+	action_order_.clear();
 	for (const auto& [action_name, key_names] : actions_to_keyname_) {
 		action_states_[action_name] = ActionState::INACTIVE;
+		action_order_.push_back(action_name);
 		spdlog::trace("映射动作: {}", action_name);
 
 		for (const std::string& key_name : key_names) {
@@ -240,6 +355,8 @@ void InputManager::initializeMapFromConfig(const engine::core::Config* config)
 			}
 		}
 	}
+	// unordered_map 的遍历顺序与实现有关，录制文件使用排序后的顺序
+	std::sort(action_order_.begin(), action_order_.end());
 	
 }
 
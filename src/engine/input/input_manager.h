@@ -10,6 +10,7 @@
 #include <glm/vec2.hpp>
 #include <vector>
 #include <variant>
+#include <memory>
 
 namespace engine::core
 {
@@ -22,6 +23,10 @@ namespace engine::core
  */
 namespace engine::input
 {
+	class InputRecorder;
+	class InputReplayer;
+	struct InputRecordingInfo;
+
 	/**
 	 * @enum ActionState
 	 * @brief 动作的状态枚举
@@ -64,6 +69,12 @@ namespace engine::input
 
 		bool should_quit_ = false; ///< 是否收到退出信号
 		glm::vec2 mouse_position_; ///< 窗口坐标系下的鼠标位置
+
+		std::vector<std::string> action_order_;          ///< 按名称排序的动作列表，录制文件按此顺序保存状态
+		std::unique_ptr<InputRecorder> recorder_;        ///< 输入录制器，未录制时为空
+		std::unique_ptr<InputReplayer> replayer_;        ///< 输入回放器，未回放时为空
+		std::vector<ActionState*> replay_targets_;       ///< 录制文件中各动作对应的状态（当前配置中不存在的为空）
+		std::vector<ActionState> frame_states_;          ///< 录制/回放时单帧状态的缓冲
 	public:
 		/**
 		 * @brief 构造函数
@@ -71,6 +82,7 @@ namespace engine::input
 		 * @param config 配置对象，用于加载输入映射
 		 */
 		InputManager(SDL_Renderer* sdl_renderer, const engine::core::Config* config);
+		~InputManager();
 		
 		/**
 		 * @brief 更新输入状态。
@@ -124,6 +136,32 @@ namespace engine::input
 		 */
 		glm::vec2 getLogicalMousePosition() const;
 
+		/**
+		 * @brief 开始把每帧的动作状态录制到文件。
+		 * @param path 录制文件路径
+		 * @param info 写入文件头的会话参数
+		 * @return 成功返回 true
+		 * @details 收到退出事件的那一帧不会被录制（该帧游戏不再更新），回放时在同一位置结束。
+		 */
+		bool startRecording(const std::string& path, const InputRecordingInfo& info);
+
+		/**
+		 * @brief 停止录制并关闭文件。
+		 */
+		void stopRecording();
+
+		/**
+		 * @brief 开始回放录制文件，回放期间忽略实际的键盘与鼠标输入（窗口关闭事件除外）。
+		 * @param path 录制文件路径
+		 * @param out_info 输出文件头中的会话参数，可为空
+		 * @return 成功返回 true
+		 * @details 所有帧回放完毕后设置退出信号。
+		 */
+		bool startReplay(const std::string& path, InputRecordingInfo* out_info = nullptr);
+
+		bool isRecording() const { return recorder_ != nullptr; } ///< @brief 是否正在录制
+		bool isReplaying() const { return replayer_ != nullptr; } ///< @brief 是否正在回放
+
 	private:
 		/**
 		 * @brief 处理单个 SDL 事件
@@ -131,6 +169,17 @@ namespace engine::input
 		 */
 		void processEvent(const SDL_Event& event);
 
+		/**
+		 * @brief 用回放文件的下一帧覆盖动作状态，没有剩余帧时结束回放并请求退出
+		 */
+		void applyReplayFrame();
+
+		/**
+		 * @brief 把本帧的动作状态写入录制文件
+		 * @param mouse_moved 本帧鼠标是否移动
+		 */
+		void recordFrame(bool mouse_moved);
+
 		/**
 		 * @brief 从配置文件初始化输入映射
 		 * @param config 配置对象指针
@@ -0,0 +1,228 @@
+#include "input_recording.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <spdlog/spdlog.h>
+
+namespace engine::input {
+
+namespace {
+    constexpr std::array<char, 4> RECORDING_MAGIC{ 'S', 'L', 'I', 'R' };
+    constexpr std::uint16_t RECORDING_VERSION = 1;
+    constexpr std::uint8_t FRAME_MOUSE_MOVED = 1u << 0;
+
+    void putU8(std::vector<std::uint8_t>& out, std::uint8_t value) {
+        out.push_back(value);
+    }
+
+    void putU16(std::vector<std::uint8_t>& out, std::uint16_t value) {
+        out.push_back(static_cast<std::uint8_t>(value));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+    }
+
+    void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            out.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+    }
+
+    void putF32(std::vector<std::uint8_t>& out, float value) {
+        putU32(out, std::bit_cast<std::uint32_t>(value));
+    }
+
+    /// 顺序读取字节流，越界时置 ok = false 并返回 0
+    struct ByteReader {
+        const std::vector<std::uint8_t>& data;
+        size_t& cursor;
+        bool ok = true;
+
+        std::uint8_t u8() {
+            if (cursor + 1 > data.size()) { ok = false; return 0; }
+            return data[cursor++];
+        }
+        std::uint16_t u16() {
+            const std::uint16_t lo = u8();
+            const std::uint16_t hi = u8();
+            return static_cast<std::uint16_t>(lo | (hi << 8));
+        }
+        std::uint32_t u32() {
+            std::uint32_t value = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                value |= static_cast<std::uint32_t>(u8()) << shift;
+            }
+            return value;
+        }
+        float f32() { return std::bit_cast<float>(u32()); }
+    };
+
+    /// 每帧动作状态占用的字节数（每个动作 2 位）
+    size_t packedStateBytes(size_t action_count) {
+        return (action_count + 3) / 4;
+    }
+}
+
+/**
+ * @brief 创建录制文件并写入文件头
+ *
+ * @param path 文件路径
+ * @param action_names 动作名
+ * @param info 会话参数
+ * @return 成功返回 true
+ */
+bool InputRecorder::open(const std::string& path, const std::vector<std::string>& action_names, const InputRecordingInfo& info)
+{
+    close();
+    if (action_names.size() > UINT16_MAX) {
+        spdlog::error("输入录制失败：动作数量 {} 过多", action_names.size());
+        return false;
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        spdlog::error("输入录制失败：无法创建文件 '{}'", path);
+        return false;
+    }
+
+    buffer_.clear();
+    buffer_.insert(buffer_.end(), RECORDING_MAGIC.begin(), RECORDING_MAGIC.end());
+    putU16(buffer_, RECORDING_VERSION);
+    putU32(buffer_, info.random_seed);
+    putU32(buffer_, info.update_rate);
+    putU16(buffer_, static_cast<std::uint16_t>(action_names.size()));
+    for (const auto& name : action_names) {
+        const size_t length = std::min<size_t>(name.size(), UINT8_MAX);
+        putU8(buffer_, static_cast<std::uint8_t>(length));
+        buffer_.insert(buffer_.end(), name.begin(), name.begin() + static_cast<std::ptrdiff_t>(length));
+    }
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+
+    action_count_ = action_names.size();
+    frame_count_ = 0;
+    spdlog::info("开始录制输入到 '{}'（{} 个动作，种子 {}，{} Hz）", path, action_count_, info.random_seed, info.update_rate);
+    return true;
+}
+
+/**
+ * @brief 写入一帧
+ *
+ * @param action_states 各动作状态
+ * @param mouse_moved 本帧鼠标是否移动
+ * @param mouse_position 鼠标位置
+ */
+void InputRecorder::writeFrame(const std::vector<ActionState>& action_states, bool mouse_moved, const glm::vec2& mouse_position)
+{
+    if (!file_.is_open()) return;
+
+    buffer_.clear();
+    putU8(buffer_, mouse_moved ? FRAME_MOUSE_MOVED : 0u);
+    const size_t state_offset = buffer_.size();
+    buffer_.resize(state_offset + packedStateBytes(action_count_), 0u);
+    for (size_t i = 0; i < action_count_ && i < action_states.size(); ++i) {
+        const auto bits = static_cast<std::uint8_t>(static_cast<std::uint8_t>(action_states[i]) & 0x3u);
+        buffer_[state_offset + i / 4] |= static_cast<std::uint8_t>(bits << ((i % 4) * 2));
+    }
+    if (mouse_moved) {
+        putF32(buffer_, mouse_position.x);
+        putF32(buffer_, mouse_position.y);
+    }
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    ++frame_count_;
+}
+
+/**
+ * @brief 关闭文件
+ */
+void InputRecorder::close()
+{
+    if (!file_.is_open()) return;
+    file_.close();
+    spdlog::info("输入录制结束，共 {} 帧", frame_count_);
+}
+
+/**
+ * @brief 读取录制文件并解析文件头
+ *
+ * @param path 文件路径
+ * @return 成功返回 true
+ */
+bool InputReplayer::open(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        spdlog::error("输入回放失败：无法打开文件 '{}'", path);
+        return false;
+    }
+    data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    cursor_ = 0;
+    frame_count_ = 0;
+    action_names_.clear();
+
+    ByteReader reader{ data_, cursor_ };
+    std::array<char, 4> magic{};
+    for (auto& c : magic) c = static_cast<char>(reader.u8());
+    const auto version = reader.u16();
+    if (!reader.ok || magic != RECORDING_MAGIC || version != RECORDING_VERSION) {
+        spdlog::error("输入回放失败：'{}' 不是有效的输入录制文件（版本 {}）", path, version);
+        return false;
+    }
+    info_.random_seed = reader.u32();
+    info_.update_rate = reader.u32();
+    const auto action_count = reader.u16();
+    for (std::uint16_t i = 0; i < action_count && reader.ok; ++i) {
+        const auto length = reader.u8();
+        if (cursor_ + length > data_.size()) {
+            reader.ok = false;
+            break;
+        }
+        action_names_.emplace_back(reinterpret_cast<const char*>(data_.data() + cursor_), length);
+        cursor_ += length;
+    }
+    if (!reader.ok) {
+        spdlog::error("输入回放失败：'{}' 的文件头不完整", path);
+        return false;
+    }
+    spdlog::info("开始回放输入 '{}'（{} 个动作，种子 {}，{} Hz）", path, action_names_.size(), info_.random_seed, info_.update_rate);
+    return true;
+}
+
+/**
+ * @brief 读取下一帧
+ *
+ * @param out_states 输出各动作状态
+ * @param out_mouse_moved 输出本帧鼠标是否移动
+ * @param out_mouse_position 输出鼠标位置
+ * @return 没有剩余帧时返回 false
+ */
+bool InputReplayer::readFrame(std::vector<ActionState>& out_states, bool& out_mouse_moved, glm::vec2& out_mouse_position)
+{
+    if (cursor_ >= data_.size()) return false;
+
+    ByteReader reader{ data_, cursor_ };
+    const auto flags = reader.u8();
+    const size_t state_bytes = packedStateBytes(action_names_.size());
+    if (cursor_ + state_bytes > data_.size()) {
+        spdlog::warn("输入回放：第 {} 帧数据不完整，提前结束", frame_count_);
+        cursor_ = data_.size();
+        return false;
+    }
+    out_states.resize(action_names_.size());
+    for (size_t i = 0; i < out_states.size(); ++i) {
+        const auto bits = static_cast<std::uint8_t>(data_[cursor_ + i / 4] >> ((i % 4) * 2)) & 0x3u;
+        out_states[i] = static_cast<ActionState>(bits);
+    }
+    cursor_ += state_bytes;
+
+    out_mouse_moved = (flags & FRAME_MOUSE_MOVED) != 0u;
+    if (out_mouse_moved) {
+        out_mouse_position.x = reader.f32();
+        out_mouse_position.y = reader.f32();
+        if (!reader.ok) {
+            spdlog::warn("输入回放：第 {} 帧数据不完整，提前结束", frame_count_);
+            return false;
+        }
+    }
+    ++frame_count_;
+    return true;
+}
+
+} // namespace engine::input
@@ -0,0 +1,117 @@
+#pragma once
+/**
+ * @file input_recording.h
+ * @brief 定义输入录制文件的写入器 InputRecorder 与读取器 InputReplayer。
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "input_manager.h"
+
+namespace engine::input {
+
+    /**
+     * @struct InputRecordingInfo
+     * @brief 录制文件头中保存的会话参数，回放时据此复现相同的模拟条件。
+     */
+    struct InputRecordingInfo {
+        std::uint32_t random_seed = 0;  ///< 随机数种子
+        std::uint32_t update_rate = 0;  ///< 固定步长的更新频率 (Hz)
+    };
+
+    /**
+     * @class InputRecorder
+     * @brief 将每帧的动作状态写入紧凑的二进制文件。
+     *
+     * 文件格式（小端序）：
+     * - 文件头："SLIR"、版本 (u16)、随机数种子 (u32)、更新频率 (u32)、动作数 (u16)，
+     *   之后依次为各动作名（u8 长度 + 字节）。
+     * - 每帧：标志 (u8，bit0 表示鼠标移动)，每个动作 2 位的 ActionState（按文件头中的动作顺序打包），
+     *   鼠标移动时再跟两个 f32 坐标。
+     */
+    class InputRecorder final {
+    private:
+        std::ofstream file_;
+        size_t action_count_ = 0;
+        size_t frame_count_ = 0;
+        std::vector<std::uint8_t> buffer_;   ///< 单帧编码缓冲（帧间复用）
+
+    public:
+        InputRecorder() = default;
+
+        InputRecorder(const InputRecorder&) = delete;
+        InputRecorder& operator=(const InputRecorder&) = delete;
+        InputRecorder(InputRecorder&&) = delete;
+        InputRecorder& operator=(InputRecorder&&) = delete;
+
+        /**
+         * @brief 创建录制文件并写入文件头。
+         * @param path 文件路径。
+         * @param action_names 动作名，帧数据按此顺序保存。
+         * @param info 会话参数。
+         * @return 成功返回 true。
+         */
+        bool open(const std::string& path, const std::vector<std::string>& action_names, const InputRecordingInfo& info);
+
+        /**
+         * @brief 写入一帧。
+         * @param action_states 各动作状态，顺序与 open() 时的动作名一致。
+         * @param mouse_moved 本帧鼠标是否移动。
+         * @param mouse_position 鼠标位置（窗口坐标）。
+         */
+        void writeFrame(const std::vector<ActionState>& action_states, bool mouse_moved, const glm::vec2& mouse_position);
+
+        /// 关闭文件
+        void close();
+
+        bool isOpen() const { return file_.is_open(); }      ///< @brief 是否正在录制
+        size_t getFrameCount() const { return frame_count_; } ///< @brief 已写入的帧数
+    };
+
+    /**
+     * @class InputReplayer
+     * @brief 读取 InputRecorder 生成的文件并逐帧返回动作状态。
+     *
+     * 文件在打开时整体读入内存，回放过程中不再访问磁盘。
+     */
+    class InputReplayer final {
+    private:
+        std::vector<std::uint8_t> data_;
+        size_t cursor_ = 0;
+        size_t frame_count_ = 0;
+        std::vector<std::string> action_names_;
+        InputRecordingInfo info_;
+
+    public:
+        InputReplayer() = default;
+
+        InputReplayer(const InputReplayer&) = delete;
+        InputReplayer& operator=(const InputReplayer&) = delete;
+        InputReplayer(InputReplayer&&) = delete;
+        InputReplayer& operator=(InputReplayer&&) = delete;
+
+        /**
+         * @brief 读取录制文件并解析文件头。
+         * @param path 文件路径。
+         * @return 成功返回 true；文件不存在或格式错误时返回 false。
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief 读取下一帧。
+         * @param out_states 输出各动作状态，顺序与 getActionNames() 一致。
+         * @param out_mouse_moved 输出本帧鼠标是否移动。
+         * @param out_mouse_position 鼠标移动时输出其位置。
+         * @return 没有剩余帧或数据截断时返回 false。
+         */
+        bool readFrame(std::vector<ActionState>& out_states, bool& out_mouse_moved, glm::vec2& out_mouse_position);
+
+        const std::vector<std::string>& getActionNames() const { return action_names_; } ///< @brief 文件中的动作名
+        const InputRecordingInfo& getInfo() const { return info_; }                      ///< @brief 会话参数
+        size_t getFrameCount() const { return frame_count_; }                             ///< @brief 已读取的帧数
+    };
+
+} // namespace engine::input
@@ -34,9 +34,9 @@ namespace engine::object {
      * @param context 游戏核心上下文
      */
     void GameObject::update(float delta_time, engine::core::Context& context) {
-        // 遍历所有组件并调用它们的 update 方法
-        for (auto& pair : components_) {
-            pair.second->update(delta_time,context);
+        // 按添加顺序遍历所有组件并调用它们的 update 方法
+        for (auto* component : component_order_) {
+            component->update(delta_time,context);
         }
     }
 
@@ -46,8 +46,8 @@ namespace engine::object {
      */
     void GameObject::render(engine::core::Context& context) {
         // 遍历所有组件并调用它们的 render 方法
-        for (auto& pair : components_) {
-            pair.second->render(context);
+        for (auto* component : component_order_) {
+            component->render(context);
         }
     }
 
@@ -57,9 +57,10 @@ namespace engine::object {
     void GameObject::clean() {
         spdlog::trace("Cleaning GameObject: {}", name_);
         // 遍历所有组件并调用它们的 clean 方法
-        for (auto& pair : components_) {
-            pair.second->clean();
+        for (auto* component : component_order_) {
+            component->clean();
         }
+        component_order_.clear();
         components_.clear(); // 清空 map, unique_ptr 会自动释放内存
     }
 
@@ -69,8 +70,8 @@ namespace engine::object {
      */
     void GameObject::handleInput(engine::core::Context& context) {
         // 遍历所有组件并调用它们的 handleInput 方法
-        for (auto& pair : components_) {
-            pair.second->handleInput(context);
+        for (auto* component : component_order_) {
+            component->handleInput(context);
         }
     }
 
@@ -4,8 +4,11 @@
 #include <unordered_map>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 #include "../component/component.h" // 必须包含定义以支持模板方法中的 is_base_of 和函数调用
+#include "../render/render_order.h"
 
 namespace engine::core
 {
@@ -23,8 +26,11 @@ namespace engine::object
 		std::string tag_;  ///< 对象的标签，用于分类和查询
 		/** @brief 组件映射表，按类型索引存储组件 */
 		std::unordered_map<std::type_index, std::unique_ptr<engine::component::Component>> components_;
+		/** @brief 按添加顺序排列的组件，各更新循环按此顺序遍历（哈希表的遍历顺序与实现有关，不能用于需要复现的逻辑） */
+		std::vector<engine::component::Component*> component_order_;
 
 		bool need_remove_ = false; ///< 标记对象是否在下一帧需要被从场景中移除
+		std::uint8_t render_layer_ = engine::render::render_layer::DEFAULT; ///< 渲染层，组件提交绘制命令时使用
 	public:
 		/**
 		 * @brief 构造函数。
@@ -67,6 +73,11 @@ namespace engine::object
 		/** @brief 检查对象是否已被标记为移除 */
 		bool getNeedRemove() const { return need_remove_; }
 
+		/** @brief 获取渲染层 */
+		std::uint8_t getRenderLayer() const { return render_layer_; }
+		/** @brief 设置渲染层（关卡加载器按 Tiled 图层顺序设置） */
+		void setRenderLayer(std::uint8_t layer) { render_layer_ = layer; }
+
 		/**
 		 * @brief 为游戏对象动态添加组件。
 		 */
@@ -81,6 +92,7 @@ namespace engine::object
 		auto new_component = std::make_unique<T>(std::forward<Args>(args)...);
 		T* raw_ptr = new_component.get();
 		components_[type_index] = std::unique_ptr<engine::component::Component>(new_component.release());
+		component_order_.push_back(raw_ptr);
 			// 这里需要 Component 的完整定义
 			raw_ptr->setOwner(this);
 			raw_ptr->init();
@@ -119,6 +131,7 @@ namespace engine::object
 			auto type_index = std::type_index(typeid(T));
 			if (auto it = components_.find(type_index); it != components_.end()) {
 				it->second->clean();
+				component_order_.erase(std::remove(component_order_.begin(), component_order_.end(), it->second.get()), component_order_.end());
 				components_.erase(it);
 			}
 		}
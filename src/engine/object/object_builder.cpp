@@ -16,6 +16,7 @@
 #include "../resource/resource_manager.h"
 #include "../core/context.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace engine::object {
@@ -125,7 +126,7 @@ namespace engine::object {
     void ObjectBuilder::buildSprite() {
         if (!game_object_ || !tile_json_) return;
         
-        if (tile_info_.sprite.getTextureId().empty()) {
+        if (!tile_info_.sprite.getTextureHandle().isValid()) {
             spdlog::warn("ObjectBuilder: 对象 '{}' 没有图像纹理", name_);
             return;
         }
@@ -137,11 +138,17 @@ namespace engine::object {
             return;
         }
         
-        engine::render::Sprite sprite(tile_info_.sprite.getTextureId(), *src_rect_opt);
-        game_object_->addComponent<engine::component::SpriteComponent>(
+        engine::render::Sprite sprite(tile_info_.sprite.getTextureHandle(), *src_rect_opt);
+        auto* sprite_component = game_object_->addComponent<engine::component::SpriteComponent>(
             std::move(sprite), 
             context_.getResourceManager()
         );
+        // 对象的自定义属性 "z" 优先于瓦片属性，决定同一图层内的前后顺序
+        auto z_order = object_json_ ? getTileProperty<int>(*object_json_, "z") : std::nullopt;
+        if (!z_order) z_order = getTileProperty<int>(*tile_json_, "z");
+        if (z_order) {
+            sprite_component->setZOrder(static_cast<std::int16_t>(std::clamp(*z_order, -32768, 32767)));
+        }
     }
 
     void ObjectBuilder::buildPhysics() {
@@ -159,6 +166,8 @@ namespace engine::object {
             if (auto tag = getTileProperty<std::string>(*object_json_, "tag"); tag) {
                 game_object_->setTag(tag.value());
             }
+            applyCollisionFilter(game_object_.get());
+            applyKinematicPath();
             return;
         }
 
@@ -210,11 +219,58 @@ namespace engine::object {
         if (has_physics && !game_object_->getComponent<engine::component::PhysicsComponent>()) {
             game_object_->addComponent<engine::component::PhysicsComponent>(&context_.getPhysicsEngine(), false);
         }
+
+        applyCollisionFilter(game_object_.get());
+
+        // 处理连续碰撞检测属性（高速物体防穿透）
+        if (auto ccd = getTileProperty<bool>(*tile_json_, "ccd"); ccd) {
+            if (auto* pc = game_object_->getComponent<engine::component::PhysicsComponent>()) {
+                pc->setCCDEnabled(ccd.value());
+            }
+        }
+
+        applyKinematicPath();
+    }
+
+    void ObjectBuilder::applyKinematicPath() {
+        // 移动平台：在 Tiled 中为对象设置路径偏移与速率，对象变为运动学刚体
+        if (!game_object_ || !object_json_) return;
+        const glm::vec2 path_offset(getTileProperty<float>(*object_json_, "path_dx").value_or(0.0f),
+            getTileProperty<float>(*object_json_, "path_dy").value_or(0.0f));
+        if (path_offset == glm::vec2(0.0f)) return;
+
+        auto* pc = game_object_->getComponent<engine::component::PhysicsComponent>();
+        auto* tc = game_object_->getComponent<engine::component::TransformComponent>();
+        if (!pc || !tc) {
+            spdlog::warn("ObjectBuilder: 对象 '{}' 设置了路径但没有碰撞体，忽略", name_);
+            return;
+        }
+        const glm::vec2 start = tc->getPosition();
+        const float speed = getTileProperty<float>(*object_json_, "path_speed").value_or(32.0f);
+        const bool loop = getTileProperty<bool>(*object_json_, "path_loop").value_or(false);
+        pc->setKinematicPath({ start, start + path_offset }, speed, loop);
+    }
+
+    void ObjectBuilder::applyCollisionFilter(engine::object::GameObject* game_object) {
+        // 按最终标签设置碰撞层与掩码，物理引擎与场景逻辑据此过滤和分发，不再比较字符串
+        if (!game_object) return;
+        if (auto* collider = game_object->getComponent<engine::component::ColliderComponent>()) {
+            collider->setCollisionFilter(engine::physics::collisionFilterFromTag(game_object->getTag()));
+        }
     }
 
     void ObjectBuilder::buildAnimation() {
         if (!game_object_ || !tile_json_) return;
 
+        // 预编译关卡：动画已解析为表
+        if (const auto* baked_tile = level_loader_.findBakedTile(*tile_json_); baked_tile) {
+            if (baked_tile->flags & engine::scene::level_binary::TILE_HAS_ANIMATION) {
+                auto* ac = game_object_->addComponent<engine::component::AnimationComponent>();
+                level_loader_.addBakedAnimations(*baked_tile, ac, src_size_);
+            }
+            return;
+        }
+
         auto anim_string = getTileProperty<std::string>(*tile_json_, "animation");
         if (!anim_string) return;
 
@@ -235,6 +291,14 @@ namespace engine::object {
     void ObjectBuilder::buildAudio() {
         if (!game_object_ || !tile_json_) return;
 
+        if (const auto* baked_tile = level_loader_.findBakedTile(*tile_json_); baked_tile) {
+            if (baked_tile->flags & engine::scene::level_binary::TILE_HAS_SOUND) {
+                auto* audio = game_object_->addComponent<engine::component::AudioComponent>();
+                level_loader_.addBakedSounds(*baked_tile, audio);
+            }
+            return;
+        }
+
         auto sound_string = getTileProperty<std::string>(*tile_json_, "sound");
         if (!sound_string) return;
 
@@ -164,6 +164,19 @@ namespace engine::object {
          */
         virtual void buildPhysics();
 
+        /**
+         * @brief 根据对象当前标签设置其碰撞体的碰撞层与掩码
+         * @param game_object 目标对象（没有碰撞体时忽略）
+         * @details 修改标签后需要重新调用，例如派生构建器覆盖了标签时
+         */
+        static void applyCollisionFilter(engine::object::GameObject* game_object);
+
+        /**
+         * @brief 根据对象属性 path_dx / path_dy / path_speed / path_loop 设置运动学平台路径
+         * @details 路径从对象初始位置出发，到 (path_dx, path_dy) 偏移处；未设置偏移时不做处理
+         */
+        void applyKinematicPath();
+
         /**
          * @brief 构建动画组件
          * @details 解析动画JSON配置
@@ -0,0 +1,146 @@
+#include "body_storage.h"
+#include <algorithm>
+
+namespace engine::physics {
+
+namespace {
+	/// 用末尾元素覆盖被删除的元素再弹出末尾，O(1)
+	template<typename T>
+	void swapRemove(std::vector<T>& values, size_t index) {
+		if (index + 1 != values.size()) {
+			values[index] = std::move(values.back());
+		}
+		values.pop_back();
+	}
+}
+
+/**
+ * @brief 为物理组件分配刚体
+ *
+ * @param component 物理组件
+ * @param owner 所属游戏对象
+ * @param transform 变换组件
+ * @return 新刚体的句柄
+ * @details 优先复用已释放的槽位（其代数在释放时已递增），刚体数据追加到各数组末尾。
+ */
+BodyHandle BodyStorage::create(engine::component::PhysicsComponent* component,
+	engine::object::GameObject* owner,
+	engine::component::TransformComponent* transform)
+{
+	std::uint32_t slot_index = 0;
+	if (!free_slots_.empty()) {
+		slot_index = free_slots_.back();
+		free_slots_.pop_back();
+	}
+	else {
+		slot_index = static_cast<std::uint32_t>(slots_.size());
+		slots_.push_back({});
+	}
+
+	const auto dense = static_cast<std::uint32_t>(arrays_.size());
+	slots_[slot_index].dense = dense;
+	dense_to_slot_.push_back(slot_index);
+
+	arrays_.component.push_back(component);
+	arrays_.owner.push_back(owner);
+	arrays_.transform.push_back(transform);
+	arrays_.collider.push_back(nullptr);
+	arrays_.flags.push_back(0);
+	arrays_.position.emplace_back(0.0f, 0.0f);
+	arrays_.aabb_offset.emplace_back(0.0f, 0.0f);
+	arrays_.aabb_size.emplace_back(0.0f, 0.0f);
+	arrays_.velocity.emplace_back(0.0f, 0.0f);
+	arrays_.force.emplace_back(0.0f, 0.0f);
+	arrays_.inverse_mass.push_back(0.0f);
+	arrays_.gravity_scale.push_back(0.0f);
+	arrays_.displacement.emplace_back(0.0f, 0.0f);
+
+	return BodyHandle{ slot_index, slots_[slot_index].generation };
+}
+
+/**
+ * @brief 删除刚体
+ *
+ * @param handle 刚体句柄
+ * @return 删除成功返回 true
+ * @details 末尾的刚体移入被删除的位置（swap-and-pop），只需修正它所在槽位的紧凑下标；
+ *          槽位代数递增后放入空闲列表。遍历顺序因此只取决于注册与删除的先后，同样的操作序列得到同样的顺序。
+ */
+bool BodyStorage::destroy(BodyHandle handle)
+{
+	if (!isValid(handle)) return false;
+
+	const auto dense = slots_[handle.index].dense;
+	swapRemove(arrays_.component, dense);
+	swapRemove(arrays_.owner, dense);
+	swapRemove(arrays_.transform, dense);
+	swapRemove(arrays_.collider, dense);
+	swapRemove(arrays_.flags, dense);
+	swapRemove(arrays_.position, dense);
+	swapRemove(arrays_.aabb_offset, dense);
+	swapRemove(arrays_.aabb_size, dense);
+	swapRemove(arrays_.velocity, dense);
+	swapRemove(arrays_.force, dense);
+	swapRemove(arrays_.inverse_mass, dense);
+	swapRemove(arrays_.gravity_scale, dense);
+	swapRemove(arrays_.displacement, dense);
+	swapRemove(dense_to_slot_, dense);
+
+	// 被移入的刚体（若有）换了紧凑下标
+	if (dense < dense_to_slot_.size()) {
+		slots_[dense_to_slot_[dense]].dense = dense;
+	}
+
+	auto& slot = slots_[handle.index];
+	slot.dense = BodyHandle::INVALID_INDEX;
+	++slot.generation;
+	free_slots_.push_back(handle.index);
+	return true;
+}
+
+/**
+ * @brief 判断句柄是否有效
+ */
+bool BodyStorage::isValid(BodyHandle handle) const
+{
+	return handle.index < slots_.size() &&
+		slots_[handle.index].generation == handle.generation &&
+		slots_[handle.index].dense != BodyHandle::INVALID_INDEX;
+}
+
+/**
+ * @brief 获取句柄对应的紧凑下标
+ */
+std::uint32_t BodyStorage::indexOf(BodyHandle handle) const
+{
+	return isValid(handle) ? slots_[handle.index].dense : BodyHandle::INVALID_INDEX;
+}
+
+/**
+ * @brief 积分所有刚体的速度
+ *
+ * @param arrays 刚体数据
+ * @param gravity 重力加速度
+ * @param max_speed 各轴速度上限
+ * @param dt 时间步长
+ * @param begin 起始紧凑下标
+ * @param end 结束紧凑下标（不含）
+ */
+void integrateBodies(BodyArrays& arrays, const glm::vec2& gravity, float max_speed, float dt, size_t begin, size_t end)
+{
+	const size_t count = std::min(end, arrays.size());
+	glm::vec2* velocity = arrays.velocity.data();
+	const glm::vec2* force = arrays.force.data();
+	const float* inverse_mass = arrays.inverse_mass.data();
+	const float* gravity_scale = arrays.gravity_scale.data();
+
+	for (size_t i = begin; i < count; ++i) {
+		// a = F / m + g，外力与重力分开存放，避免每步把 g * m 累加进外力
+		const float ax = force[i].x * inverse_mass[i] + gravity.x * gravity_scale[i];
+		const float ay = force[i].y * inverse_mass[i] + gravity.y * gravity_scale[i];
+		velocity[i].x = std::clamp(velocity[i].x + ax * dt, -max_speed, max_speed);
+		velocity[i].y = std::clamp(velocity[i].y + ay * dt, -max_speed, max_speed);
+	}
+}
+
+} // namespace engine::physics
@@ -0,0 +1,158 @@
+#pragma once
+/**
+ * @file body_storage.h
+ * @brief 定义物理刚体的结构数组（SoA）存储与代际句柄。
+ *
+ * 物理引擎每步需要遍历所有刚体做积分、瓦片解析和触发器检测。
+ * 把热数据按字段拆成连续数组后，这些循环只需顺序访问内存，
+ * 积分循环也不再包含分支，便于编译器自动向量化。
+ */
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace engine {
+	namespace object {
+		class GameObject;
+	}
+	namespace component {
+		class PhysicsComponent;
+		class TransformComponent;
+		class ColliderComponent;
+	}
+}
+
+namespace engine::physics {
+
+	/**
+	 * @struct BodyHandle
+	 * @brief 刚体的代际句柄。
+	 *
+	 * index 指向稳定的槽位，generation 在槽位被回收时递增，
+	 * 因此已注销刚体的旧句柄不会误指向复用该槽位的新刚体。
+	 */
+	struct BodyHandle {
+		static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		std::uint32_t index = INVALID_INDEX; ///< 槽位下标
+		std::uint32_t generation = 0;        ///< 槽位代数
+
+		bool isValid() const { return index != INVALID_INDEX; }
+		bool operator==(const BodyHandle&) const = default;
+	};
+
+	/// 刚体每步的状态标志
+	namespace body_flag {
+		inline constexpr std::uint8_t ENABLED = 1u << 0;   ///< 物理组件启用
+		inline constexpr std::uint8_t SIMULATE = 1u << 1;  ///< 本步参与积分与瓦片解析（启用、未休眠、质量有效）
+		inline constexpr std::uint8_t SLEEPING = 1u << 2;  ///< 处于休眠状态
+		inline constexpr std::uint8_t COLLIDER = 1u << 3;  ///< 拥有启用的碰撞体
+		inline constexpr std::uint8_t TRIGGER = 1u << 4;   ///< 碰撞体为触发器
+		inline constexpr std::uint8_t KINEMATIC = 1u << 5; ///< 运动学刚体：按脚本速度或路径移动，不受力与碰撞影响
+	}
+
+	/**
+	 * @struct BodyArrays
+	 * @brief 按字段拆分的刚体数据，所有数组长度一致，下标即刚体的紧凑下标。
+	 */
+	struct BodyArrays {
+		// 冷数据：组件指针在注册时缓存，避免每步通过 GameObject 做哈希查找
+		std::vector<engine::component::PhysicsComponent*> component;
+		std::vector<engine::object::GameObject*> owner;
+		std::vector<engine::component::TransformComponent*> transform;
+		std::vector<engine::component::ColliderComponent*> collider;
+
+		// 热数据：每步开始时收集，积分与碰撞解析只读写这些连续数组
+		std::vector<std::uint8_t> flags;          ///< body_flag 组合
+		std::vector<glm::vec2> position;          ///< 碰撞盒左上角（世界坐标）
+		std::vector<glm::vec2> aabb_offset;       ///< 碰撞盒相对 Transform 位置的偏移
+		std::vector<glm::vec2> aabb_size;         ///< 碰撞盒尺寸（已含缩放）
+		std::vector<glm::vec2> velocity;          ///< 速度
+		std::vector<glm::vec2> force;             ///< 本步外力（不含重力）
+		std::vector<float> inverse_mass;          ///< 质量倒数，不参与模拟的刚体为 0
+		std::vector<float> gravity_scale;         ///< 受重力影响为 1，否则为 0
+		std::vector<glm::vec2> displacement;      ///< 本步的外加位移：运动学刚体为自身位移，其余刚体为被平台携带的位移
+
+		size_t size() const { return component.size(); }
+	};
+
+	/**
+	 * @class BodyStorage
+	 * @brief 管理 BodyArrays 与代际句柄之间的映射。
+	 *
+	 * 新刚体追加到末尾；删除时把末尾的刚体移入空位，只修正它的槽位，删除为 O(1)。
+	 * 紧凑下标顺序在删除后不再等于注册顺序，但只由注册与删除的先后决定，确定性模式下可复现。
+	 */
+	class BodyStorage final {
+	private:
+		/// 槽位：记录紧凑下标与代数
+		struct Slot {
+			std::uint32_t dense = BodyHandle::INVALID_INDEX;
+			std::uint32_t generation = 0;
+		};
+
+		BodyArrays arrays_;                        ///< 刚体数据
+		std::vector<Slot> slots_;                  ///< 槽位表（句柄 -> 紧凑下标）
+		std::vector<std::uint32_t> dense_to_slot_; ///< 紧凑下标 -> 槽位
+		std::vector<std::uint32_t> free_slots_;    ///< 可复用的槽位
+
+	public:
+		BodyStorage() = default;
+
+		BodyStorage(const BodyStorage&) = delete;
+		BodyStorage& operator=(const BodyStorage&) = delete;
+		BodyStorage(BodyStorage&&) = delete;
+		BodyStorage& operator=(BodyStorage&&) = delete;
+
+		/**
+		 * @brief 为物理组件分配一个刚体。
+		 * @param component 物理组件。
+		 * @param owner 所属游戏对象。
+		 * @param transform 变换组件。
+		 * @return 新刚体的句柄。
+		 */
+		BodyHandle create(engine::component::PhysicsComponent* component,
+			engine::object::GameObject* owner,
+			engine::component::TransformComponent* transform);
+
+		/**
+		 * @brief 删除句柄对应的刚体。
+		 * @return 句柄有效并删除成功返回 true。
+		 */
+		bool destroy(BodyHandle handle);
+
+		/// 句柄是否仍指向存活的刚体
+		bool isValid(BodyHandle handle) const;
+
+		/**
+		 * @brief 获取句柄对应的紧凑下标。
+		 * @return 无效句柄返回 BodyHandle::INVALID_INDEX。
+		 */
+		std::uint32_t indexOf(BodyHandle handle) const;
+
+		BodyArrays& arrays() { return arrays_; }
+		const BodyArrays& arrays() const { return arrays_; }
+		size_t size() const { return arrays_.size(); }
+		bool empty() const { return arrays_.size() == 0; }
+	};
+
+	/**
+	 * @brief 对所有刚体做一次半隐式欧拉积分：v = clamp(v + (F / m + g) * dt)。
+	 * @param arrays 刚体数据。
+	 * @param gravity 重力加速度。
+	 * @param max_speed 各轴速度上限。
+	 * @param dt 时间步长。
+	 * @param begin 起始紧凑下标。
+	 * @param end 结束紧凑下标（不含），各刚体互不依赖，可按区间分给多个线程。
+	 * @details 循环体没有分支：不参与模拟的刚体其 inverse_mass 与 gravity_scale 为 0，
+	 *          计算结果也不会被写回组件，因此可以整体交给编译器向量化。
+	 */
+	void integrateBodies(BodyArrays& arrays, const glm::vec2& gravity, float max_speed, float dt, size_t begin, size_t end);
+
+	/// 积分全部刚体
+	inline void integrateBodies(BodyArrays& arrays, const glm::vec2& gravity, float max_speed, float dt) {
+		integrateBodies(arrays, gravity, max_speed, dt, 0, arrays.size());
+	}
+
+} // namespace engine::physics
@@ -0,0 +1,300 @@
+#include "broadphase.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+std::optional<BroadphaseMode> parseBroadphaseMode(std::string_view name)
+{
+	if (name == "brute_force" || name == "brute") return BroadphaseMode::BRUTE_FORCE;
+	if (name == "spatial_hash" || name == "grid") return BroadphaseMode::SPATIAL_HASH;
+	if (name == "sweep_and_prune" || name == "sap") return BroadphaseMode::SWEEP_AND_PRUNE;
+	return std::nullopt;
+}
+
+const char* toString(BroadphaseMode mode)
+{
+	switch (mode) {
+	case BroadphaseMode::BRUTE_FORCE: return "brute_force";
+	case BroadphaseMode::SPATIAL_HASH: return "spatial_hash";
+	case BroadphaseMode::SWEEP_AND_PRUNE: return "sweep_and_prune";
+	}
+	return "unknown";
+}
+
+SpatialHashGrid::SpatialHashGrid(float cell_size)
+	: cell_size_(cell_size > 0.0f ? cell_size : 64.0f)
+{
+}
+
+/**
+ * @brief 设置网格单元边长
+ *
+ * @param cell_size 单元边长，通常取常见物体尺寸的 1~2 倍
+ */
+void SpatialHashGrid::setCellSize(float cell_size)
+{
+	if (cell_size <= 0.0f) {
+		spdlog::warn("SpatialHashGrid: 无效的网格尺寸 {}，保持 {}", cell_size, cell_size_);
+		return;
+	}
+	cell_size_ = cell_size;
+	cells_.clear();
+	used_keys_.clear();
+}
+
+/**
+ * @brief 将格子坐标打包为 64 位哈希键
+ */
+std::uint64_t SpatialHashGrid::makeKey(int cell_x, int cell_y)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_x)) << 32) |
+		static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_y));
+}
+
+/**
+ * @brief 重建网格
+ *
+ * @param proxies 要索引的代理数组
+ * @details 每个代理写入其 AABB 覆盖的所有格子（边缘接触也算覆盖，与 checkAABBOverlap 保持一致），
+ *          覆盖格子过多的代理单独记录为超大代理。格子容器在帧间复用，只清空内容不释放内存。
+ */
+void SpatialHashGrid::build(const std::vector<BroadphaseProxy>& proxies)
+{
+	for (auto key : used_keys_) {
+		cells_[key].clear();
+	}
+	used_keys_.clear();
+	oversized_.clear();
+
+	// 长时间运行后访问过的格子可能很多，超过阈值时整体回收
+	if (cells_.size() > proxies.size() * 16 + 1024) {
+		cells_.clear();
+	}
+
+	const float inv_cell = 1.0f / cell_size_;
+	cell_min_.resize(proxies.size());
+	cell_max_.resize(proxies.size());
+
+	for (std::uint32_t i = 0; i < proxies.size(); ++i) {
+		const auto& proxy = proxies[i];
+		cell_min_[i] = { static_cast<int>(std::floor(proxy.min.x * inv_cell)), static_cast<int>(std::floor(proxy.min.y * inv_cell)) };
+		cell_max_[i] = { static_cast<int>(std::floor(proxy.max.x * inv_cell)), static_cast<int>(std::floor(proxy.max.y * inv_cell)) };
+
+		const long long span = static_cast<long long>(cell_max_[i].x - cell_min_[i].x + 1) *
+			static_cast<long long>(cell_max_[i].y - cell_min_[i].y + 1);
+		if (span > max_cells_per_proxy_) {
+			oversized_.push_back(i);
+			continue;
+		}
+
+		for (int cy = cell_min_[i].y; cy <= cell_max_[i].y; ++cy) {
+			for (int cx = cell_min_[i].x; cx <= cell_max_[i].x; ++cx) {
+				const auto key = makeKey(cx, cy);
+				auto& cell = cells_[key];
+				if (cell.empty()) used_keys_.push_back(key);
+				cell.push_back(i);
+			}
+		}
+	}
+}
+
+/**
+ * @brief 查询与区域相交的代理
+ *
+ * @param proxies build() 时使用的代理数组
+ * @param min 查询区域左上角
+ * @param max 查询区域右下角
+ * @param layer_mask 层掩码
+ * @param out_indices 输出代理下标
+ * @details 只遍历区域覆盖的格子；区域覆盖的格子数多于非空格子数时改为遍历非空格子。超大代理总是逐个比较。
+ */
+void SpatialHashGrid::query(const std::vector<BroadphaseProxy>& proxies, const glm::vec2& min, const glm::vec2& max,
+	std::uint32_t layer_mask, std::vector<std::uint32_t>& out_indices) const
+{
+	out_indices.clear();
+	const auto accept = [&](std::uint32_t i) {
+		const auto& proxy = proxies[i];
+		return (proxy.layer & layer_mask) != 0u &&
+			!(proxy.max.x < min.x || max.x < proxy.min.x || proxy.max.y < min.y || max.y < proxy.min.y);
+	};
+
+	const float inv_cell = 1.0f / cell_size_;
+	const glm::ivec2 query_min{ static_cast<int>(std::floor(min.x * inv_cell)), static_cast<int>(std::floor(min.y * inv_cell)) };
+	const glm::ivec2 query_max{ static_cast<int>(std::floor(max.x * inv_cell)), static_cast<int>(std::floor(max.y * inv_cell)) };
+	const long long span = static_cast<long long>(query_max.x - query_min.x + 1) * static_cast<long long>(query_max.y - query_min.y + 1);
+
+	if (span > static_cast<long long>(used_keys_.size())) {
+		// 查询区域比非空格子还多时，直接遍历非空格子更快
+		for (auto key : used_keys_) {
+			for (auto i : cells_.at(key)) {
+				if (accept(i)) out_indices.push_back(i);
+			}
+		}
+	}
+	else {
+		for (int cy = query_min.y; cy <= query_max.y; ++cy) {
+			for (int cx = query_min.x; cx <= query_max.x; ++cx) {
+				const auto it = cells_.find(makeKey(cx, cy));
+				if (it == cells_.end()) continue;
+				for (auto i : it->second) {
+					if (accept(i)) out_indices.push_back(i);
+				}
+			}
+		}
+	}
+	for (auto i : oversized_) {
+		if (accept(i)) out_indices.push_back(i);
+	}
+
+	std::sort(out_indices.begin(), out_indices.end());
+	out_indices.erase(std::unique(out_indices.begin(), out_indices.end()), out_indices.end());
+}
+
+/**
+ * @brief 重建网格并输出候选对
+ *
+ * @param proxies 本帧的代理数组
+ * @param out_pairs 输出的候选对
+ * @details 同一对代理可能共享多个格子，只在"两者最小格坐标的最大值"那一格输出一次，从而无需额外去重。
+ */
+void SpatialHashGrid::findPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& out_pairs)
+{
+	out_pairs.clear();
+	build(proxies);
+
+	// 同格配对
+	for (auto key : used_keys_) {
+		const auto& cell = cells_[key];
+		const int cx = static_cast<int>(static_cast<std::uint32_t>(key >> 32));
+		const int cy = static_cast<int>(static_cast<std::uint32_t>(key & 0xFFFFFFFFu));
+		for (size_t a = 0; a < cell.size(); ++a) {
+			for (size_t b = a + 1; b < cell.size(); ++b) {
+				const auto i = cell[a];
+				const auto j = cell[b];
+				// 只在共享区域的左上角格子输出
+				if (std::max(cell_min_[i].x, cell_min_[j].x) != cx || std::max(cell_min_[i].y, cell_min_[j].y) != cy) continue;
+				if (!canCollide(proxies[i], proxies[j])) continue;
+				if (proxies[i].max.x < proxies[j].min.x || proxies[j].max.x < proxies[i].min.x ||
+					proxies[i].max.y < proxies[j].min.y || proxies[j].max.y < proxies[i].min.y) continue;
+				out_pairs.emplace_back(std::min(i, j), std::max(i, j));
+			}
+		}
+	}
+
+	// 超大代理与所有代理逐一比较
+	for (size_t a = 0; a < oversized_.size(); ++a) {
+		const auto i = oversized_[a];
+		for (std::uint32_t j = 0; j < proxies.size(); ++j) {
+			if (j == i) continue;
+			// 两个超大代理之间只输出一次
+			const bool j_oversized = std::binary_search(oversized_.begin(), oversized_.end(), j);
+			if (j_oversized && j < i) continue;
+			if (!canCollide(proxies[i], proxies[j])) continue;
+			if (proxies[i].max.x < proxies[j].min.x || proxies[j].max.x < proxies[i].min.x ||
+				proxies[i].max.y < proxies[j].min.y || proxies[j].max.y < proxies[i].min.y) continue;
+			out_pairs.emplace_back(std::min(i, j), std::max(i, j));
+		}
+	}
+
+	// 保持与暴力遍历相同的处理顺序，保证结果可复现
+	std::sort(out_pairs.begin(), out_pairs.end());
+}
+
+/**
+ * @brief 同步端点列表与本帧代理
+ *
+ * @param proxies 本帧的代理数组
+ * @details 已存在的物体只更新端点坐标和代理下标（保持原有顺序，供插入排序利用），
+ *          不再参与的物体被移除，新物体的端点追加到末尾。
+ */
+void SweepAndPrune::syncEndpoints(const std::vector<BroadphaseProxy>& proxies)
+{
+	proxy_lookup_.clear();
+	for (std::uint32_t i = 0; i < proxies.size(); ++i) {
+		proxy_lookup_[proxies[i].physics] = i;
+	}
+	seen_.assign(proxies.size(), 0);
+
+	size_t write = 0;
+	for (size_t read = 0; read < endpoints_.size(); ++read) {
+		auto endpoint = endpoints_[read];
+		auto it = proxy_lookup_.find(endpoint.body);
+		if (it == proxy_lookup_.end()) continue;
+		endpoint.proxy = it->second;
+		endpoint.value = endpoint.is_min ? proxies[it->second].min.x : proxies[it->second].max.x;
+		seen_[it->second] = 1;
+		endpoints_[write++] = endpoint;
+	}
+	endpoints_.resize(write);
+
+	for (std::uint32_t i = 0; i < proxies.size(); ++i) {
+		if (seen_[i]) continue;
+		endpoints_.push_back({ proxies[i].min.x, proxies[i].physics, i, true });
+		endpoints_.push_back({ proxies[i].max.x, proxies[i].physics, i, false });
+	}
+}
+
+/**
+ * @brief 对端点列表做插入排序
+ *
+ * @details 坐标相同时左端点排在右端点之前，保证边缘接触的物体也能成为候选对（与 checkAABBOverlap 一致）。
+ */
+void SweepAndPrune::insertionSort()
+{
+	auto less = [](const Endpoint& a, const Endpoint& b) {
+		if (a.value != b.value) return a.value < b.value;
+		return a.is_min && !b.is_min;
+	};
+	for (size_t i = 1; i < endpoints_.size(); ++i) {
+		const auto key = endpoints_[i];
+		size_t j = i;
+		while (j > 0 && less(key, endpoints_[j - 1])) {
+			endpoints_[j] = endpoints_[j - 1];
+			--j;
+		}
+		endpoints_[j] = key;
+	}
+}
+
+/**
+ * @brief 更新端点并扫描输出候选对
+ *
+ * @param proxies 本帧的代理数组
+ * @param out_pairs 输出的候选对
+ * @details 从左到右扫描端点：遇到左端点时与所有活动代理比较 Y 轴区间，再加入活动集合；遇到右端点时移出。
+ */
+void SweepAndPrune::findPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& out_pairs)
+{
+	out_pairs.clear();
+	syncEndpoints(proxies);
+	insertionSort();
+
+	active_.clear();
+	active_slot_.assign(proxies.size(), 0);
+	for (const auto& endpoint : endpoints_) {
+		const auto i = endpoint.proxy;
+		if (endpoint.is_min) {
+			for (auto j : active_) {
+				if (proxies[i].max.y < proxies[j].min.y || proxies[j].max.y < proxies[i].min.y) continue;
+				if (!canCollide(proxies[i], proxies[j])) continue;
+				out_pairs.emplace_back(std::min(i, j), std::max(i, j));
+			}
+			active_slot_[i] = static_cast<std::uint32_t>(active_.size());
+			active_.push_back(i);
+		}
+		else {
+			const auto slot = active_slot_[i];
+			const auto last = active_.back();
+			active_[slot] = last;
+			active_slot_[last] = slot;
+			active_.pop_back();
+		}
+	}
+
+	// 保持与暴力遍历相同的处理顺序，保证结果可复现
+	std::sort(out_pairs.begin(), out_pairs.end());
+}
+
+} // namespace engine::physics
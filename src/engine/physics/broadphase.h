@@ -0,0 +1,180 @@
+#pragma once
+/**
+ * @file broadphase.h
+ * @brief 定义碰撞检测的粗检测（Broadphase）阶段所需的数据结构与算法。
+ *
+ * 粗检测只根据世界 AABB 筛选出"可能相交"的候选对，
+ * 真正的相交判断（窄检测）仍由 collision::checkCollision 完成。
+ */
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <glm/vec2.hpp>
+#include "collision_layers.h"
+
+namespace engine {
+	namespace object {
+		class GameObject;
+	}
+	namespace component {
+		class PhysicsComponent;
+		class ColliderComponent;
+	}
+}
+
+namespace engine::physics {
+
+	/**
+	 * @enum BroadphaseMode
+	 * @brief 粗检测策略。
+	 */
+	enum class BroadphaseMode {
+		BRUTE_FORCE,  ///< 两两比较，O(n²)，作为正确性基准
+		SPATIAL_HASH, ///< 均匀网格（空间哈希），适合分布较均匀的关卡
+		SWEEP_AND_PRUNE, ///< X 轴排序扫描，适合横向狭长的关卡
+	};
+
+	/**
+	 * @brief 将字符串解析为粗检测策略（用于配置与关卡属性）。
+	 * @param name "brute_force" / "spatial_hash" / "sweep_and_prune"（亦接受 "brute" / "grid" / "sap"）。
+	 * @return 解析成功返回对应策略，否则返回 std::nullopt。
+	 */
+	std::optional<BroadphaseMode> parseBroadphaseMode(std::string_view name);
+
+	/**
+	 * @brief 获取粗检测策略的名称，用于日志输出。
+	 */
+	const char* toString(BroadphaseMode mode);
+
+	/**
+	 * @struct BroadphaseProxy
+	 * @brief 参与粗检测的物体代理，每帧由物理引擎根据碰撞体的世界 AABB 生成。
+	 *
+	 * 缓存组件指针，避免在配对循环中重复调用 getComponent。
+	 */
+	struct BroadphaseProxy {
+		engine::component::PhysicsComponent* physics = nullptr;   ///< 对应的物理组件
+		engine::object::GameObject* owner = nullptr;              ///< 所属游戏对象
+		engine::component::ColliderComponent* collider = nullptr; ///< 对应的碰撞体组件
+		glm::vec2 min{ 0.0f, 0.0f };                              ///< 世界 AABB 左上角
+		glm::vec2 max{ 0.0f, 0.0f };                              ///< 世界 AABB 右下角
+		std::uint32_t layer = collision_layer::DEFAULT;           ///< 碰撞层（缓存自碰撞体）
+		std::uint32_t mask = collision_layer::ALL;                ///< 碰撞掩码（缓存自碰撞体）
+	};
+
+	/// 按碰撞层与掩码判断两个代理能否成为候选对（在窄检测之前过滤）
+	inline bool canCollide(const BroadphaseProxy& a, const BroadphaseProxy& b) {
+		return canCollide(a.layer, a.mask, b.layer, b.mask);
+	}
+
+	/// 候选对，保存两个代理在代理数组中的下标（first < second）
+	using BroadphasePair = std::pair<std::uint32_t, std::uint32_t>;
+
+	/**
+	 * @class SpatialHashGrid
+	 * @brief 基于均匀网格的空间哈希粗检测。
+	 *
+	 * 每帧根据代理的 AABB 重新填充网格，只有落在同一格子中的代理才会成为候选对。
+	 * 输出的候选对按 (first, second) 升序排列，与暴力遍历的顺序一致。
+	 */
+	class SpatialHashGrid {
+	private:
+		float cell_size_;                                                     ///< 网格单元边长（世界单位）
+		int max_cells_per_proxy_ = 256;                                       ///< 单个代理最多占用的格子数，超出则按"超大物体"处理
+		std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_; ///< 格子键 -> 代理下标列表
+		std::vector<std::uint64_t> used_keys_;                                ///< 本帧非空的格子键
+		std::vector<std::uint32_t> oversized_;                                ///< 超大代理下标，与所有代理逐一比较
+		std::vector<glm::ivec2> cell_min_;                                    ///< 各代理覆盖的最小格坐标（帧间复用）
+		std::vector<glm::ivec2> cell_max_;                                    ///< 各代理覆盖的最大格坐标（帧间复用）
+
+	public:
+		explicit SpatialHashGrid(float cell_size = 64.0f);
+
+		SpatialHashGrid(const SpatialHashGrid&) = delete;
+		SpatialHashGrid& operator=(const SpatialHashGrid&) = delete;
+		SpatialHashGrid(SpatialHashGrid&&) = delete;
+		SpatialHashGrid& operator=(SpatialHashGrid&&) = delete;
+
+		/**
+		 * @brief 重建网格并输出所有候选对。
+		 * @param proxies 本帧的代理数组。
+		 * @param out_pairs 输出的候选对（会先被清空）。
+		 */
+		void findPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& out_pairs);
+
+		/**
+		 * @brief 只重建网格，不输出候选对（供场景查询使用）。
+		 * @param proxies 要索引的代理数组，查询时需传入同一数组。
+		 */
+		void build(const std::vector<BroadphaseProxy>& proxies);
+
+		/**
+		 * @brief 查询与区域相交（含边缘接触）的代理。
+		 * @param proxies build() 时使用的代理数组。
+		 * @param min 查询区域左上角。
+		 * @param max 查询区域右下角。
+		 * @param layer_mask 只返回层与该掩码有交集的代理。
+		 * @param out_indices 输出代理下标（会先被清空），已去重且升序。
+		 */
+		void query(const std::vector<BroadphaseProxy>& proxies, const glm::vec2& min, const glm::vec2& max,
+			std::uint32_t layer_mask, std::vector<std::uint32_t>& out_indices) const;
+
+		void setCellSize(float cell_size);
+		float getCellSize() const { return cell_size_; }
+
+	private:
+		static std::uint64_t makeKey(int cell_x, int cell_y);
+	};
+
+	/**
+	 * @class SweepAndPrune
+	 * @brief 基于 X 轴端点排序的扫描剪枝粗检测。
+	 *
+	 * 端点列表在帧间保留，物体每帧位移很小时列表几乎有序，
+	 * 因此用插入排序维护即可接近线性开销。端点以 PhysicsComponent 指针标识，
+	 * 物体注册/注销或代理下标变化时会自动增删与重映射。
+	 */
+	class SweepAndPrune {
+	private:
+		/// X 轴上的一个端点
+		struct Endpoint {
+			float value = 0.0f;                                    ///< 端点 X 坐标
+			engine::component::PhysicsComponent* body = nullptr;  ///< 所属物体（跨帧稳定的标识）
+			std::uint32_t proxy = 0;                               ///< 本帧代理下标
+			bool is_min = true;                                    ///< 是否为左端点
+		};
+
+		std::vector<Endpoint> endpoints_;                                                       ///< 按 X 排序的端点列表（帧间保留）
+		std::unordered_map<engine::component::PhysicsComponent*, std::uint32_t> proxy_lookup_; ///< 物体 -> 本帧代理下标
+		std::vector<std::uint8_t> seen_;                                                       ///< 本帧已有端点的代理标记
+		std::vector<std::uint32_t> active_;                                                    ///< 扫描过程中的活动代理
+		std::vector<std::uint32_t> active_slot_;                                               ///< 代理在 active_ 中的位置
+
+	public:
+		SweepAndPrune() = default;
+
+		SweepAndPrune(const SweepAndPrune&) = delete;
+		SweepAndPrune& operator=(const SweepAndPrune&) = delete;
+		SweepAndPrune(SweepAndPrune&&) = delete;
+		SweepAndPrune& operator=(SweepAndPrune&&) = delete;
+
+		/**
+		 * @brief 更新端点列表并输出所有候选对。
+		 * @param proxies 本帧的代理数组。
+		 * @param out_pairs 输出的候选对（会先被清空）。
+		 */
+		void findPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& out_pairs);
+
+		/// 清空端点列表，下一帧重新建立
+		void clear() { endpoints_.clear(); }
+
+	private:
+		void syncEndpoints(const std::vector<BroadphaseProxy>& proxies);
+		void insertionSort();
+	};
+
+} // namespace engine::physics
@@ -2,6 +2,8 @@
 #include "../component/collider_component.h"
 #include "../component/transform_component.h"
 #include "collider.h"
+#include <algorithm>
+#include <limits>
 
 namespace engine::physics::collision {
 
@@ -149,4 +151,46 @@ bool checkPointInCircle(const glm::vec2& point, const glm::vec2& center, const f
     return glm::dot(point - center, point - center) <= radius * radius;
 }
 
+/**
+ * @brief 扫掠 AABB 检测
+ * 
+ * @param a_min 移动 AABB 的左上角坐标
+ * @param a_max 移动 AABB 的右下角坐标
+ * @param displacement 本次运动的位移
+ * @param b_min 静止 AABB 的左上角坐标
+ * @param b_max 静止 AABB 的右下角坐标
+ * @param out_time 输出接触时刻 [0, 1]
+ * @param out_axis 输出接触面所在轴（0 = X，1 = Y）
+ * @return true 如果在本次运动内发生接触，否则为 false
+ * @details 分轴求出进入/离开时刻（slab 法），最晚的进入时刻即接触时刻，其所在轴即接触面法线方向。
+ *          位移为 0 的轴要求两者在该轴上严格重叠，否则永远不会相交。
+ */
+bool sweepAABB(const glm::vec2& a_min, const glm::vec2& a_max, const glm::vec2& displacement,
+    const glm::vec2& b_min, const glm::vec2& b_max, float& out_time, int& out_axis)
+{
+    float entry = -std::numeric_limits<float>::infinity();
+    float exit = std::numeric_limits<float>::infinity();
+    int axis = -1;
+    for (int i = 0; i < 2; ++i) {
+        const float d = displacement[i];
+        if (d == 0.0f) {
+            if (!(a_max[i] > b_min[i] && a_min[i] < b_max[i])) return false;
+            continue;
+        }
+        const float t0 = (d > 0.0f ? b_min[i] - a_max[i] : b_max[i] - a_min[i]) / d;
+        const float t1 = (d > 0.0f ? b_max[i] - a_min[i] : b_min[i] - a_max[i]) / d;
+        if (t0 > entry) {
+            entry = t0;
+            axis = i;
+        }
+        exit = std::min(exit, t1);
+    }
+
+    // 没有位移、错过、运动开始时已相交或本次运动内到达不了
+    if (axis < 0 || entry >= exit || entry < 0.0f || entry > 1.0f) return false;
+    out_time = entry;
+    out_axis = axis;
+    return true;
+}
+
 } // namespace engine::physics::collision
\ No newline at end of file
@@ -55,6 +55,22 @@ namespace engine::physics::collision {
 	 */
 	bool checkPointInCircle(const glm::vec2& point, const glm::vec2& center, const float radius);
 
+	/**
+	 * @brief 扫掠 AABB 检测：移动的 AABB 沿位移方向运动时，与静止 AABB 的最早接触时刻。
+	 *
+	 * @param a_min 移动 AABB 的左上角坐标（运动开始时）。
+	 * @param a_max 移动 AABB 的右下角坐标（运动开始时）。
+	 * @param displacement 本次运动的位移。
+	 * @param b_min 静止 AABB 的左上角坐标。
+	 * @param b_max 静止 AABB 的右下角坐标。
+	 * @param out_time 输出接触时刻，取值 [0, 1]，按位移比例计。
+	 * @param out_axis 输出接触面所在轴（0 = X，1 = Y）。
+	 * @return true 如果在本次运动内发生接触，否则为 false。
+	 * @note 运动开始时已经相交的情况返回 false，交由重叠修正处理；仅边缘接触且不再靠近也不算接触。
+	 */
+	bool sweepAABB(const glm::vec2& a_min, const glm::vec2& a_max, const glm::vec2& displacement,
+		const glm::vec2& b_min, const glm::vec2& b_max, float& out_time, int& out_axis);
+
 	// 未来可以添加更多碰撞检测相关的函数，
 
 } // namespace engine::physics::collision
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "collision_dispatcher.h"
+#include "../object/game_object.h"
+#include "../component/collider_component.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::physics {
+
+/**
+ * @brief 注册层组合的处理函数
+ * 
+ * @param layer_a 第一个对象所在层
+ * @param layer_b 第二个对象所在层
+ * @param handler 处理函数
+ * @param phase 接触阶段
+ */
+void CollisionDispatcher::registerHandler(std::uint32_t layer_a, std::uint32_t layer_b, Handler handler, ContactPhase phase)
+{
+	if (!handler) {
+		spdlog::warn("CollisionDispatcher: 忽略空的处理函数 ({:#x}, {:#x})", layer_a, layer_b);
+		return;
+	}
+	handlers_[static_cast<size_t>(phase)][makeKey(layer_a, layer_b)] = std::move(handler);
+}
+
+/**
+ * @brief 分发一个碰撞对
+ * 
+ * @param a 第一个对象
+ * @param b 第二个对象
+ * @param phase 接触阶段
+ * @return 处理函数的返回值，未命中时返回 false
+ * @details 先按 (a, b) 查找，未命中时按 (b, a) 查找并交换参数，保证处理函数看到的参数顺序与注册时一致。
+ */
+bool CollisionDispatcher::dispatch(engine::object::GameObject* a, engine::object::GameObject* b, ContactPhase phase) const
+{
+	const auto& handlers = handlers_[static_cast<size_t>(phase)];
+	if (!a || !b || handlers.empty()) return false;
+	const auto* collider_a = a->getComponent<engine::component::ColliderComponent>();
+	const auto* collider_b = b->getComponent<engine::component::ColliderComponent>();
+	if (!collider_a || !collider_b) return false;
+
+	const auto layer_a = collider_a->getLayer();
+	const auto layer_b = collider_b->getLayer();
+	if (auto it = handlers.find(makeKey(layer_a, layer_b)); it != handlers.end()) {
+		return it->second(a, b);
+	}
+	if (layer_a != layer_b) {
+		if (auto it = handlers.find(makeKey(layer_b, layer_a)); it != handlers.end()) {
+			return it->second(b, a);
+		}
+	}
+	return false;
+}
+
+} // namespace engine::physics
@@ -0,0 +1,69 @@
+#pragma once
+/**
+ * @file collision_dispatcher.h
+ * @brief 定义 CollisionDispatcher，按碰撞层组合分发物体碰撞事件。
+ */
+
+#include <functional>
+#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include "contact_cache.h"
+
+namespace engine::object {
+	class GameObject;
+}
+
+namespace engine::physics {
+
+	/**
+	 * @class CollisionDispatcher
+	 * @brief 以 (层 A, 层 B) 为键的碰撞处理表。
+	 *
+	 * 游戏代码为每种层组合注册一个处理函数，分发时只需一次哈希查找，
+	 * 取代逐对比较标签字符串的 if 链。注册 (A, B) 后，(B, A) 的碰撞对会交换参数后调用同一处理函数。
+	 * 处理函数按接触阶段（Enter / Stay / Exit）分别注册，默认只在开始接触时调用。
+	 */
+	class CollisionDispatcher final {
+	public:
+		/// 处理函数：参数顺序与注册时的层顺序一致；返回 true 表示停止处理本帧剩余的碰撞对（例如场景即将切换）
+		using Handler = std::function<bool(engine::object::GameObject*, engine::object::GameObject*)>;
+
+	private:
+		std::array<std::unordered_map<std::uint64_t, Handler>, 3> handlers_; ///< 各接触阶段的 层组合 -> 处理函数
+
+	public:
+		CollisionDispatcher() = default;
+
+		CollisionDispatcher(const CollisionDispatcher&) = delete;
+		CollisionDispatcher& operator=(const CollisionDispatcher&) = delete;
+		CollisionDispatcher(CollisionDispatcher&&) = delete;
+		CollisionDispatcher& operator=(CollisionDispatcher&&) = delete;
+
+		/**
+		 * @brief 注册某种层组合的处理函数（覆盖已有的）。
+		 * @param layer_a 第一个对象所在层（单个位）。
+		 * @param layer_b 第二个对象所在层（单个位）。
+		 * @param handler 处理函数。
+		 * @param phase 在哪个接触阶段调用。
+		 */
+		void registerHandler(std::uint32_t layer_a, std::uint32_t layer_b, Handler handler, ContactPhase phase = ContactPhase::ENTER);
+
+		/**
+		 * @brief 根据两个对象碰撞体的层查找并调用该阶段的处理函数。
+		 * @return 处理函数的返回值；未注册该组合或对象没有碰撞体时返回 false。
+		 */
+		bool dispatch(engine::object::GameObject* a, engine::object::GameObject* b, ContactPhase phase = ContactPhase::ENTER) const;
+
+		/// 清空所有处理函数
+		void clear() {
+			for (auto& handlers : handlers_) handlers.clear();
+		}
+
+	private:
+		static std::uint64_t makeKey(std::uint32_t layer_a, std::uint32_t layer_b) {
+			return (static_cast<std::uint64_t>(layer_a) << 32) | static_cast<std::uint64_t>(layer_b);
+		}
+	};
+
+} // namespace engine::physics
@@ -0,0 +1,27 @@
+#include "collision_layers.h"
+
+namespace engine::physics {
+
+/**
+ * @brief 根据标签得到默认的碰撞层与掩码
+ * 
+ * @param tag 对象标签
+ * @return 碰撞过滤器
+ * @details 所有非实体层都保留 SOLID，使实体对象仍能推离它们（与按标签判断时的行为一致）。
+ */
+CollisionFilter collisionFilterFromTag(std::string_view tag)
+{
+	using namespace collision_layer;
+	// 非玩家对象只关心玩家、实体和未分类对象
+	constexpr std::uint32_t PASSIVE_MASK = PLAYER | SOLID | DEFAULT;
+
+	if (tag == "solid") return { SOLID, ALL & ~SOLID };
+	if (tag == "player") return { PLAYER, ALL };
+	if (tag == "enemy") return { ENEMY, PASSIVE_MASK };
+	if (tag == "item") return { ITEM, PASSIVE_MASK };
+	if (tag == "hazard") return { HAZARD, PASSIVE_MASK };
+	if (tag == "next_level") return { TRIGGER, PASSIVE_MASK };
+	return { DEFAULT, ALL };
+}
+
+} // namespace engine::physics
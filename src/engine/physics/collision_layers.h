@@ -0,0 +1,53 @@
+#pragma once
+/**
+ * @file collision_layers.h
+ * @brief 定义碰撞层与碰撞掩码（uint32 位掩码），用于代替按标签字符串判断碰撞类别。
+ *
+ * 每个碰撞体属于一个层（layer），并用掩码（mask）声明它关心哪些层。
+ * 只有双方互相在对方掩码中时才会进入窄检测。
+ */
+
+#include <cstdint>
+#include <string_view>
+
+namespace engine::physics {
+
+	/// 内置碰撞层，对应 Tiled 中常用的 tag 属性
+	namespace collision_layer {
+		inline constexpr std::uint32_t NONE = 0u;
+		inline constexpr std::uint32_t DEFAULT = 1u << 0; ///< 未设置标签或未知标签
+		inline constexpr std::uint32_t SOLID = 1u << 1;   ///< "solid"：可阻挡的实体对象
+		inline constexpr std::uint32_t HAZARD = 1u << 2;  ///< "hazard"：危险物（尖刺等）
+		inline constexpr std::uint32_t PLAYER = 1u << 3;  ///< "player"
+		inline constexpr std::uint32_t ENEMY = 1u << 4;   ///< "enemy"
+		inline constexpr std::uint32_t ITEM = 1u << 5;    ///< "item"
+		inline constexpr std::uint32_t TRIGGER = 1u << 6; ///< "next_level"：关卡切换等触发区域
+		inline constexpr std::uint32_t ALL = 0xFFFFFFFFu;
+	}
+
+	/**
+	 * @struct CollisionFilter
+	 * @brief 碰撞层与掩码的组合。
+	 */
+	struct CollisionFilter {
+		std::uint32_t layer = collision_layer::DEFAULT; ///< 自身所在层
+		std::uint32_t mask = collision_layer::ALL;      ///< 关心的层
+	};
+
+	/**
+	 * @brief 根据标签得到默认的碰撞层与掩码。
+	 * @param tag 对象标签，如 "solid" / "player" / "enemy"。
+	 * @return 对应的碰撞过滤器；未知标签返回 DEFAULT 层、全掩码。
+	 * @details 默认掩码只保留游戏逻辑或物理响应会用到的组合，
+	 *          例如敌人之间、道具之间、实体之间的接触不会再产生候选对。
+	 */
+	CollisionFilter collisionFilterFromTag(std::string_view tag);
+
+	/**
+	 * @brief 判断两个过滤器是否允许产生碰撞。
+	 */
+	inline bool canCollide(std::uint32_t layer_a, std::uint32_t mask_a, std::uint32_t layer_b, std::uint32_t mask_b) {
+		return (layer_a & mask_b) != 0u && (layer_b & mask_a) != 0u;
+	}
+
+} // namespace engine::physics
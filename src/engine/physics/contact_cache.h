@@ -0,0 +1,155 @@
+#pragma once
+/**
+ * @file contact_cache.h
+ * @brief 定义 ContactCache，在物理步之间保存接触并将其分类为 Enter / Stay / Exit。
+ */
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace engine::physics {
+
+	/**
+	 * @enum ContactPhase
+	 * @brief 接触在本步所处的阶段。
+	 */
+	enum class ContactPhase {
+		ENTER, ///< 本步开始接触
+		STAY,  ///< 上一步已接触，本步仍接触
+		EXIT,  ///< 上一步接触，本步不再接触
+	};
+
+	/**
+	 * @struct ContactId
+	 * @brief 跨步稳定的接触标识。
+	 *
+	 * key 由刚体槽位下标组成（物体对为两个下标，瓦片触发为下标与瓦片类型），
+	 * generations 保存对应槽位的代数，槽位被复用时视为不同的接触。
+	 */
+	struct ContactId {
+		std::uint64_t key = 0;
+		std::uint64_t generations = 0;
+
+		auto operator<=>(const ContactId&) const = default;
+	};
+
+	/**
+	 * @class ContactCache
+	 * @brief 保存上一步的接触集合，每步与本步接触做有序归并得到 Enter / Stay / Exit 三个事件列表。
+	 * @tparam Event 事件载荷（如物体对、物体与瓦片类型）。
+	 *
+	 * 使用方式：beginStep() -> 多次 add() -> endStep()。
+	 * Enter / Stay 事件保持 add() 的顺序，Exit 事件按 ContactId 升序，结果与容器遍历顺序无关。
+	 */
+	template<typename Event>
+	class ContactCache final {
+	private:
+		struct Entry {
+			ContactId id;
+			Event event;
+		};
+
+		std::vector<Entry> previous_;     ///< 上一步的接触（按 id 升序）
+		std::vector<Entry> current_;      ///< 本步的接触（按 add 顺序）
+		std::vector<Entry> sorted_;       ///< 本步接触按 id 排序后的副本（帧间复用）
+		std::vector<Entry> carried_;      ///< 冻结后保留的接触（帧间复用）
+		std::vector<Event> enter_;
+		std::vector<Event> stay_;
+		std::vector<Event> exit_;
+
+	public:
+		/// 开始新的一步，清空本步接触
+		void beginStep() { current_.clear(); }
+
+		/// 记录本步的一个接触（同一 id 在一步内只应添加一次）
+		void add(const ContactId& id, const Event& event) { current_.push_back({ id, event }); }
+
+		/**
+		 * @brief 结束本步并生成事件列表。
+		 * @param is_alive 判断接触双方是否仍存在；已不存在的接触直接丢弃，不产生 Exit（其指针可能已失效）。
+		 * @param is_frozen 判断接触是否处于冻结状态（例如双方都在休眠、本步未做检测）；冻结的接触保持为 Stay。
+		 */
+		template<typename IsAlive, typename IsFrozen>
+		void endStep(IsAlive&& is_alive, IsFrozen&& is_frozen) {
+			enter_.clear();
+			stay_.clear();
+			exit_.clear();
+
+			sorted_ = current_;
+			std::sort(sorted_.begin(), sorted_.end(), [](const Entry& a, const Entry& b) { return a.id < b.id; });
+
+			// 有序归并：只在上一步出现的为 Exit（或冻结后保留），两步都出现的为 Stay
+			carried_.clear();
+			size_t p = 0;
+			for (const auto& entry : sorted_) {
+				for (; p < previous_.size() && previous_[p].id < entry.id; ++p) {
+					classifyMissing(previous_[p], is_alive, is_frozen);
+				}
+				if (p < previous_.size() && previous_[p].id == entry.id) ++p;
+			}
+			for (; p < previous_.size(); ++p) {
+				classifyMissing(previous_[p], is_alive, is_frozen);
+			}
+
+			// Enter / Stay 按本步添加顺序输出
+			for (const auto& entry : current_) {
+				const bool existed = std::binary_search(previous_.begin(), previous_.end(), entry,
+					[](const Entry& a, const Entry& b) { return a.id < b.id; });
+				(existed ? stay_ : enter_).push_back(entry.event);
+			}
+			for (const auto& entry : carried_) {
+				stay_.push_back(entry.event);
+			}
+
+			// 本步接触（含冻结保留的）成为下一步的"上一步"
+			sorted_.insert(sorted_.end(), carried_.begin(), carried_.end());
+			std::sort(sorted_.begin(), sorted_.end(), [](const Entry& a, const Entry& b) { return a.id < b.id; });
+			previous_.swap(sorted_);
+		}
+
+		/// 遍历上一步结束时的接触（含冻结保留的），fn(const ContactId&)
+		template<typename Fn>
+		void forEachContact(Fn&& fn) const {
+			for (const auto& entry : previous_) {
+				fn(entry.id);
+			}
+		}
+
+		/// 清空所有接触（例如切换场景时），不产生 Exit
+		void clear() {
+			previous_.clear();
+			current_.clear();
+			enter_.clear();
+			stay_.clear();
+			exit_.clear();
+		}
+
+		const std::vector<Event>& getEnterEvents() const { return enter_; }
+		const std::vector<Event>& getStayEvents() const { return stay_; }
+		const std::vector<Event>& getExitEvents() const { return exit_; }
+
+		/// 获取指定阶段的事件列表
+		const std::vector<Event>& getEvents(ContactPhase phase) const {
+			switch (phase) {
+			case ContactPhase::ENTER: return enter_;
+			case ContactPhase::STAY: return stay_;
+			case ContactPhase::EXIT:
+			default: return exit_;
+			}
+		}
+
+	private:
+		template<typename IsAlive, typename IsFrozen>
+		void classifyMissing(const Entry& entry, IsAlive& is_alive, IsFrozen& is_frozen) {
+			if (!is_alive(entry.id)) return;
+			if (is_frozen(entry.id)) {
+				carried_.push_back(entry);
+			}
+			else {
+				exit_.push_back(entry.event);
+			}
+		}
+	};
+
+} // namespace engine::physics
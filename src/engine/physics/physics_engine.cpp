@@ -5,24 +5,260 @@
 #include "../component/collider_component.h"
 #include "../component/tilelayer_component.h"
 #include "collision.h"
+#include "collision_layers.h"
+#include "tile_collider_set.h"
 #include "../object/game_object.h"
 #include <glm/glm.hpp>
 #include <algorithm>
 #include <set>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <bit>
 
 namespace engine::physics {
 
+/**
+ * @brief 合并矩形单轴阻挡查询的结果
+ */
+struct StaticBlock {
+	bool hit = false;            ///< 是否被阻挡
+	float stop = 0.0f;           ///< 阻挡面（图层局部坐标，沿运动轴）
+	float perp_min = 0.0f;       ///< 阻挡面上所有阻挡矩形在垂直轴上的最小起点
+	float perp_max = 0.0f;       ///< 阻挡面上所有阻挡矩形在垂直轴上的最大终点
+	bool covers_band_min = false; ///< 阻挡矩形是否覆盖带状区域起点（如 X 轴运动时的顶部）
+	bool covers_band_max = false; ///< 阻挡矩形是否覆盖带状区域终点（如 X 轴运动时的底部）
+};
+
+/**
+ * @brief 刚体在瓦片解析阶段会被修改的状态，用于并行校验时保存与恢复
+ */
+struct BodyStepSnapshot {
+	glm::vec2 transform_position{ 0.0f, 0.0f };
+	glm::vec2 component_velocity{ 0.0f, 0.0f };
+	glm::vec2 body_velocity{ 0.0f, 0.0f };
+	glm::vec2 body_position{ 0.0f, 0.0f };
+	std::uint8_t contacts = 0; ///< 下/上/左/右 碰撞标志
+
+	bool operator==(const BodyStepSnapshot&) const = default;
+};
+
+/**
+ * @brief 用 DDA 网格遍历求射线与单个瓦片图层的首个命中
+ *
+ * @param view 图层碰撞视图
+ * @param origin 起点（世界坐标）
+ * @param ds 射线位移（起点到终点）
+ * @param mask 会命中的瓦片类型
+ * @param max_t 只接受小于该比例的命中
+ * @param out_t 输出命中比例 [0, 1]
+ * @param out_axis 输出命中面所在轴
+ * @param out_tile 输出命中瓦片坐标
+ * @return 是否命中
+ * @details 逐格前进到射线离开当前格的最近边界，起点所在格不检测。
+ */
+static bool raycastTileLayer(const engine::component::TileCollisionView& view, const glm::vec2& origin, const glm::vec2& ds,
+	TileTypeMask mask, float max_t, float& out_t, int& out_axis, glm::ivec2& out_tile)
+{
+	const glm::vec2 local = origin - view.world_offset;
+	const glm::vec2& ts = view.tile_size;
+	glm::ivec2 tile{ static_cast<int>(std::floor(local.x / ts.x)), static_cast<int>(std::floor(local.y / ts.y)) };
+	const glm::ivec2 last{ static_cast<int>(std::floor((local.x + ds.x) / ts.x)), static_cast<int>(std::floor((local.y + ds.y) / ts.y)) };
+
+	glm::ivec2 step{ 0, 0 };
+	glm::vec2 t_max{ std::numeric_limits<float>::infinity() };
+	glm::vec2 t_delta{ std::numeric_limits<float>::infinity() };
+	for (int axis = 0; axis < 2; ++axis) {
+		if (ds[axis] > 0.0f) {
+			step[axis] = 1;
+			t_max[axis] = ((static_cast<float>(tile[axis]) + 1.0f) * ts[axis] - local[axis]) / ds[axis];
+			t_delta[axis] = ts[axis] / ds[axis];
+		}
+		else if (ds[axis] < 0.0f) {
+			step[axis] = -1;
+			t_max[axis] = (static_cast<float>(tile[axis]) * ts[axis] - local[axis]) / ds[axis];
+			t_delta[axis] = -ts[axis] / ds[axis];
+		}
+	}
+
+	const int steps = std::abs(last.x - tile.x) + std::abs(last.y - tile.y);
+	for (int i = 0; i < steps; ++i) {
+		const int axis = t_max.x < t_max.y ? 0 : 1;
+		const float t = t_max[axis];
+		if (t >= max_t) return false;
+		tile[axis] += step[axis];
+		t_max[axis] += t_delta[axis];
+		if ((mask & tileTypeBit(view.at(tile.x, tile.y))) != 0u) {
+			out_t = t;
+			out_axis = axis;
+			out_tile = tile;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief 遍历区域覆盖的指定类型瓦片
+ *
+ * @param layers 瓦片图层
+ * @param rect 世界矩形
+ * @param mask 瓦片类型掩码
+ * @param fn 回调 fn(view, tile_x, tile_y, type)，返回 false 时停止遍历
+ * @return 是否被回调提前停止
+ */
+template<typename Fn>
+static bool forEachTileInRect(const std::vector<engine::component::TileLayerComponent*>& layers, const engine::utils::Rect& rect,
+	TileTypeMask mask, Fn&& fn)
+{
+	const glm::vec2 corner = rect.position + rect.size;
+	const glm::vec2 rect_min = glm::min(rect.position, corner);
+	const glm::vec2 rect_max = glm::max(rect.position, corner);
+	for (auto* layer : layers) {
+		if (!layer || layer->isHidden()) continue;
+		const auto view = layer->getCollisionView();
+		if (!view.isValid()) continue;
+
+		const int start_x = std::max(view.toTileX(rect_min.x), 0);
+		const int end_x   = std::min(view.toTileX(rect_max.x), view.map_size.x - 1);
+		const int start_y = std::max(view.toTileY(rect_min.y), 0);
+		const int end_y   = std::min(view.toTileY(rect_max.y), view.map_size.y - 1);
+		for (int y = start_y; y <= end_y; ++y) {
+			for (int x = start_x; x <= end_x; ++x) {
+				const auto type = view.at(x, y);
+				if ((mask & tileTypeBit(type)) == 0u) continue;
+				if (!fn(view, x, y, type)) return true;
+			}
+		}
+	}
+	return false;
+}
+
+static std::vector<BodyStepSnapshot> captureBodySteps(const BodyArrays& bodies)
+{
+	std::vector<BodyStepSnapshot> snapshots(bodies.size());
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		const auto* pc = bodies.component[i];
+		auto& s = snapshots[i];
+		if (bodies.transform[i]) s.transform_position = bodies.transform[i]->getPosition();
+		s.component_velocity = pc->velocity_;
+		s.body_velocity = bodies.velocity[i];
+		s.body_position = bodies.position[i];
+		s.contacts = static_cast<std::uint8_t>((pc->hasCollidedBelow() ? 1u : 0u) | (pc->hasCollidedAbove() ? 2u : 0u) |
+			(pc->hasCollidedLeft() ? 4u : 0u) | (pc->hasCollidedRight() ? 8u : 0u));
+	}
+	return snapshots;
+}
+
+static void restoreBodySteps(BodyArrays& bodies, const std::vector<BodyStepSnapshot>& snapshots)
+{
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		auto* pc = bodies.component[i];
+		const auto& s = snapshots[i];
+		if (bodies.transform[i]) bodies.transform[i]->setPosition(s.transform_position);
+		pc->velocity_ = s.component_velocity;
+		bodies.velocity[i] = s.body_velocity;
+		bodies.position[i] = s.body_position;
+		pc->setCollidedBelow((s.contacts & 1u) != 0u);
+		pc->setCollidedAbove((s.contacts & 2u) != 0u);
+		pc->setCollidedLeft((s.contacts & 4u) != 0u);
+		pc->setCollidedRight((s.contacts & 8u) != 0u);
+	}
+}
+
+/**
+ * @brief 在合并后的静态矩形中沿单轴查找最近的阻挡
+ * 
+ * @param colliders 静态矩形集合
+ * @param axis 运动轴（0 = X，1 = Y）
+ * @param lead_old 运动前前沿坐标（图层局部坐标，已含容差）
+ * @param lead_new 运动后前沿坐标（图层局部坐标，已含容差）
+ * @param band_min 垂直轴带状区域起点（图层局部坐标，已含容差）
+ * @param band_max 垂直轴带状区域终点（图层局部坐标，已含容差）
+ * @param cell 运动轴方向的瓦片尺寸
+ * @param include_unisolid 是否把 UNISOLID 矩形视为阻挡（仅向下运动）
+ * @return 阻挡结果
+ * @details 前沿在本步内越过矩形边界时停在矩形边界（扫掠）；
+ *          前沿起止都在矩形内部时与逐格检测一致，停在前沿所在瓦片的边界。
+ */
+static StaticBlock findStaticBlock(const TileColliderSet& colliders, int axis, float lead_old, float lead_new,
+	float band_min, float band_max, float cell, bool include_unisolid)
+{
+	using engine::component::TileType;
+	thread_local std::vector<std::uint32_t> candidates;
+
+	const int perp = 1 - axis;
+	const float dir = lead_new >= lead_old ? 1.0f : -1.0f;
+	glm::vec2 query_min, query_max;
+	query_min[axis] = std::min(lead_old, lead_new);
+	query_max[axis] = std::max(lead_old, lead_new);
+	query_min[perp] = band_min;
+	query_max[perp] = band_max;
+	colliders.query(query_min, query_max, candidates);
+
+	StaticBlock block;
+	for (auto index : candidates) {
+		const auto& rect = colliders.getRect(index);
+		if (rect.type == TileType::UNISOLID && !include_unisolid) continue;
+		// 垂直轴需真正重叠，仅边缘接触不算阻挡
+		if (!(rect.min[perp] < band_max && rect.max[perp] > band_min)) continue;
+
+		float stop = 0.0f;
+		if (dir > 0.0f) {
+			if (rect.min[axis] >= lead_old && rect.min[axis] <= lead_new) {
+				stop = rect.min[axis];
+			}
+			else if (rect.min[axis] < lead_old && rect.max[axis] > lead_new) {
+				stop = std::floor(lead_new / cell) * cell;
+			}
+			else continue;
+		}
+		else {
+			if (rect.max[axis] <= lead_old && rect.max[axis] > lead_new) {
+				stop = rect.max[axis];
+			}
+			else if (rect.max[axis] > lead_old && rect.min[axis] <= lead_new) {
+				stop = (std::floor(lead_new / cell) + 1.0f) * cell;
+			}
+			else continue;
+		}
+
+		const bool nearer = !block.hit || (dir > 0.0f ? stop < block.stop : stop > block.stop);
+		if (nearer) {
+			block = StaticBlock{};
+			block.hit = true;
+			block.stop = stop;
+			block.perp_min = rect.min[perp];
+			block.perp_max = rect.max[perp];
+		}
+		else if (stop != block.stop) {
+			continue;
+		}
+		block.perp_min = std::min(block.perp_min, rect.min[perp]);
+		block.perp_max = std::max(block.perp_max, rect.max[perp]);
+		block.covers_band_min = block.covers_band_min || (rect.min[perp] <= band_min && rect.max[perp] > band_min);
+		block.covers_band_max = block.covers_band_max || (rect.min[perp] <= band_max && rect.max[perp] > band_max);
+	}
+	return block;
+}
+
 /**
  * @brief 注册物理组件到物理引擎
  * 
  * @param physics_component 物理组件指针
- * @details 将物理组件添加到物理引擎的管理列表中，使其参与物理更新和碰撞检测
+ * @return 刚体句柄，组件保存它以便注销
+ * @details 在 SoA 刚体存储中分配一个刚体，并缓存组件、所属对象与变换组件指针，使其参与物理更新和碰撞检测
  */
-void PhysicsEngine::registerPhysicsComponent(component::PhysicsComponent* physics_component)
+BodyHandle PhysicsEngine::registerPhysicsComponent(component::PhysicsComponent* physics_component)
 {
-	physics_components_.push_back(physics_component);
+	if (!physics_component) {
+		spdlog::error("注册物理组件失败：组件为空");
+		return {};
+	}
+	const auto handle = bodies_.create(physics_component, physics_component->getOwner(), physics_component->getTransform());
+	query_index_dirty_ = true;
 	spdlog::info("物理组件注册 {}", static_cast<void*>(physics_component));
+	return handle;
 }
 
 /**
@@ -34,7 +270,17 @@ void PhysicsEngine::registerPhysicsComponent(component::PhysicsComponent* physic
 void PhysicsEngine::registerCollisionLayer(component::TileLayerComponent* tilelayer_component)
 {
 	tilelayer_component->setPhysicsEngine(this);
+	// 未经 LevelLoader 合并的图层在注册时补建静态矩形
+	if (!tilelayer_component->getStaticColliders()) {
+		tilelayer_component->buildStaticColliders();
+	}
+	// 同一瓦片尺寸只生成一张斜坡高度表，图层直接持有其指针
+	const SlopeHeightTable* slopes = findSlopeTable(glm::vec2(tilelayer_component->getTileSize()));
+	if (!slopes) {
+		slopes = slope_tables_.emplace_back(std::make_unique<SlopeHeightTable>(tilelayer_component->getTileSize())).get();
+	}
 	tilelayer_components_.push_back(tilelayer_component);
+	collision_layers_.push_back({ tilelayer_component, slopes });
 	spdlog::info("瓦片图层组件注册 {}", static_cast<void*>(tilelayer_component));
 }
 
@@ -46,7 +292,16 @@ void PhysicsEngine::registerCollisionLayer(component::TileLayerComponent* tilela
  */
 void PhysicsEngine::unregisterPhysicsComponent(component::PhysicsComponent* physics_component)
 {
-	physics_components_.erase(std::remove(physics_components_.begin(), physics_components_.end(), physics_component), physics_components_.end());
+	if (!physics_component || !bodies_.destroy(physics_component->body_handle_)) {
+		spdlog::warn("注销物理组件失败：{} 未注册或句柄已失效", static_cast<void*>(physics_component));
+		return;
+	}
+	// 被移除的物体可能正支撑着休眠物体，只唤醒与它接触过的物体；场景清理时其余物体也将被注销，无需唤醒
+	if (!tearing_down_) {
+		wakeContactsOf(physics_component->body_handle_);
+	}
+	physics_component->body_handle_ = {};
+	query_index_dirty_ = true;
 	spdlog::info("物理组件注册注销 {}", static_cast<void*>(physics_component));
 }
 
@@ -59,6 +314,7 @@ void PhysicsEngine::unregisterPhysicsComponent(component::PhysicsComponent* phys
 void PhysicsEngine::unregisterCollisionLayer(component::TileLayerComponent* tilelayer_component)
 {
 	tilelayer_components_.erase(std::remove(tilelayer_components_.begin(), tilelayer_components_.end(), tilelayer_component), tilelayer_components_.end());
+	std::erase_if(collision_layers_, [tilelayer_component](const CollisionLayer& entry) { return entry.layer == tilelayer_component; });
 	spdlog::info("瓦片图层组件注册注销 {}", static_cast<void*>(tilelayer_component));
 }
 
@@ -74,7 +330,9 @@ engine::component::TileType PhysicsEngine::getTileTypeAt(const glm::vec2& world_
 	engine::component::TileType result = engine::component::TileType::NORMAL;
 	for (auto* layer : tilelayer_components_) {
 		if (layer) {
-			auto type = layer->getTileTypeAtWorldPos(world_pos);
+			const auto view = layer->getCollisionView();
+			if (!view.isValid()) continue;
+			auto type = view.at(view.toTileX(world_pos.x), view.toTileY(world_pos.y));
 			if (type == engine::component::TileType::LADDER) return type; // 优先探测梯子
 			if (type != engine::component::TileType::EMPTY && type != engine::component::TileType::NORMAL) {
 				result = type; // 记录其他非空类型（如 SOLID），但继续寻找 LADDER
@@ -98,28 +356,192 @@ bool PhysicsEngine::tryGetLadderColumnCenterX(const glm::vec2& world_pos, float&
 	for (auto* layer : tilelayer_components_) {
 		if (!layer || layer->isHidden()) continue;
 
-		const glm::vec2 tile_size = glm::vec2(layer->getTileSize());
-		if (tile_size.x <= 0.0f || tile_size.y <= 0.0f) continue;
-
-		// 计算图层世界坐标偏移
-		glm::vec2 layer_world_offset = layer->getOffset();
-		if (auto* layer_owner = layer->getOwner()) {
-			if (auto* tc = layer_owner->getComponent<engine::component::TransformComponent>()) {
-				layer_world_offset += tc->getPosition();
-			}
-		}
+		const auto view = layer->getCollisionView();
+		if (!view.isValid()) continue;
 
-		glm::ivec2 tile_coords = glm::floor((world_pos - layer_world_offset) / tile_size);
-		TileType type = layer->getTileTypeAt(tile_coords);
-		if (type != TileType::LADDER) continue;
+		const int tile_x = view.toTileX(world_pos.x);
+		const int tile_y = view.toTileY(world_pos.y);
+		if (view.at(tile_x, tile_y) != TileType::LADDER) continue;
 
 		// 返回梯子所在列的中心 X
-		out_center_x = layer_world_offset.x + (static_cast<float>(tile_coords.x) + 0.5f) * tile_size.x;
+		out_center_x = view.world_offset.x + (static_cast<float>(tile_x) + 0.5f) * view.tile_size.x;
 		return true;
 	}
 	return false;
 }
 
+/**
+ * @brief 按刚体当前的碰撞盒重建场景查询索引
+ * 
+ * @details 只在索引失效（物理步结束、刚体注册/注销）后的首次查询时重建，
+ *          同一帧内的多次查询共用同一份网格。
+ */
+void PhysicsEngine::refreshQueryIndex() const
+{
+	if (!query_index_dirty_) return;
+	query_proxies_.clear();
+	const auto& bodies = bodies_.arrays();
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::COLLIDER) == 0u || !bodies.owner[i]) continue;
+		const glm::vec2 corner = bodies.position[i] + bodies.aabb_size[i];
+		BroadphaseProxy proxy;
+		proxy.physics = bodies.component[i];
+		proxy.owner = bodies.owner[i];
+		proxy.collider = bodies.collider[i];
+		proxy.min = glm::min(bodies.position[i], corner);
+		proxy.max = glm::max(bodies.position[i], corner);
+		proxy.layer = proxy.collider->getLayer();
+		proxy.mask = proxy.collider->getMask();
+		query_proxies_.push_back(proxy);
+	}
+	query_grid_.build(query_proxies_);
+	query_index_dirty_ = false;
+}
+
+/**
+ * @brief 射线检测
+ * 
+ * @param origin 起点
+ * @param direction 方向
+ * @param max_distance 最大距离
+ * @param out_hit 输出命中信息
+ * @param filter 过滤条件
+ * @return 是否命中
+ * @details 先求瓦片命中，再只在"起点到瓦片命中点"的范围内查询物体，被墙挡住的物体不会被取出。
+ */
+bool PhysicsEngine::raycast(const glm::vec2& origin, const glm::vec2& direction, float max_distance, RaycastHit& out_hit,
+	const QueryFilter& filter) const
+{
+	if (!(max_distance > 0.0f) || direction == glm::vec2(0.0f)) return false;
+	const glm::vec2 ds = glm::normalize(direction) * max_distance;
+	float best_t = 1.0f;
+	int best_axis = -1;
+	RaycastHit hit;
+
+	// 1. 瓦片
+	if (filter.tile_mask != tile_mask::NONE) {
+		for (auto* layer : tilelayer_components_) {
+			if (!layer || layer->isHidden()) continue;
+			const auto view = layer->getCollisionView();
+			if (!view.isValid()) continue;
+			float t = 0.0f;
+			int axis = 0;
+			glm::ivec2 tile{ 0, 0 };
+			if (!raycastTileLayer(view, origin, ds, filter.tile_mask, best_t, t, axis, tile)) continue;
+			best_t = t;
+			best_axis = axis;
+			hit.object = nullptr;
+			hit.tile = tile;
+			hit.tile_type = view.at(tile.x, tile.y);
+		}
+	}
+
+	// 2. 物体
+	if (filter.layer_mask != collision_layer::NONE) {
+		refreshQueryIndex();
+		const glm::vec2 end = origin + ds * best_t;
+		query_grid_.query(query_proxies_, glm::min(origin, end), glm::max(origin, end), filter.layer_mask, query_indices_);
+		for (auto index : query_indices_) {
+			const auto& proxy = query_proxies_[index];
+			if (proxy.owner == filter.ignore) continue;
+			float t = 0.0f;
+			int axis = 0;
+			if (!collision::sweepAABB(origin, origin, ds, proxy.min, proxy.max, t, axis) || t >= best_t) continue;
+			best_t = t;
+			best_axis = axis;
+			hit.object = proxy.owner;
+			hit.tile = { -1, -1 };
+			hit.tile_type = engine::component::TileType::EMPTY;
+		}
+	}
+
+	if (best_axis < 0) return false;
+	hit.point = origin + ds * best_t;
+	hit.distance = max_distance * best_t;
+	hit.normal = glm::vec2(0.0f);
+	hit.normal[best_axis] = ds[best_axis] > 0.0f ? -1.0f : 1.0f;
+	out_hit = hit;
+	return true;
+}
+
+/**
+ * @brief 两点之间是否没有阻挡视线的瓦片
+ * 
+ * @param from 起点
+ * @param to 终点
+ * @param blocking 阻挡视线的瓦片类型
+ * @return 没有阻挡返回 true
+ */
+bool PhysicsEngine::hasLineOfSight(const glm::vec2& from, const glm::vec2& to, TileTypeMask blocking) const
+{
+	const glm::vec2 delta = to - from;
+	const float distance = glm::length(delta);
+	if (distance <= 0.0f) return true;
+	QueryFilter filter;
+	filter.tile_mask = blocking;
+	filter.layer_mask = collision_layer::NONE;
+	RaycastHit hit;
+	return !raycast(from, delta, distance, hit, filter);
+}
+
+/**
+ * @brief 查询与区域相交的物体
+ * 
+ * @param rect 世界矩形
+ * @param out_objects 输出物体
+ * @param layer_mask 碰撞层掩码
+ * @return 物体数量
+ */
+size_t PhysicsEngine::overlapAABB(const engine::utils::Rect& rect, std::vector<engine::object::GameObject*>& out_objects,
+	std::uint32_t layer_mask) const
+{
+	out_objects.clear();
+	refreshQueryIndex();
+	const glm::vec2 corner = rect.position + rect.size;
+	query_grid_.query(query_proxies_, glm::min(rect.position, corner), glm::max(rect.position, corner), layer_mask, query_indices_);
+	for (auto index : query_indices_) {
+		out_objects.push_back(query_proxies_[index].owner);
+	}
+	return out_objects.size();
+}
+
+/**
+ * @brief 查询区域覆盖的指定类型瓦片
+ * 
+ * @param rect 世界矩形
+ * @param mask 瓦片类型掩码
+ * @param out_tiles 输出瓦片
+ * @return 瓦片数量
+ */
+size_t PhysicsEngine::queryTiles(const engine::utils::Rect& rect, TileTypeMask mask, std::vector<TileQueryHit>& out_tiles) const
+{
+	out_tiles.clear();
+	forEachTileInRect(tilelayer_components_, rect, mask,
+		[&out_tiles](const engine::component::TileCollisionView& view, int x, int y, engine::component::TileType type) {
+			TileQueryHit tile_hit;
+			tile_hit.tile = { x, y };
+			tile_hit.type = type;
+			tile_hit.world_rect.position = view.world_offset + glm::vec2(static_cast<float>(x), static_cast<float>(y)) * view.tile_size;
+			tile_hit.world_rect.size = view.tile_size;
+			out_tiles.push_back(tile_hit);
+			return true;
+		});
+	return out_tiles.size();
+}
+
+/**
+ * @brief 区域内是否存在指定类型的瓦片
+ * 
+ * @param rect 世界矩形
+ * @param mask 瓦片类型掩码
+ * @return 存在返回 true
+ */
+bool PhysicsEngine::overlapsTile(const engine::utils::Rect& rect, TileTypeMask mask) const
+{
+	return forEachTileInRect(tilelayer_components_, rect, mask,
+		[](const engine::component::TileCollisionView&, int, int, engine::component::TileType) { return false; });
+}
+
 /**
  * @brief 更新所有物理组件
  * 
@@ -130,40 +552,271 @@ void PhysicsEngine::update(float delta_time)
 {
 	collision_pairs_.clear();
     tile_trigger_events_.clear();
+	collision_contacts_.beginStep();
+	tile_trigger_contacts_.beginStep();
+	support_contacts_.beginStep();
 	// 防止卡顿/断点导致 dt 过大，从而一帧内位移过大直接飞出镜头
 	const float dt = std::clamp(delta_time, 0.0f, 1.0f / 30.0f);
-    for (auto* pc : physics_components_) {
-        if (!pc || !pc->isEnabled()) { // 检查组件是否有效和启用
-            continue;
-        }
 
-        // 重置碰撞标志
-        pc->resetCollisionFlags();
+	// 1. 收集组件状态到 SoA 数组（游戏逻辑直接写组件的 velocity_，因此每步开始时同步一次）
+	gatherBodies(dt);
+	// 运动学平台先移动，站在其上的物体本步带上平台的位移
+	moveKinematicBodies(dt);
+	collectCCDSolids();
+
+	// 图层的世界偏移是惰性缓存，并行阶段之前先在当前线程刷新，之后的查询只读
+	for (auto* layer : tilelayer_components_) {
+		if (layer) layer->getWorldOffset();
+	}
+
+	// 2. 积分与瓦片碰撞解析：各刚体互不依赖，有线程池时按刚体分块并行
+	if (verify_parallel_ && worker_pool_) {
+		verifyParallelBodyStep(dt);
+	}
+	else {
+		stepBodies(dt, true);
+	}
+
+	checkObjectCollisions();
+	// 固体推离会移动 Transform，触发器检测前刷新碰撞盒位置
+	syncBodyPositions();
+	checkTileTriggers();
+	// 在休眠判定之前分类：此时的休眠状态与窄检测、瓦片触发检测时一致
+	updateContactEvents();
+	updateSleepStates();
+	query_index_dirty_ = true;
+}
+
+/**
+ * @brief 计算所有刚体状态的校验和
+ * 
+ * @return 64 位 FNV-1a 哈希
+ * @details 按刚体紧凑下标顺序哈希 Transform 位置与组件速度的位模式，任何一位不同都会得到不同结果。
+ */
+std::uint64_t PhysicsEngine::computeStateHash() const
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	auto mix = [&hash](float value) {
+		const auto bits = std::bit_cast<std::uint32_t>(value);
+		for (int shift = 0; shift < 32; shift += 8) {
+			hash ^= (bits >> shift) & 0xFFu;
+			hash *= 1099511628211ull;
+		}
+	};
+	const auto& bodies = bodies_.arrays();
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		if (const auto* tc = bodies.transform[i]) {
+			mix(tc->getPosition().x);
+			mix(tc->getPosition().y);
+		}
+		if (const auto* pc = bodies.component[i]) {
+			mix(pc->velocity_.x);
+			mix(pc->velocity_.y);
+		}
+	}
+	return hash;
+}
+
+/**
+ * @brief 将组件状态收集到 SoA 数组
+ * 
+ * @param dt 时间步长
+ * @details 处理唤醒、重置碰撞标志和吸附抑制计时，并为本步参与模拟的刚体填充速度、外力、质量倒数等数据。
+ *          外力（不含重力）在此读取后即从组件清除，重力在积分时单独加上。
+ */
+void PhysicsEngine::gatherBodies(float dt)
+{
+	using namespace body_flag;
+	auto& bodies = bodies_.arrays();
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		auto* pc = bodies.component[i];
+		bodies.inverse_mass[i] = 0.0f;
+		bodies.gravity_scale[i] = 0.0f;
+		bodies.force[i] = glm::vec2(0.0f);
+		bodies.flags[i] = 0;
+		if (!pc || !pc->isEnabled()) { // 检查组件是否有效和启用
+			continue;
+		}
+
+		// 碰撞体指针在首次使用时缓存（构建对象时碰撞体可能晚于物理组件添加）
+		if (!bodies.collider[i] && bodies.owner[i]) {
+			bodies.collider[i] = bodies.owner[i]->getComponent<engine::component::ColliderComponent>();
+		}
+		std::uint8_t flags = ENABLED;
+		if (const auto* cc = bodies.collider[i]) {
+			if (cc->getIsActive()) flags |= COLLIDER;
+			if (cc->getIsTrigger()) flags |= TRIGGER;
+			if (const auto* tc = bodies.transform[i]) {
+				bodies.aabb_offset[i] = cc->getOffset();
+				bodies.aabb_size[i] = cc->getWorldAABB().size;
+				bodies.position[i] = tc->getPosition() + bodies.aabb_offset[i];
+			}
+		}
+
+		// 运动学刚体不休眠、不积分，位移在 moveKinematicBodies 中计算
+		if (pc->isKinematic()) {
+			pc->wakeUp();
+			pc->resetCollisionFlags();
+			pc->clearForce();
+			bodies.flags[i] = flags | KINEMATIC;
+			continue;
+		}
+
+		// 休眠物体跳过积分与瓦片解析，保留休眠前的碰撞标志，只作为粗检测目标
+		if (pc->sleeping_ && shouldWake(pc)) {
+			pc->wakeUp();
+		}
+		if (pc->sleeping_) {
+			bodies.flags[i] = flags | SLEEPING;
+			continue;
+		}
+
+		// 重置碰撞标志
+		pc->resetCollisionFlags();
 		pc->tickSnapSuppression(dt);
 
 		const float mass = pc->getMass();
 		if (!(mass > 0.0f) || !std::isfinite(mass)) {
+			bodies.flags[i] = flags;
 			continue;
 		}
-		
-        // 应用重力 (如果组件受重力影响)：F = g * m
-        if (pc->isUseGravity()) {
-            pc->addForce(gravity_ * pc->getMass());
-        }
-        /* 还可以添加其它力影响，比如风力、摩擦力等，目前不考虑 */
 
-        // 更新速度： v += a * dt，其中 a = F / m
-        pc->velocity_ += (pc->getForce() / mass) * dt;
-        pc->clearForce(); // 清除当前帧的力
+		// 外力（不含重力）超过阈值时重新计数静止步数
+		const glm::vec2 external_force = glm::abs(pc->getForce());
+		if (external_force.x >= sleep_force_threshold_ || external_force.y >= sleep_force_threshold_) {
+			pc->rest_steps_ = 0;
+		}
+
+		bodies.velocity[i] = pc->velocity_;
+		bodies.force[i] = pc->getForce();
+		pc->clearForce(); // 清除当前帧的力
+		bodies.inverse_mass[i] = 1.0f / mass;
+		bodies.gravity_scale[i] = pc->isUseGravity() ? 1.0f : 0.0f;
+		bodies.flags[i] = flags | SIMULATE;
+	}
+}
+
+/**
+ * @brief 移动运动学刚体，并计算站在其上的物体被携带的位移
+ * 
+ * @param dt 时间步长
+ * @details 运动学刚体沿路径（或按 velocity_）移动，不做瓦片碰撞；沿路径移动时 velocity_ 设为本步的平均速度，
+ *          使接触到的休眠物体能够被唤醒。上一步被推到某个运动学刚体上方的物体记录了该刚体的句柄，
+ *          本步把它的位移写入 displacement，在瓦片解析时与自身速度位移一起处理，因此不会被平台带进墙里。
+ *          两趟遍历都是 O(n)，平台数量不影响其余阶段的复杂度。
+ */
+void PhysicsEngine::moveKinematicBodies(float dt)
+{
+	auto& bodies = bodies_.arrays();
+	std::fill(bodies.displacement.begin(), bodies.displacement.end(), glm::vec2(0.0f));
+
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::KINEMATIC) == 0u) continue;
+		auto* pc = bodies.component[i];
+		auto* tc = bodies.transform[i];
+		if (!tc) continue;
+
+		glm::vec2 ds{ 0.0f, 0.0f };
+		if (pc->hasKinematicPath()) {
+			ds = pc->advanceKinematicPath(tc->getPosition(), dt);
+			pc->velocity_ = dt > 0.0f ? ds / dt : glm::vec2(0.0f);
+		}
+		else {
+			ds = pc->velocity_ * dt;
+		}
+		tc->translate(ds);
+		bodies.position[i] += ds;
+		bodies.displacement[i] = ds;
+	}
 
-		// 限制最大速度：v = min(v, max_speed)
-		pc->velocity_ = glm::clamp(pc->velocity_, -max_speed_, max_speed_);
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::SIMULATE) == 0u) continue;
+		auto* pc = bodies.component[i];
+		const auto ground = bodies_.indexOf(pc->ground_body_);
+		pc->ground_body_ = {};
+		if (ground != BodyHandle::INVALID_INDEX && (bodies.flags[ground] & body_flag::KINEMATIC) != 0u) {
+			bodies.displacement[i] = bodies.displacement[ground];
+		}
+	}
+}
 
-		resolveTileCollisions(pc, dt);
+/**
+ * @brief 积分并解析瓦片碰撞
+ * 
+ * @param dt 时间步长
+ * @param parallel 是否允许使用线程池
+ * @details 每块先对自己的区间做无分支积分：v += (F / m + g) * dt，再逐个刚体把速度写回组件并做瓦片解析。
+ *          瓦片解析只读图层与本步开始时的 CCD 快照，只写本刚体的组件，因此可以按刚体并行。
+ */
+void PhysicsEngine::stepBodies(float dt, bool parallel)
+{
+	auto& bodies = bodies_.arrays();
+	auto step = [&](size_t begin, size_t end, size_t /*chunk*/) {
+		integrateBodies(bodies, gravity_, max_speed_, dt, begin, end);
+		for (size_t i = begin; i < end; ++i) {
+			if ((bodies.flags[i] & body_flag::SIMULATE) == 0u) continue;
+			bodies.component[i]->velocity_ = bodies.velocity[i];
+			resolveTileCollisions(static_cast<std::uint32_t>(i), dt);
+		}
+	};
+	if (parallel) {
+		parallelFor(bodies.size(), PARALLEL_BODY_GRAIN, step);
+	}
+	else {
+		step(0, bodies.size(), 0);
+	}
+}
 
+/**
+ * @brief 并行执行一次刚体步，再恢复初始状态以单线程重做并对比
+ * 
+ * @param dt 时间步长
+ * @details 最终保留单线程的结果，不一致的刚体逐个输出错误日志。
+ */
+void PhysicsEngine::verifyParallelBodyStep(float dt)
+{
+	auto& bodies = bodies_.arrays();
+	const auto initial = captureBodySteps(bodies);
+	stepBodies(dt, true);
+	const auto parallel_result = captureBodySteps(bodies);
+	restoreBodySteps(bodies, initial);
+	stepBodies(dt, false);
+	const auto serial_result = captureBodySteps(bodies);
+
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		if (parallel_result[i] == serial_result[i]) continue;
+		const auto* owner = bodies.owner[i];
+		spdlog::error("并行物理校验失败：'{}' 的瓦片解析结果与单线程不一致", owner ? owner->getName() : std::string("?"));
+	}
+}
+
+/**
+ * @brief 设置物理步使用的线程数
+ * 
+ * @param thread_count 线程数（含调用线程）
+ */
+void PhysicsEngine::setWorkerThreadCount(size_t thread_count)
+{
+	if (thread_count == getWorkerThreadCount()) return;
+	if (thread_count <= 1) {
+		worker_pool_.reset();
+	}
+	else {
+		worker_pool_ = std::make_unique<engine::core::WorkerPool>(thread_count);
+	}
+	spdlog::info("物理引擎线程数设置为 {}", getWorkerThreadCount());
+}
+
+/**
+ * @brief 根据 Transform 刷新所有刚体的碰撞盒位置
+ */
+void PhysicsEngine::syncBodyPositions()
+{
+	auto& bodies = bodies_.arrays();
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::COLLIDER) == 0u || !bodies.transform[i]) continue;
+		bodies.position[i] = bodies.transform[i]->getPosition() + bodies.aabb_offset[i];
 	}
-	checkObjectCollisions();
-	checkTileTriggers();
 }
 
 /**
@@ -172,136 +825,277 @@ void PhysicsEngine::update(float delta_time)
  * @details 检查所有物理组件之间的碰撞，并处理碰撞响应
  */
 void PhysicsEngine::checkObjectCollisions()
+{
+	buildBroadphaseProxies();
+
+	switch (broadphase_mode_) {
+	case BroadphaseMode::SPATIAL_HASH:
+		spatial_hash_.findPairs(broadphase_proxies_, broadphase_pairs_);
+		break;
+	case BroadphaseMode::SWEEP_AND_PRUNE:
+		sweep_and_prune_.findPairs(broadphase_proxies_, broadphase_pairs_);
+		break;
+	case BroadphaseMode::BRUTE_FORCE:
+	default:
+		findBruteForcePairs(broadphase_pairs_);
+		break;
+	}
+
+	if (verify_broadphase_ && broadphase_mode_ != BroadphaseMode::BRUTE_FORCE) {
+		verifyBroadphasePairs();
+	}
+
+	stats_.broadphase_mode = broadphase_mode_;
+	stats_.proxy_count = broadphase_proxies_.size();
+	stats_.candidate_pairs = broadphase_pairs_.size();
+	stats_.peak_candidate_pairs = std::max(stats_.peak_candidate_pairs, stats_.candidate_pairs);
+	stats_.colliding_pairs = 0;
+
+	// 窄检测的相交测试只读碰撞体，先按候选对分块并行求出结果；
+	// 碰撞响应（唤醒、固体推离、记录碰撞对）仍按候选对顺序单线程执行
+	constexpr std::uint8_t HIT_UNKNOWN = 2;
+	const bool precomputed = chunkCount(broadphase_pairs_.size(), PARALLEL_PAIR_GRAIN) > 1;
+	if (precomputed) {
+		narrowphase_hits_.assign(broadphase_pairs_.size(), HIT_UNKNOWN);
+		moved_proxies_.assign(broadphase_proxies_.size(), 0);
+		parallelFor(broadphase_pairs_.size(), PARALLEL_PAIR_GRAIN, [this](size_t begin, size_t end, size_t /*chunk*/) {
+			for (size_t k = begin; k < end; ++k) {
+				const auto& a = broadphase_proxies_[broadphase_pairs_[k].first];
+				const auto& b = broadphase_proxies_[broadphase_pairs_[k].second];
+				if (a.physics->isSleeping() && b.physics->isSleeping()) continue;
+				narrowphase_hits_[k] = engine::physics::collision::checkCollision(*a.collider, *b.collider) ? 1 : 0;
+			}
+		});
+		if (verify_parallel_) {
+			for (size_t k = 0; k < broadphase_pairs_.size(); ++k) {
+				if (narrowphase_hits_[k] == HIT_UNKNOWN) continue;
+				const auto& a = broadphase_proxies_[broadphase_pairs_[k].first];
+				const auto& b = broadphase_proxies_[broadphase_pairs_[k].second];
+				if ((narrowphase_hits_[k] == 1) != engine::physics::collision::checkCollision(*a.collider, *b.collider)) {
+					spdlog::error("并行物理校验失败：'{}' <-> '{}' 的窄检测结果与单线程不一致", a.owner->getName(), b.owner->getName());
+				}
+			}
+		}
+	}
 
+	// 窄检测：候选对按下标升序，与暴力遍历的处理顺序一致
+	for (size_t k = 0; k < broadphase_pairs_.size(); ++k) {
+		const auto [i, j] = broadphase_pairs_[k];
+		const auto& a = broadphase_proxies_[i];
+		const auto& b = broadphase_proxies_[j];
+		auto* ownerA = a.owner;
+		auto* ownerB = b.owner;
+
+		// 两个休眠物体都没有移动，无需窄检测
+		const bool a_sleeping = a.physics->isSleeping();
+		const bool b_sleeping = b.physics->isSleeping();
+		if (a_sleeping && b_sleeping) continue;
+
+		// 预计算结果在任一方被固体推离过，或并行阶段因双方休眠而跳过时失效，此时重新检测
+		const bool reuse = precomputed && narrowphase_hits_[k] != HIT_UNKNOWN && !moved_proxies_[i] && !moved_proxies_[j];
+		const bool hit = reuse ? narrowphase_hits_[k] == 1
+			: engine::physics::collision::checkCollision(*a.collider, *b.collider);
+		if (hit) {
+			++stats_.colliding_pairs;
+			// 被运动中的物体接触时唤醒
+			if (a_sleeping && b.physics->velocity_ != glm::vec2(0.0f)) a.physics->wakeUp();
+			if (b_sleeping && a.physics->velocity_ != glm::vec2(0.0f)) b.physics->wakeUp();
+			// 运动学刚体无论处于哪个碰撞层都作为固体
+			const bool a_solid = (a.layer & collision_layer::SOLID) != 0u || a.physics->isKinematic();
+			const bool b_solid = (b.layer & collision_layer::SOLID) != 0u || b.physics->isKinematic();
+			if (!a_solid && b_solid) {
+				resolveSolidObjectCollisions(ownerA, ownerB);
+				support_contacts_.add(makePairContactId(a.physics->body_handle_, b.physics->body_handle_), { ownerA, ownerB });
+				if (precomputed) moved_proxies_[i] = 1;
+			}
+			else if (a_solid && !b_solid) {
+				resolveSolidObjectCollisions(ownerB, ownerA);
+				support_contacts_.add(makePairContactId(a.physics->body_handle_, b.physics->body_handle_), { ownerB, ownerA });
+				if (precomputed) moved_proxies_[j] = 1;
+			}
+			else {
+				// 记录碰撞对
+				collision_pairs_.emplace_back(ownerA, ownerB);
+				collision_contacts_.add(makePairContactId(a.physics->body_handle_, b.physics->body_handle_), collision_pairs_.back());
+			}
+		}
+	}
+}
+
+/**
+ * @brief 切换粗检测策略
+ * 
+ * @param mode 新的粗检测策略
+ * @details 切换时重置统计峰值；离开扫描剪枝模式时丢弃其端点列表，避免下次启用时沿用过期顺序。
+ */
+void PhysicsEngine::setBroadphaseMode(BroadphaseMode mode)
 {
-	// 基于 ColliderComponent 的碰撞检测
-	for (size_t i = 0; i < physics_components_.size(); ++i) {
-		auto* pcA = physics_components_[i];
-		if (!pcA || !pcA->isEnabled()) continue;
-		auto* ownerA = pcA->getOwner();
-		if (!ownerA) continue;
-		auto* colA = ownerA->getComponent<engine::component::ColliderComponent>();
-		if (!colA || !colA->getIsActive()) continue;
-		for (size_t j = i + 1; j < physics_components_.size(); ++j) {
-			auto* pcB = physics_components_[j];
-			if (!pcB || !pcB->isEnabled()) continue;
-			auto* ownerB = pcB->getOwner();
-			if (!ownerB) continue;
-			auto* colB = ownerB->getComponent<engine::component::ColliderComponent>();
-			if (!colB || !colB->getIsActive()) continue;
-
-			if (engine::physics::collision::checkCollision(*colA, *colB)) {
-                if (ownerA->getTag() != "solid" && ownerB->getTag() == "solid") {
-                    resolveSolidObjectCollisions(ownerA, ownerB);
-                }
-                else if (ownerA->getTag() == "solid" && ownerB ->getTag() != "solid") {
-                    resolveSolidObjectCollisions(ownerB, ownerA);
-                }
-                else {
-                    // 记录碰撞对
-                    collision_pairs_.emplace_back(ownerA, ownerB);
-                }
+	if (mode == broadphase_mode_) return;
+	if (broadphase_mode_ == BroadphaseMode::SWEEP_AND_PRUNE) {
+		sweep_and_prune_.clear();
+	}
+	broadphase_mode_ = mode;
+	resetStats();
+	spdlog::info("物理引擎粗检测策略切换为 {}", toString(mode));
+}
+
+/**
+ * @brief 收集本帧参与物体碰撞的代理
+ * 
+ * @details 过滤掉未启用的物理组件和未激活的碰撞体，并缓存组件指针与世界 AABB，
+ *          供各粗检测策略共用。
+ */
+void PhysicsEngine::buildBroadphaseProxies()
+{
+	broadphase_proxies_.clear();
+	const auto& bodies = bodies_.arrays();
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::COLLIDER) == 0u || !bodies.owner[i]) continue;
+		auto* collider = bodies.collider[i];
+
+		const glm::vec2 corner = bodies.position[i] + bodies.aabb_size[i];
+		BroadphaseProxy proxy;
+		proxy.physics = bodies.component[i];
+		proxy.owner = bodies.owner[i];
+		proxy.collider = collider;
+		proxy.min = glm::min(bodies.position[i], corner);
+		proxy.max = glm::max(bodies.position[i], corner);
+		proxy.layer = collider->getLayer();
+		proxy.mask = collider->getMask();
+		broadphase_proxies_.push_back(proxy);
+	}
+}
+
+/**
+ * @brief 暴力遍历生成所有候选对
+ * 
+ * @param out_pairs 输出的候选对
+ */
+void PhysicsEngine::findBruteForcePairs(std::vector<BroadphasePair>& out_pairs) const
+{
+	out_pairs.clear();
+	const auto count = static_cast<std::uint32_t>(broadphase_proxies_.size());
+	for (std::uint32_t i = 0; i < count; ++i) {
+		for (std::uint32_t j = i + 1; j < count; ++j) {
+			if (!canCollide(broadphase_proxies_[i], broadphase_proxies_[j])) continue;
+			out_pairs.emplace_back(i, j);
+		}
+	}
+}
+
+/**
+ * @brief 校验当前粗检测策略与暴力遍历得到的相交对是否一致
+ * 
+ * @details 在碰撞响应修改位置之前执行，两边都只做窄检测不做响应。
+ *          若存在差异则输出警告，列出漏检或多出的碰撞对。
+ */
+void PhysicsEngine::verifyBroadphasePairs()
+{
+	auto narrowphase = [this](const std::vector<BroadphasePair>& candidates) {
+		std::vector<BroadphasePair> hits;
+		for (const auto& [i, j] : candidates) {
+			if (engine::physics::collision::checkCollision(*broadphase_proxies_[i].collider, *broadphase_proxies_[j].collider)) {
+				hits.emplace_back(i, j);
 			}
 		}
+		return hits;
+	};
+
+	std::vector<BroadphasePair> reference_pairs;
+	findBruteForcePairs(reference_pairs);
+	const auto expected = narrowphase(reference_pairs);
+	const auto actual = narrowphase(broadphase_pairs_);
+	if (expected == actual) return;
+
+	spdlog::warn("粗检测校验失败：暴力遍历 {} 对，当前策略 {} 对", expected.size(), actual.size());
+	std::vector<BroadphasePair> missing;
+	std::set_difference(expected.begin(), expected.end(), actual.begin(), actual.end(), std::back_inserter(missing));
+	for (const auto& [i, j] : missing) {
+		spdlog::warn("  漏检: '{}' <-> '{}'", broadphase_proxies_[i].owner->getName(), broadphase_proxies_[j].owner->getName());
 	}
 }
 
 /**
- * @brief 获取指定宽度和瓦片类型的瓦片高度
+ * @brief 查找瓦片尺寸对应的斜坡高度表
  * 
- * @param width 瓦片宽度
- * @param type 瓦片类型
  * @param tile_size 瓦片尺寸
- * @return 瓦片高度
- * @details 根据瓦片类型和宽度计算瓦片的高度，用于斜坡碰撞处理
- */
-float PhysicsEngine::getTileHeightAtWidth(float width, engine::component::TileType type, glm::vec2 tile_size)
-{
-	if (tile_size.x <= 0.0f || tile_size.y <= 0.0f) {
-		return 0.0f;
-	}
-	auto relx = glm::clamp(width / tile_size.x, 0.0f, 1.0f);
-    switch (type) {
-    case engine::component::TileType::SLOPE_0_1:
-        return relx * tile_size.y;
-    case engine::component::TileType::SLOPE_1_0:
-        return (1.0f - relx) * tile_size.y;
-    case engine::component::TileType::SLOPE_0_2: // 2x1 slope, first segment (0% -> 50%)
-        return relx * 0.5f * tile_size.y;
-    case engine::component::TileType::SLOPE_2_1: // 2x1 slope, second segment (50% -> 100%)
-        return (0.5f + relx * 0.5f) * tile_size.y;
-    case engine::component::TileType::SLOPE_1_2: // 2x1 descending slope, first segment (100% -> 50%)
-        return (1.0f - relx * 0.5f) * tile_size.y;
-    case engine::component::TileType::SLOPE_2_0: // 2x1 descending slope, second segment (50% -> 0%)
-        return (0.5f - relx * 0.5f) * tile_size.y;
-    default:
-        return 0.0f;
-    }
+ * @return 高度表，未注册过该尺寸的图层时返回 nullptr
+ * @details 只在注册图层时调用；关卡通常只有一两种瓦片尺寸，线性查找即可
+ */
+const SlopeHeightTable* PhysicsEngine::findSlopeTable(const glm::vec2& tile_size) const
+{
+	for (const auto& table : slope_tables_) {
+		if (glm::vec2(table->getTileSize()) == tile_size) return table.get();
+	}
+	return nullptr;
 }
 
 /**
  * @brief 处理瓦片碰撞
  * 
- * @param pc 物理组件
+ * @param body 刚体紧凑下标
  * @param delta_time 时间增量（单位：秒）
- * @details 处理物理组件与瓦片之间的碰撞
+ * @details 处理物理组件与瓦片之间的碰撞。碰撞盒位置与尺寸取自本步收集的 SoA 数据，
+ *          组件指针均已缓存，不再通过 GameObject 查找。
  */
-void PhysicsEngine::resolveTileCollisions(engine::component::PhysicsComponent* pc, float delta_time)
+void PhysicsEngine::resolveTileCollisions(std::uint32_t body, float delta_time)
 {
-    using engine::component::ColliderComponent;
-    using engine::component::TileType;
-    using engine::component::TransformComponent;
+    auto& bodies = bodies_.arrays();
+    auto* pc = bodies.component[body];
+    auto* tc = bodies.transform[body];
 
-    // 1. 基础检查：确保物理组件有效且启用
-    if (!pc || !pc->isEnabled()) {
+    // 1. 基础检查：如果没有碰撞盒或是触发器（不参与物理阻挡），则跳过
+    if (!pc || !tc || !bodies.collider[body] || (bodies.flags[body] & body_flag::TRIGGER) != 0u) {
         return;
     }
 
-    auto* obj = pc->getOwner();
-    if (!obj) {
-        return;
-    }
-    // 2. 获取必要组件：计算位置和碰撞盒
-    auto* tc = obj->getComponent<TransformComponent>();
-    auto* cc = obj->getComponent<ColliderComponent>();
-    // 如果没有碰撞盒、未激活或是触发器（不参与物理阻挡），则跳过
-    if (!tc || !cc || cc->getIsTrigger()) {
-        return;
-    }
+    // 2. 当前未移动前的 AABB 左上角世界坐标与尺寸
+    const glm::vec2 collider_offset = bodies.aabb_offset[body];
+    const glm::vec2 collider_size = bodies.aabb_size[body];
+    glm::vec2 aabb_pos = bodies.position[body];
 
-    // 3. 计算当前的 AABB (轴对齐包围盒)
-    const glm::vec2 collider_offset = cc->getOffset();
-    const glm::vec2 collider_size = cc->getWorldAABB().size;
-
-    // 当前未移动前的 AABB 左上角世界坐标
-    glm::vec2 aabb_pos = tc->getPosition() + collider_offset;
-
-    // ds: 当前帧的位移增量 (velocity * dt)
-    const glm::vec2 ds = pc->velocity_ * delta_time;
+    // ds: 当前帧的位移增量 (velocity * dt)，加上被运动学平台携带的位移
+    glm::vec2 ds = pc->velocity_ * delta_time + bodies.displacement[body];
     // eps: 碰撞检测容差，防止浮点精度问题导致卡在墙内或穿墙
     const float eps = 0.001f;
 	// 如果碰撞体未激活，则直接应用位移并返回
-    if (!cc->getIsActive()) {
+    if ((bodies.flags[body] & body_flag::COLLIDER) == 0u) {
         tc->translate(ds);
+        bodies.position[body] += ds;
         pc->velocity_ = glm::clamp(pc->velocity_, -max_speed_, max_speed_);
         return;
     }
 
-    // 4. 遍历所有注册的瓦片图层进行检测
-    for (auto* layer : tilelayer_components_) {
-        if (!layer || layer->isHidden()) {
-            continue;
-        }
+    // 连续碰撞检测：先对 "solid" 物体做扫掠截断位移，再把超过一个瓦片的位移拆成子步
+    int substeps = 1;
+    if (pc->isCCDEnabled()) {
+        ds = sweepSolidObjects(body, ds);
+        substeps = computeCCDSubsteps(ds);
+    }
+    const glm::vec2 step = ds / static_cast<float>(substeps);
+    bool move_x = step.x != 0.0f;
+    bool move_y = step.y != 0.0f;
+
+    for (int i = 0; i < substeps && (move_x || move_y); ++i) {
+        // 4. 遍历所有注册的瓦片图层进行检测
+        for (const auto& [layer, slopes] : collision_layers_) {
+            if (!layer || layer->isHidden()) {
+                continue;
+            }
 
-        // 5. X 轴碰撞处理
-        if (ds.x != 0.0f) {
-            resolveXAxisCollision(pc, aabb_pos, ds.x, collider_size, layer);
-        }
+            // 5. X 轴碰撞处理
+            if (move_x) {
+                resolveXAxisCollision(pc, aabb_pos, step.x, collider_size, layer, *slopes);
+            }
 
-        // 6. Y 轴碰撞处理
-        if (ds.y != 0.0f) {
-            resolveYAxisCollision(pc, aabb_pos, ds.y, collider_size, layer);
+            // 6. Y 轴碰撞处理
+            if (move_y) {
+                resolveYAxisCollision(pc, aabb_pos, step.y, collider_size, layer, *slopes);
+            }
         }
+        // 某一轴被挡住（速度被清零）后，剩余子步不再沿该轴移动
+        if (pc->velocity_.x == 0.0f) move_x = false;
+        if (pc->velocity_.y == 0.0f) move_y = false;
     }
 
     // 9. World Bounds Check
@@ -332,17 +1126,134 @@ void PhysicsEngine::resolveTileCollisions(engine::component::PhysicsComponent* p
     // 7. 更新 Transform 组件的位置
     // 变换位置 = 计算出的 AABB 位置 - 碰撞器偏移量
     tc->setPosition(aabb_pos - collider_offset);
+    bodies.position[body] = aabb_pos;
 
     // 8. 应用速度限制
     pc->velocity_ = glm::clamp(pc->velocity_, -max_speed_, max_speed_);
 }
 
+/**
+ * @brief 收集本步开始时所有 SOLID 层物体与运动学刚体的 AABB，并建立空间哈希索引
+ * 
+ * @details 只有存在启用 CCD 的物体时才收集，未启用 CCD 的场景不产生额外开销。
+ *          索引建好后在本步内只读，sweepSolidObjects 可在工作线程中并发查询。
+ */
+void PhysicsEngine::collectCCDSolids()
+{
+	ccd_solids_.clear();
+	const auto& bodies = bodies_.arrays();
+	bool any_ccd = false;
+	for (std::uint32_t i = 0; i < bodies.size() && !any_ccd; ++i) {
+		any_ccd = (bodies.flags[i] & body_flag::SIMULATE) != 0u && bodies.component[i]->isCCDEnabled();
+	}
+	if (!any_ccd) return;
+
+	for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+		if ((bodies.flags[i] & body_flag::COLLIDER) == 0u || !bodies.owner[i]) continue;
+		auto* collider = bodies.collider[i];
+		if ((collider->getLayer() & collision_layer::SOLID) == 0u && (bodies.flags[i] & body_flag::KINEMATIC) == 0u) continue;
+
+		const glm::vec2 corner = bodies.position[i] + bodies.aabb_size[i];
+		BroadphaseProxy proxy;
+		proxy.physics = bodies.component[i];
+		proxy.owner = bodies.owner[i];
+		proxy.collider = collider;
+		proxy.min = glm::min(bodies.position[i], corner);
+		proxy.max = glm::max(bodies.position[i], corner);
+		proxy.layer = collider->getLayer();
+		proxy.mask = collider->getMask();
+		ccd_solids_.push_back(proxy);
+	}
+	ccd_grid_.build(ccd_solids_);
+}
+
+/**
+ * @brief 用扫掠 AABB 截断位移，防止高速物体穿过 SOLID 层物体
+ * 
+ * @param body 刚体紧凑下标（AABB 取自本步收集的数据）
+ * @param ds 本步位移
+ * @return 截断后的位移
+ * @details 每轮找出最早接触的 solid 物体，将接触轴上的位移截断到接触点并清零该轴速度，
+ *          另一轴保留剩余位移（贴墙滑动），再进行第二轮以处理另一轴上的接触。
+ *          候选 solid 只从 ccd_grid_ 中按整段位移的扫掠 AABB 查询一次（第二轮位移只会更短），
+ *          候选下标升序，与遍历 ccd_solids_ 的结果一致。
+ *          运动开始时已相交的情况留给 resolveSolidObjectCollisions 的重叠修正处理。
+ */
+glm::vec2 PhysicsEngine::sweepSolidObjects(std::uint32_t body, glm::vec2 ds)
+{
+	thread_local std::vector<std::uint32_t> candidates;
+
+	const auto& bodies = bodies_.arrays();
+	auto* pc = bodies.component[body];
+	auto* owner = bodies.owner[body];
+	if (ccd_solids_.empty() || !owner) return ds;
+	const auto* collider = bodies.collider[body];
+	if (!collider || (collider->getLayer() & collision_layer::SOLID) != 0u || pc->isKinematic()) return ds;
+
+	const glm::vec2 a_min = bodies.position[body];
+	const glm::vec2 a_max = bodies.position[body] + bodies.aabb_size[body];
+	ccd_grid_.query(ccd_solids_, glm::min(a_min, a_min + ds), glm::max(a_max, a_max + ds), collider->getMask(), candidates);
+	for (int pass = 0; pass < 2 && ds != glm::vec2(0.0f); ++pass) {
+		float best_time = 1.0f;
+		int best_axis = -1;
+		for (auto index : candidates) {
+			const auto& solid = ccd_solids_[index];
+			if (solid.owner == owner || !canCollide(collider->getLayer(), collider->getMask(), solid.layer, solid.mask)) continue;
+			float time = 0.0f;
+			int axis = 0;
+			if (!collision::sweepAABB(a_min, a_max, ds, solid.min, solid.max, time, axis)) continue;
+			if (best_axis < 0 || time < best_time) {
+				best_time = time;
+				best_axis = axis;
+			}
+		}
+		if (best_axis < 0) break;
+
+		const bool positive = ds[best_axis] > 0.0f;
+		ds[best_axis] *= best_time;
+		pc->velocity_[best_axis] = 0.0f;
+		if (best_axis == 0) {
+			if (positive) pc->setCollidedRight(true);
+			else pc->setCollidedLeft(true);
+		}
+		else {
+			if (positive) pc->setCollidedBelow(true);
+			else pc->setCollidedAbove(true);
+		}
+	}
+	return ds;
+}
+
+/**
+ * @brief 计算 CCD 子步数
+ * 
+ * @param ds 本步位移
+ * @return 子步数，保证每个子步在各轴上的位移不超过最小瓦片尺寸，且不超过 MAX_CCD_SUBSTEPS
+ */
+int PhysicsEngine::computeCCDSubsteps(const glm::vec2& ds) const
+{
+	glm::vec2 min_tile{ 0.0f, 0.0f };
+	for (auto* layer : tilelayer_components_) {
+		if (!layer || layer->isHidden()) continue;
+		const auto view = layer->getCollisionView();
+		if (!view.isValid()) continue;
+		min_tile.x = (min_tile.x > 0.0f) ? std::min(min_tile.x, view.tile_size.x) : view.tile_size.x;
+		min_tile.y = (min_tile.y > 0.0f) ? std::min(min_tile.y, view.tile_size.y) : view.tile_size.y;
+	}
+	if (min_tile.x <= 0.0f || min_tile.y <= 0.0f) return 1;
+
+	const float ratio = std::max(std::abs(ds.x) / min_tile.x, std::abs(ds.y) / min_tile.y);
+	if (!std::isfinite(ratio) || ratio <= 1.0f) return 1;
+	return std::min(static_cast<int>(std::ceil(ratio)), MAX_CCD_SUBSTEPS);
+}
+
 /**
  * @brief 处理固体对象之间的碰撞
  * 
  * @param move_obj 移动对象
  * @param solid_obj 固体对象
- * @details 处理移动对象与固体对象之间的碰撞
+ * @details 处理移动对象与固体对象之间的碰撞。移动对象被推到运动学刚体上方时记录该刚体，
+ *          下一步开始时随之移动。
  */
 void PhysicsEngine::resolveSolidObjectCollisions(engine::object::GameObject* move_obj, engine::object::GameObject* solid_obj)
 {
@@ -400,6 +1311,9 @@ void PhysicsEngine::resolveSolidObjectCollisions(engine::object::GameObject* mov
             move_pc->setCollidedAbove(true);
         } else {
             move_pc->setCollidedBelow(true);
+            if (const auto* solid_pc = solid_obj->getComponent<engine::component::PhysicsComponent>(); solid_pc && solid_pc->isKinematic()) {
+                move_pc->ground_body_ = solid_pc->body_handle_;
+            }
         }
     }
 }
@@ -412,6 +1326,7 @@ void PhysicsEngine::resolveSolidObjectCollisions(engine::object::GameObject* mov
  * @param dx X轴位移
  * @param collider_size 碰撞器尺寸
  * @param layer 瓦片图层
+ * @param slopes 该图层瓦片尺寸对应的斜坡高度表
  * @details 处理物理组件在X轴方向与瓦片之间的碰撞
  */
 void PhysicsEngine::resolveXAxisCollision(
@@ -419,48 +1334,27 @@ void PhysicsEngine::resolveXAxisCollision(
     glm::vec2& aabb_pos,
     float dx,
     const glm::vec2& collider_size,
-    engine::component::TileLayerComponent* layer)
+    engine::component::TileLayerComponent* layer,
+    const SlopeHeightTable& slopes)
 {
     using engine::component::TileType;
 
-    const glm::vec2 tile_size_vec = layer->getTileSize();
-    if (tile_size_vec.x <= 0.0f || tile_size_vec.y <= 0.0f) return;
-    
-    // 计算图层的世界坐标偏移
-    glm::vec2 layer_offset = layer->getOffset();
-    if (auto* layer_owner = layer->getOwner()) {
-        if (auto* layer_tc = layer_owner->getComponent<engine::component::TransformComponent>()) {
-            layer_offset += layer_tc->getPosition();
-        }
-    }
+    // 使用紧凑碰撞视图：世界偏移已缓存，类型读取为连续 uint8_t
+    const auto view = layer->getCollisionView();
+    if (!view.isValid()) return;
+    const glm::vec2 tile_size_vec = view.tile_size;
+    const glm::vec2 layer_offset = view.world_offset;
 
-    const int layer_width = layer->getMapSize().x;
-    const int layer_height = layer->getMapSize().y;
-    const float eps = 0.001f;
+    // SOLID 由加载时合并的静态矩形处理，斜坡仍逐格处理（表面高度查预计算的逐像素高度表）
+    const auto* statics = layer->getStaticColliders();
+    if (!statics) return;
 
-    auto getTypeAt = [&](int tx, int ty) -> TileType {
-        if (tx < 0 || ty < 0 || tx >= layer_width || ty >= layer_height) {
-            return TileType::EMPTY;
-        }
-        return layer->getTileTypeAt({ tx, ty });
-    };
-
-    auto isSolid = [&](int tx, int ty) {
-        return getTypeAt(tx, ty) == TileType::SOLID;
-    };
+    const int layer_width = view.map_size.x;
+    const int layer_height = view.map_size.y;
+    const float eps = 0.001f;
 
-    auto isSlope = [&](TileType t) {
-        switch (t) {
-        case TileType::SLOPE_0_1:
-        case TileType::SLOPE_1_0:
-        case TileType::SLOPE_0_2:
-        case TileType::SLOPE_2_1:
-        case TileType::SLOPE_1_2:
-        case TileType::SLOPE_2_0:
-            return true;
-        default:
-            return false;
-        }
+    auto getTypeAt = [&view](int tx, int ty) -> TileType {
+        return view.at(tx, ty);
     };
     
     if (dx == 0.0f) return;
@@ -471,7 +1365,6 @@ void PhysicsEngine::resolveXAxisCollision(
     // Y-range indices
     const float top = new_pos.y + eps;
     const float bottom = new_pos.y + collider_size.y - eps;
-    const int tile_y_top = static_cast<int>(std::floor((top - layer_offset.y) / tile_size_vec.y));
     const int tile_y_bottom = static_cast<int>(std::floor((bottom - layer_offset.y) / tile_size_vec.y));
 
     if (dx > 0.0f) {
@@ -479,20 +1372,23 @@ void PhysicsEngine::resolveXAxisCollision(
         const float right = new_pos.x + collider_size.x - eps;
         const int tile_x = static_cast<int>(std::floor((right - layer_offset.x) / tile_size_vec.x));
 
-        if (tile_x >= 0 && tile_x < layer_width) {
-            bool hit = false;
-            bool hit_top = false;
-            bool hit_bottom = false;
-            
-            if (tile_y_top >= 0 && tile_y_top < layer_height && isSolid(tile_x, tile_y_top)) { hit = true; hit_top = true; }
-            if (tile_y_bottom >= 0 && tile_y_bottom < layer_height && isSolid(tile_x, tile_y_bottom)) { hit = true; hit_bottom = true; }
+        // 在合并矩形中扫掠前沿：覆盖整个碰撞体高度，且不会因单步位移过大而跳过整格
+        const auto block = findStaticBlock(*statics, 0,
+            aabb_pos.x + collider_size.x - eps - layer_offset.x, right - layer_offset.x,
+            top - layer_offset.y, bottom - layer_offset.y, tile_size_vec.x, false);
+
+        {
+            bool hit = block.hit;
+            // 仅底部一行被挡（可能是斜坡顶端接平地）
+            const bool bottom_row_only = block.covers_band_max &&
+                block.perp_min >= static_cast<float>(tile_y_bottom) * tile_size_vec.y - eps;
 
             // Slope transition (Up-Right)
-            if (hit && hit_bottom && !hit_top) {
+            if (hit && bottom_row_only && tile_x >= 0 && tile_x < layer_width) {
                  int curr_tx = static_cast<int>(std::floor((aabb_pos.x + collider_size.x - eps - layer_offset.x) / tile_size_vec.x));
                  TileType ct = getTypeAt(curr_tx, tile_y_bottom);
-                 if (isSlope(ct)) {
-                      float h = getTileHeightAtWidth(tile_size_vec.x, ct, tile_size_vec);
+                 if (isSlopeTile(ct)) {
+                      float h = slopes.heightAt(ct, tile_size_vec.x);
                       float ground_y = layer_offset.y + static_cast<float>(tile_y_bottom + 1) * tile_size_vec.y - h;
                       float solid_top = layer_offset.y + static_cast<float>(tile_y_bottom) * tile_size_vec.y;
                       if (ground_y <= solid_top + eps) {
@@ -503,16 +1399,16 @@ void PhysicsEngine::resolveXAxisCollision(
             }
 
             if (hit) {
-                new_pos.x = layer_offset.x + static_cast<float>(tile_x) * tile_size_vec.x - collider_size.x;
+                new_pos.x = layer_offset.x + block.stop - collider_size.x;
                 pc->velocity_.x = 0.0f;
                 pc->setCollidedRight(true);
-            } else if (tile_y_bottom >= 0 && tile_y_bottom < layer_height) {
+            } else if (tile_x >= 0 && tile_x < layer_width && tile_y_bottom >= 0 && tile_y_bottom < layer_height) {
                 // Check if walked INTO slope (embedded)
                 TileType t = getTypeAt(tile_x, tile_y_bottom);
-                if (isSlope(t)) {
+                if (isSlopeTile(t)) {
                     float tile_origin_x = layer_offset.x + static_cast<float>(tile_x) * tile_size_vec.x;
                     float rel_x = (new_pos.x + collider_size.x - eps) - tile_origin_x;
-                    float h = getTileHeightAtWidth(rel_x, t, tile_size_vec);
+                    float h = slopes.heightAt(t, rel_x);
                     float ground_y = layer_offset.y + static_cast<float>(tile_y_bottom + 1) * tile_size_vec.y - h;
                     if (new_pos.y + collider_size.y >= ground_y - eps) {
                          new_pos.y = ground_y - collider_size.y;
@@ -527,20 +1423,21 @@ void PhysicsEngine::resolveXAxisCollision(
         const float left = new_pos.x + eps;
         const int tile_x = static_cast<int>(std::floor((left - layer_offset.x) / tile_size_vec.x));
         
-        if (tile_x >= 0 && tile_x < layer_width) {
-             bool hit = false;
-             bool hit_top = false;
-             bool hit_bottom = false;
-             
-             if (tile_y_top >= 0 && tile_y_top < layer_height && isSolid(tile_x, tile_y_top)) { hit = true; hit_top = true; }
-             if (tile_y_bottom >= 0 && tile_y_bottom < layer_height && isSolid(tile_x, tile_y_bottom)) { hit = true; hit_bottom = true; }
+        const auto block = findStaticBlock(*statics, 0,
+            aabb_pos.x + eps - layer_offset.x, left - layer_offset.x,
+            top - layer_offset.y, bottom - layer_offset.y, tile_size_vec.x, false);
+
+        {
+             bool hit = block.hit;
+             const bool bottom_row_only = block.covers_band_max &&
+                 block.perp_min >= static_cast<float>(tile_y_bottom) * tile_size_vec.y - eps;
 
              // Slope transition (Up-Left)
-             if (hit && hit_bottom && !hit_top) {
+             if (hit && bottom_row_only && tile_x >= 0 && tile_x < layer_width) {
                  int curr_tx = static_cast<int>(std::floor((aabb_pos.x + eps - layer_offset.x) / tile_size_vec.x));
                  TileType ct = getTypeAt(curr_tx, tile_y_bottom);
-                 if (isSlope(ct)) {
-                      float h = getTileHeightAtWidth(0.0f, ct, tile_size_vec);
+                 if (isSlopeTile(ct)) {
+                      float h = slopes.heightAt(ct, 0.0f);
                       float ground_y = layer_offset.y + static_cast<float>(tile_y_bottom + 1) * tile_size_vec.y - h;
                       float solid_top = layer_offset.y + static_cast<float>(tile_y_bottom) * tile_size_vec.y;
                       if (ground_y <= solid_top + eps) {
@@ -551,16 +1448,16 @@ void PhysicsEngine::resolveXAxisCollision(
              }
 
               if (hit) {
-                  new_pos.x = layer_offset.x + static_cast<float>(tile_x + 1) * tile_size_vec.x;
+                  new_pos.x = layer_offset.x + block.stop;
                   pc->velocity_.x = 0.0f;
                   pc->setCollidedLeft(true);
-              } else if (tile_y_bottom >= 0 && tile_y_bottom < layer_height) {
+              } else if (tile_x >= 0 && tile_x < layer_width && tile_y_bottom >= 0 && tile_y_bottom < layer_height) {
                   // Slope embedding check
                   TileType t = getTypeAt(tile_x, tile_y_bottom);
-                  if (isSlope(t)) {
+                  if (isSlopeTile(t)) {
                       float tile_origin_x = layer_offset.x + static_cast<float>(tile_x) * tile_size_vec.x;
                       float rel_x = (new_pos.x + eps) - tile_origin_x;
-                      float h = getTileHeightAtWidth(rel_x, t, tile_size_vec);
+                      float h = slopes.heightAt(t, rel_x);
                       float ground_y = layer_offset.y + static_cast<float>(tile_y_bottom + 1) * tile_size_vec.y - h;
                       if (new_pos.y + collider_size.y >= ground_y - eps) {
                           new_pos.y = ground_y - collider_size.y;
@@ -582,6 +1479,7 @@ void PhysicsEngine::resolveXAxisCollision(
  * @param dy Y轴位移
  * @param collider_size 碰撞器尺寸
  * @param layer 瓦片图层
+ * @param slopes 该图层瓦片尺寸对应的斜坡高度表
  * @details 处理物理组件在Y轴方向与瓦片之间的碰撞
  */
 void PhysicsEngine::resolveYAxisCollision(
@@ -589,52 +1487,33 @@ void PhysicsEngine::resolveYAxisCollision(
     glm::vec2& aabb_pos,
     float dy,
     const glm::vec2& collider_size,
-    engine::component::TileLayerComponent* layer)
+    engine::component::TileLayerComponent* layer,
+    const SlopeHeightTable& slopes)
 {
     using engine::component::TileType;
-    const glm::vec2 tile_size_vec = layer->getTileSize();
-    if (tile_size_vec.x <= 0.0f || tile_size_vec.y <= 0.0f) return;
+    const auto view = layer->getCollisionView();
+    if (!view.isValid()) return;
+    const glm::vec2 tile_size_vec = view.tile_size;
+    const glm::vec2 layer_offset = view.world_offset;
 
-    glm::vec2 layer_offset = layer->getOffset();
-    if (auto* layer_owner = layer->getOwner()) {
-        if (auto* layer_tc = layer_owner->getComponent<engine::component::TransformComponent>()) {
-            layer_offset += layer_tc->getPosition();
-        }
-    }
-    const int layer_width = layer->getMapSize().x;
-    const int layer_height = layer->getMapSize().y;
+    // SOLID / UNISOLID 由加载时合并的静态矩形处理，斜坡与梯子顶端仍逐格处理
+    const auto* statics = layer->getStaticColliders();
+    if (!statics) return;
+
+    const int layer_width = view.map_size.x;
+    const int layer_height = view.map_size.y;
     const float eps = 0.001f;
 
-    auto getTypeAt = [&](int tx, int ty) -> TileType {
-        if (tx < 0 || ty < 0 || tx >= layer_width || ty >= layer_height) return TileType::EMPTY;
-        return layer->getTileTypeAt({ tx, ty });
+    auto getTypeAt = [&view](int tx, int ty) -> TileType {
+        return view.at(tx, ty);
     };
 
-    auto isSolid = [&](int tx, int ty) {
-        return getTypeAt(tx, ty) == TileType::SOLID;
+    // 如果是梯子顶端，且玩家不在攀爬状态，则视为单向平台（支持在梯子顶端站立和走过）
+    auto isLadderTop = [&](int tx, int ty) {
+        return getTypeAt(tx, ty) == TileType::LADDER && !pc->isClimbing() && getTypeAt(tx, ty - 1) != TileType::LADDER;
     };
      auto isUnisolid = [&](int tx, int ty) {
-        TileType type = getTypeAt(tx, ty);
-        if (type == TileType::UNISOLID) return true;
-        // 如果是梯子顶端，且玩家不在攀爬状态，则视为单向平台（支持在梯子顶端站立和走过）
-        if (type == TileType::LADDER && !pc->isClimbing()) {
-            if (getTypeAt(tx, ty - 1) != TileType::LADDER) return true;
-        }
-        return false;
-    };
-
-    auto isSlope = [&](TileType t) {
-        switch (t) {
-        case TileType::SLOPE_0_1:
-        case TileType::SLOPE_1_0:
-        case TileType::SLOPE_0_2:
-        case TileType::SLOPE_2_1:
-        case TileType::SLOPE_1_2:
-        case TileType::SLOPE_2_0:
-            return true;
-        default:
-            return false;
-        }
+        return getTypeAt(tx, ty) == TileType::UNISOLID || isLadderTop(tx, ty);
     };
 
     if (dy == 0.0f) return;
@@ -651,17 +1530,31 @@ void PhysicsEngine::resolveYAxisCollision(
         // vvv Moving Down (Falling)
         const float bottom = new_pos.y + collider_size.y - eps;
         const int tile_y = static_cast<int>(std::floor((bottom - layer_offset.y) / tile_size_vec.y));
-        
+
+        // 合并矩形（SOLID + UNISOLID）沿 Y 扫掠，覆盖碰撞体整个宽度
+        const auto block = findStaticBlock(*statics, 1,
+            aabb_pos.y + collider_size.y - eps - layer_offset.y, bottom - layer_offset.y,
+            left - layer_offset.x, right - layer_offset.x, tile_size_vec.y, true);
+        bool hit = block.hit;
+        float stop = block.stop;
+
         if (tile_y >= 0 && tile_y < layer_height) {
-            bool hit = false;
-            if (tile_x_left >= 0 && tile_x_left < layer_width && (isSolid(tile_x_left, tile_y) || isUnisolid(tile_x_left, tile_y))) hit = true;
-            if (tile_x_right >= 0 && tile_x_right < layer_width && (isSolid(tile_x_right, tile_y) || isUnisolid(tile_x_right, tile_y))) hit = true;
+            if ((tile_x_left >= 0 && tile_x_left < layer_width && isLadderTop(tile_x_left, tile_y)) ||
+                (tile_x_right >= 0 && tile_x_right < layer_width && isLadderTop(tile_x_right, tile_y))) {
+                const float ladder_top = static_cast<float>(tile_y) * tile_size_vec.y;
+                if (!hit || ladder_top < stop) {
+                    stop = ladder_top;
+                    hit = true;
+                }
+            }
+        }
 
-            if (hit) {
-                new_pos.y = layer_offset.y + static_cast<float>(tile_y) * tile_size_vec.y - collider_size.y;
-                pc->velocity_.y = 0.0f;
-                pc->setCollidedBelow(true);
-			} else {
+        if (hit) {
+            new_pos.y = layer_offset.y + stop - collider_size.y;
+            pc->velocity_.y = 0.0f;
+            pc->setCollidedBelow(true);
+        }
+        else if (tile_y >= 0 && tile_y < layer_height) {
 				// 吸附逻辑 (Stickiness)：处理斜坡和单向平台（包含梯子顶端）
 				// 起跳和向上运动期间禁用吸附，避免被斜坡重新“拽回地面”产生滑行/贴地。
 				// 某些情况下（例如同时按左右触发额外的水平碰撞修正），会产生很小的向下 dy，导致误触发吸附。
@@ -676,10 +1569,11 @@ void PhysicsEngine::resolveYAxisCollision(
                 auto checkSnapTarget = [&](int tx, int ty) {
                     if (tx < 0 || tx >= layer_width || ty < 0 || ty >= layer_height) return;
                     TileType t = getTypeAt(tx, ty);
-                    if (isSlope(t)) {
+                    if (isSlopeTile(t)) {
                         float tile_x_origin = layer_offset.x + static_cast<float>(tx) * tile_size_vec.x;
-                        float h_left = getTileHeightAtWidth(glm::clamp((new_pos.x + eps) - tile_x_origin, 0.0f, tile_size_vec.x), t, tile_size_vec);
-                        float h_right = getTileHeightAtWidth(glm::clamp((new_pos.x + collider_size.x - eps) - tile_x_origin, 0.0f, tile_size_vec.x), t, tile_size_vec);
+                        // heightAt 会把超出瓦片的横坐标夹到边缘
+                        float h_left = slopes.heightAt(t, (new_pos.x + eps) - tile_x_origin);
+                        float h_right = slopes.heightAt(t, (new_pos.x + collider_size.x - eps) - tile_x_origin);
                         float h = std::max(h_left, h_right);
                         
                         float g_y = layer_offset.y + static_cast<float>(ty + 1) * tile_size_vec.y - h;
@@ -711,21 +1605,17 @@ void PhysicsEngine::resolveYAxisCollision(
                         pc->setCollidedBelow(true);
                     }
                 }
-            }
         }
     } else {
         // ^^^ Moving Up (Jumping)
         const float top = new_pos.y + eps;
-        const int tile_y = static_cast<int>(std::floor((top - layer_offset.y) / tile_size_vec.y));
-        if (tile_y >= 0 && tile_y < layer_height) {
-             bool hit = false;
-             if (tile_x_left >= 0 && tile_x_left < layer_width && isSolid(tile_x_left, tile_y)) hit = true;
-             if (tile_x_right >= 0 && tile_x_right < layer_width && isSolid(tile_x_right, tile_y)) hit = true;
-             if (hit) {
-                 new_pos.y = layer_offset.y + static_cast<float>(tile_y + 1) * tile_size_vec.y;
-                 pc->velocity_.y = 0.0f;
-                 pc->setCollidedAbove(true);
-             }
+        const auto block = findStaticBlock(*statics, 1,
+            aabb_pos.y + eps - layer_offset.y, top - layer_offset.y,
+            left - layer_offset.x, right - layer_offset.x, tile_size_vec.y, false);
+        if (block.hit) {
+            new_pos.y = layer_offset.y + block.stop;
+            pc->velocity_.y = 0.0f;
+            pc->setCollidedAbove(true);
         }
     }
     aabb_pos.y = new_pos.y;
@@ -734,51 +1624,83 @@ void PhysicsEngine::resolveYAxisCollision(
 /**
  * @brief 检查瓦片触发器
  * 
- * @details 检查物理组件与瓦片触发器之间的碰撞
+ * @details 检查物理组件与瓦片触发器之间的碰撞。按刚体分块并行收集，各块事件按块号顺序合并，
+ *          因此事件顺序与单线程按紧凑下标遍历一致。
  */
 void PhysicsEngine::checkTileTriggers()
 {
-    for (auto* pc : physics_components_) {
-        if (!pc || !pc->isEnabled()) continue;
-        
-        auto* obj = pc->getOwner();
-        if (!obj) continue;
+    const size_t body_count = bodies_.size();
+    trigger_chunks_.resize(std::max<size_t>(chunkCount(body_count, PARALLEL_BODY_GRAIN), 1));
+    for (auto& events : trigger_chunks_) events.clear();
+
+    parallelFor(body_count, PARALLEL_BODY_GRAIN, [this](size_t begin, size_t end, size_t chunk) {
+        collectTileTriggers(begin, end, trigger_chunks_[chunk]);
+    });
+    const auto& bodies = bodies_.arrays();
+    for (const auto& triggers : trigger_chunks_) {
+        for (const auto& [body, type] : triggers) {
+            tile_trigger_events_.emplace_back(bodies.owner[body], type);
+            tile_trigger_contacts_.add(makeTileContactId(bodies.component[body]->body_handle_, type), tile_trigger_events_.back());
+        }
+    }
 
-        auto* cc = obj->getComponent<engine::component::ColliderComponent>();
-        if (!cc || !cc->getIsActive()) continue;
+    if (verify_parallel_ && worker_pool_) {
+        std::vector<std::pair<std::uint32_t, engine::component::TileType>> expected;
+        collectTileTriggers(0, body_count, expected);
+        size_t actual_count = 0;
+        bool same = true;
+        for (const auto& triggers : trigger_chunks_) {
+            for (const auto& trigger : triggers) {
+                same = same && actual_count < expected.size() && expected[actual_count] == trigger;
+                ++actual_count;
+            }
+        }
+        if (!same || actual_count != expected.size()) {
+            spdlog::error("并行物理校验失败：瓦片触发事件 单线程 {} 个，并行 {} 个", expected.size(), actual_count);
+        }
+    }
+}
 
-        const auto world_aabb = cc->getWorldAABB();
+/**
+ * @brief 收集指定区间内刚体接触到的瓦片触发器
+ * 
+ * @param begin 起始紧凑下标
+ * @param end 结束紧凑下标（不含）
+ * @param out_triggers 追加输出的 (刚体紧凑下标, 瓦片类型)
+ */
+void PhysicsEngine::collectTileTriggers(size_t begin, size_t end,
+    std::vector<std::pair<std::uint32_t, engine::component::TileType>>& out_triggers) const
+{
+    const auto& bodies = bodies_.arrays();
+    for (size_t i = begin; i < end; ++i) {
+        auto* pc = bodies.component[i];
+        // 休眠状态可能在窄检测中被唤醒，因此直接读取组件而不是本步的 SLEEPING 标志
+        if ((bodies.flags[i] & body_flag::COLLIDER) == 0u || pc->isSleeping()) continue;
+
+        auto* obj = bodies.owner[i];
+        if (!obj) continue;
+
+        const glm::vec2 aabb_min = bodies.position[i];
+        const glm::vec2 aabb_max = bodies.position[i] + bodies.aabb_size[i];
         // 使用 set 防止同一帧内由于接触多个同类瓦片而重复触发相同事件
         std::set<engine::component::TileType> triggers_set;
 
         for (auto* layer : tilelayer_components_) {
             if (!layer || layer->isHidden()) continue;
 
-            const glm::vec2 tile_size = layer->getTileSize();
-            if (tile_size.x <= 0.0f || tile_size.y <= 0.0f) continue;
+            const auto view = layer->getCollisionView();
+            if (!view.isValid()) continue;
 
-            // 计算图层世界坐标偏移
-            glm::vec2 layer_offset = layer->getOffset();
-            if (auto* layer_owner = layer->getOwner()) {
-                if (auto* layer_tc = layer_owner->getComponent<engine::component::TransformComponent>()) {
-                    layer_offset += layer_tc->getPosition();
-                }
-            }
-
-            // 计算物体覆盖的瓦片索引范围
-            int start_x = static_cast<int>(std::floor((world_aabb.position.x - layer_offset.x) / tile_size.x));
-            int end_x   = static_cast<int>(std::floor((world_aabb.position.x + world_aabb.size.x - layer_offset.x) / tile_size.x));
-            int start_y = static_cast<int>(std::floor((world_aabb.position.y - layer_offset.y) / tile_size.y));
-            int end_y   = static_cast<int>(std::floor((world_aabb.position.y + world_aabb.size.y - layer_offset.y) / tile_size.y));
-
-            const auto map_size = layer->getMapSize();
-
-            for (int x = start_x; x <= end_x; ++x) {
-                if (x < 0 || x >= map_size.x) continue;
-                for (int y = start_y; y <= end_y; ++y) {
-                    if (y < 0 || y >= map_size.y) continue;
+            // 计算物体覆盖的瓦片索引范围，并裁剪到地图范围内
+            const int start_x = std::max(view.toTileX(aabb_min.x), 0);
+            const int end_x   = std::min(view.toTileX(aabb_max.x), view.map_size.x - 1);
+            const int start_y = std::max(view.toTileY(aabb_min.y), 0);
+            const int end_y   = std::min(view.toTileY(aabb_max.y), view.map_size.y - 1);
 
-                    auto tile_type = layer->getTileTypeAt({ x, y });
+            // 行优先遍历，与网格存储顺序一致
+            for (int y = start_y; y <= end_y; ++y) {
+                for (int x = start_x; x <= end_x; ++x) {
+                    auto tile_type = view.at(x, y);
                     // 目前检测 HAZARD 类型，可根据需要扩展其它触发器类型
                     if (tile_type == engine::component::TileType::HAZARD) {
                         triggers_set.insert(tile_type);
@@ -789,9 +1711,203 @@ void PhysicsEngine::checkTileTriggers()
 
         // 将本帧触发的所有唯一类型的事件记录下来
         for (const auto& type : triggers_set) {
-            tile_trigger_events_.emplace_back(obj, type);
+            out_triggers.emplace_back(static_cast<std::uint32_t>(i), type);
         }
     }
 }
 
+/**
+ * @brief 启用或关闭自动休眠
+ * 
+ * @param enable 是否启用
+ */
+void PhysicsEngine::setSleepEnabled(bool enable)
+{
+	if (enable == sleep_enabled_) return;
+	sleep_enabled_ = enable;
+	if (!enable) {
+		wakeAll();
+	}
+	spdlog::info("物理引擎自动休眠已{}", enable ? "启用" : "关闭");
+}
+
+/**
+ * @brief 设置休眠条件
+ * 
+ * @param velocity_threshold 速度阈值
+ * @param force_threshold 外力阈值
+ * @param steps 连续静止步数
+ */
+void PhysicsEngine::setSleepThresholds(float velocity_threshold, float force_threshold, int steps)
+{
+	if (velocity_threshold < 0.0f || force_threshold < 0.0f || steps <= 0) {
+		spdlog::warn("无效的休眠参数: 速度 {}, 外力 {}, 步数 {}", velocity_threshold, force_threshold, steps);
+		return;
+	}
+	sleep_velocity_threshold_ = velocity_threshold;
+	sleep_force_threshold_ = force_threshold;
+	sleep_steps_ = steps;
+}
+
+/**
+ * @brief 判断休眠物体是否需要唤醒
+ * 
+ * @param pc 物理组件
+ * @return 需要唤醒返回 true
+ * @details 游戏逻辑可能直接写 velocity_ 字段或直接移动 Transform，这两种情况无法在写入时拦截，
+ *          因此在每步开始时检查：速度或外力不为零、位置与入睡时不同都会唤醒。
+ */
+bool PhysicsEngine::shouldWake(const engine::component::PhysicsComponent* pc) const
+{
+	if (!sleep_enabled_ || !pc->isSleepAllowed()) return true;
+	if (pc->velocity_ != glm::vec2(0.0f) || pc->getForce() != glm::vec2(0.0f)) return true;
+	const auto* tc = pc->getTransform();
+	return tc && tc->getPosition() != pc->sleep_position_;
+}
+
+/**
+ * @brief 更新休眠状态并统计活动/休眠物体数
+ * 
+ * @details 在碰撞响应之后执行，此时速度已经过瓦片与固体物体的修正。
+ *          各轴速度连续 sleep_steps_ 步低于阈值的物体进入休眠，速度清零并记录位置。
+ */
+void PhysicsEngine::updateSleepStates()
+{
+	stats_.awake_bodies = 0;
+	stats_.sleeping_bodies = 0;
+	for (auto* pc : bodies_.arrays().component) {
+		if (!pc || !pc->isEnabled()) continue;
+
+		if (!pc->sleeping_) {
+			const glm::vec2 speed = glm::abs(pc->velocity_);
+			// 站在运动学刚体上的物体随平台移动，不进入休眠
+			const bool resting = speed.x < sleep_velocity_threshold_ && speed.y < sleep_velocity_threshold_ && !pc->ground_body_.isValid();
+			if (sleep_enabled_ && pc->isSleepAllowed() && !pc->isKinematic() && resting) {
+				if (++pc->rest_steps_ >= sleep_steps_) {
+					pc->sleeping_ = true;
+					pc->velocity_ = glm::vec2(0.0f);
+					if (const auto* tc = pc->getTransform()) {
+						pc->sleep_position_ = tc->getPosition();
+					}
+				}
+			}
+			else {
+				pc->rest_steps_ = 0;
+			}
+		}
+
+		if (pc->sleeping_) {
+			++stats_.sleeping_bodies;
+		}
+		else {
+			++stats_.awake_bodies;
+		}
+	}
+}
+
+/**
+ * @brief 生成物体对的接触标识
+ *
+ * @details 按槽位下标排序，保证同一对物体无论检测顺序如何都得到相同标识。
+ */
+ContactId PhysicsEngine::makePairContactId(BodyHandle a, BodyHandle b)
+{
+	if (b.index < a.index) std::swap(a, b);
+	return ContactId{
+		(static_cast<std::uint64_t>(a.index) << 32) | b.index,
+		(static_cast<std::uint64_t>(a.generation) << 32) | b.generation
+	};
+}
+
+/**
+ * @brief 生成物体与瓦片类型的接触标识
+ */
+ContactId PhysicsEngine::makeTileContactId(BodyHandle body, engine::component::TileType type)
+{
+	return ContactId{
+		(static_cast<std::uint64_t>(body.index) << 32) | static_cast<std::uint32_t>(type),
+		body.generation
+	};
+}
+
+/**
+ * @brief 从物体对的接触标识还原两个刚体句柄
+ */
+std::pair<BodyHandle, BodyHandle> PhysicsEngine::pairContactBodies(const ContactId& id)
+{
+	return {
+		BodyHandle{ static_cast<std::uint32_t>(id.key >> 32), static_cast<std::uint32_t>(id.generations >> 32) },
+		BodyHandle{ static_cast<std::uint32_t>(id.key), static_cast<std::uint32_t>(id.generations) }
+	};
+}
+
+/**
+ * @brief 判断句柄对应的刚体是否处于休眠状态（句柄失效时返回 false）
+ */
+bool PhysicsEngine::isBodySleeping(BodyHandle handle) const
+{
+	const auto index = bodies_.indexOf(handle);
+	if (index == BodyHandle::INVALID_INDEX) return false;
+	const auto* pc = bodies_.arrays().component[index];
+	return pc && pc->isSleeping();
+}
+
+/**
+ * @brief 将本步的物体碰撞与瓦片触发分类为 Enter / Stay / Exit
+ *
+ * @details 已注销物体的接触直接丢弃，不产生 Exit；休眠物体本步没有参与检测，
+ *          其上一步的接触保持为 Stay（物体对要求双方都在休眠）。
+ */
+void PhysicsEngine::updateContactEvents()
+{
+	const auto pair_alive = [this](const ContactId& id) {
+		const auto [a, b] = pairContactBodies(id);
+		return bodies_.isValid(a) && bodies_.isValid(b);
+	};
+	const auto pair_frozen = [this](const ContactId& id) {
+		const auto [a, b] = pairContactBodies(id);
+		return isBodySleeping(a) && isBodySleeping(b);
+	};
+	collision_contacts_.endStep(pair_alive, pair_frozen);
+	support_contacts_.endStep(pair_alive, pair_frozen);
+
+	tile_trigger_contacts_.endStep(
+		[this](const ContactId& id) {
+			return bodies_.isValid(BodyHandle{ static_cast<std::uint32_t>(id.key >> 32), static_cast<std::uint32_t>(id.generations) });
+		},
+		[this](const ContactId& id) {
+			return isBodySleeping(BodyHandle{ static_cast<std::uint32_t>(id.key >> 32), static_cast<std::uint32_t>(id.generations) });
+		});
+}
+
+/**
+ * @brief 唤醒上一步与指定刚体接触的物体
+ *
+ * @param handle 刚体句柄（可以是刚注销的）
+ * @details 包括普通碰撞对与固体支撑（站在其上、被其推挡）的接触。双方都在休眠的接触被保留在缓存中，
+ *          因此靠它支撑而入睡的物体也能找到。只遍历接触缓存，与刚体总数无关。
+ */
+void PhysicsEngine::wakeContactsOf(BodyHandle handle)
+{
+	const auto wake_other = [this, handle](const ContactId& id) {
+		const auto [a, b] = pairContactBodies(id);
+		const BodyHandle other = a == handle ? b : (b == handle ? a : BodyHandle{});
+		const auto index = bodies_.indexOf(other);
+		if (index == BodyHandle::INVALID_INDEX) return;
+		if (auto* pc = bodies_.arrays().component[index]) pc->wakeUp();
+	};
+	collision_contacts_.forEachContact(wake_other);
+	support_contacts_.forEachContact(wake_other);
+}
+
+/**
+ * @brief 唤醒所有休眠物体
+ */
+void PhysicsEngine::wakeAll()
+{
+	for (auto* pc : bodies_.arrays().component) {
+		if (pc) pc->wakeUp();
+	}
+}
+
 } // namespace engine::physics
\ No newline at end of file
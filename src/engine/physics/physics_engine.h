@@ -1,8 +1,15 @@
 #pragma once
 #include <vector>
+#include <memory>
 #include <glm/vec2.hpp>
 #include "../component/tilelayer_component.h"
 #include "../utils/math.h"
+#include "broadphase.h"
+#include "body_storage.h"
+#include "physics_query.h"
+#include "contact_cache.h"
+#include "slope_table.h"
+#include "../core/worker_pool.h"
 namespace engine {
 	namespace object {
 		class GameObject;
@@ -12,6 +19,20 @@ namespace engine {
 	}
 }
 namespace engine::physics {
+	/**
+	 * @struct PhysicsStats
+	 * @brief 物理引擎每步的统计信息，用于性能分析和为关卡选择合适的粗检测策略。
+	 */
+	struct PhysicsStats {
+		BroadphaseMode broadphase_mode = BroadphaseMode::SPATIAL_HASH; ///< 上一步使用的粗检测策略
+		size_t proxy_count = 0;                                         ///< 参与物体碰撞的代理数
+		size_t candidate_pairs = 0;                                     ///< 粗检测输出的候选对数
+		size_t colliding_pairs = 0;                                     ///< 窄检测确认相交的对数
+		size_t peak_candidate_pairs = 0;                                ///< 自上次重置以来候选对数的峰值
+		size_t awake_bodies = 0;                                        ///< 上一步结束时处于活动状态的物体数
+		size_t sleeping_bodies = 0;                                     ///< 上一步结束时处于休眠状态的物体数
+	};
+
 	/**
 	 * @class PhysicsEngine
 	 * @brief 物理引擎类，负责管理和更新物理组件
@@ -20,16 +41,60 @@ namespace engine::physics {
 	 */
 	class PhysicsEngine {
 	private:
-		std::vector<component::PhysicsComponent*> physics_components_;
+		BodyStorage bodies_;                                             ///< 已注册刚体（SoA 存储，按紧凑下标遍历）
 
 		std::vector<std::pair<engine::object::GameObject*, engine::object::GameObject*>> collision_pairs_;
 		std::vector<std::pair<engine::object::GameObject*, engine::component::TileType>> tile_trigger_events_;
+		ContactCache<std::pair<engine::object::GameObject*, engine::object::GameObject*>> collision_contacts_;    ///< 物体碰撞对的 Enter/Stay/Exit 分类
+		ContactCache<std::pair<engine::object::GameObject*, engine::component::TileType>> tile_trigger_contacts_; ///< 瓦片触发的 Enter/Stay/Exit 分类
+		ContactCache<std::pair<engine::object::GameObject*, engine::object::GameObject*>> support_contacts_;      ///< 物体与固体物体（含运动学刚体）的接触，只用于注销时唤醒依赖方
+
+		/// 参与瓦片碰撞解析的图层及其斜坡高度表（注册图层时确定，解析时不再查找）
+		struct CollisionLayer {
+			component::TileLayerComponent* layer = nullptr;
+			const SlopeHeightTable* slopes = nullptr;
+		};
 
 		std::vector<component::TileLayerComponent*> tilelayer_components_;
+		std::vector<CollisionLayer> collision_layers_;                   ///< 与 tilelayer_components_ 同序
+		std::vector<std::unique_ptr<SlopeHeightTable>> slope_tables_;    ///< 各瓦片尺寸的斜坡逐像素高度表（注册图层时生成，地址不变）
 		glm::vec2 gravity_ = { 0.0f, 980.0f };
 		float max_speed_ = 5000.0f;
 		glm::vec2 world_bounds_min_{ 0.0f, 0.0f };
 		glm::vec2 world_bounds_max_{ 0.0f, 0.0f };
+
+		BroadphaseMode broadphase_mode_ = BroadphaseMode::SPATIAL_HASH; ///< 当前粗检测策略
+		bool verify_broadphase_ = false;                                 ///< 是否每帧与暴力遍历结果对比（调试用）
+		std::vector<BroadphaseProxy> broadphase_proxies_;                ///< 本帧参与物体碰撞的代理
+		std::vector<BroadphasePair> broadphase_pairs_;                   ///< 本帧粗检测输出的候选对
+		SpatialHashGrid spatial_hash_;                                   ///< 空间哈希网格
+		SweepAndPrune sweep_and_prune_;                                  ///< 扫描剪枝（端点列表帧间保留）
+		PhysicsStats stats_;                                             ///< 统计信息
+		std::vector<BroadphaseProxy> ccd_solids_;                        ///< 本步开始时 SOLID 层物体的 AABB（仅存在 CCD 物体时收集）
+		SpatialHashGrid ccd_grid_;                                       ///< ccd_solids_ 的空间哈希索引（每步重建，扫掠时只读查询）
+
+		static constexpr int MAX_CCD_SUBSTEPS = 16;                      ///< 连续碰撞检测单步最多拆分的子步数
+
+		bool sleep_enabled_ = true;                                      ///< 是否启用自动休眠
+		bool tearing_down_ = false;                                      ///< 批量注销中（如场景清理），注销时不唤醒接触物体
+		float sleep_velocity_threshold_ = 1.0f;                          ///< 休眠速度阈值（各轴，单位/秒）
+		float sleep_force_threshold_ = 1.0f;                             ///< 休眠外力阈值（各轴，不含重力）
+		int sleep_steps_ = 60;                                           ///< 连续静止多少步后进入休眠
+
+		std::unique_ptr<engine::core::WorkerPool> worker_pool_;          ///< 工作线程池，为空时单线程执行
+		bool verify_parallel_ = false;                                   ///< 是否每步与单线程结果对比（调试用）
+		std::vector<std::uint8_t> narrowphase_hits_;                     ///< 并行窄检测结果（按候选对下标）
+		std::vector<std::uint8_t> moved_proxies_;                        ///< 本步被固体推离过的代理（其预计算结果失效）
+		std::vector<std::vector<std::pair<std::uint32_t, engine::component::TileType>>> trigger_chunks_; ///< 各块的瓦片触发（刚体紧凑下标, 瓦片类型）
+
+		static constexpr size_t PARALLEL_BODY_GRAIN = 32;                ///< 并行时每块至少包含的刚体数
+		static constexpr size_t PARALLEL_PAIR_GRAIN = 64;                ///< 并行时每块至少包含的候选对数
+
+		// 场景查询索引：在物理步之后首次查询时按刚体的碰撞盒惰性重建
+		mutable std::vector<BroadphaseProxy> query_proxies_;             ///< 查询用代理
+		mutable SpatialHashGrid query_grid_;                             ///< 查询用空间哈希网格
+		mutable std::vector<std::uint32_t> query_indices_;               ///< 查询结果暂存（复用内存）
+		mutable bool query_index_dirty_ = true;                          ///< 查询索引是否需要重建
 	public:
 		/**
 		 * @brief 更新所有物理组件
@@ -43,7 +108,7 @@ namespace engine::physics {
 		PhysicsEngine(PhysicsEngine&&) = delete;
 		PhysicsEngine& operator=(PhysicsEngine&&) = delete;
 
-		void registerPhysicsComponent(component::PhysicsComponent* physics_component);
+		BodyHandle registerPhysicsComponent(component::PhysicsComponent* physics_component);
 		void registerCollisionLayer(component::TileLayerComponent* tilelayer_component);
 		void unregisterPhysicsComponent(component::PhysicsComponent* physics_component);
 		void unregisterCollisionLayer(component::TileLayerComponent* tilelayer_component);
@@ -68,6 +133,129 @@ namespace engine::physics {
 			return tile_trigger_events_;
 		};
 
+		/**
+		 * @brief 获取本步指定阶段的物体碰撞事件
+		 * @param phase ENTER：本步开始接触；STAY：持续接触；EXIT：不再接触（已移除物体的接触不产生 EXIT）
+		 * @details 双方都在休眠的接触本步没有经过检测，直接沿用上一步的结果保持为 STAY，
+		 *          因此 ENTER 与 STAY 合起来可能多于 getCollisionPairs()（后者只含本步实际检测到的物体对）。
+		 *          需要每帧处理持续接触的逻辑应以 STAY 事件为准。
+		 */
+		const std::vector<std::pair<engine::object::GameObject*, engine::object::GameObject*>>& getCollisionEvents(ContactPhase phase) const {
+			return collision_contacts_.getEvents(phase);
+		}
+		/**
+		 * @brief 获取本步指定阶段的瓦片触发事件（以物体与瓦片类型为单位）
+		 * @param phase 接触阶段
+		 */
+		const std::vector<std::pair<engine::object::GameObject*, engine::component::TileType>>& getTileTriggerEvents(ContactPhase phase) const {
+			return tile_trigger_contacts_.getEvents(phase);
+		}
+
+		/**
+		 * @brief 设置物体间碰撞的粗检测策略
+		 * @param mode 粗检测策略
+		 */
+		void setBroadphaseMode(BroadphaseMode mode);
+		BroadphaseMode getBroadphaseMode() const { return broadphase_mode_; }
+		void setBroadphaseCellSize(float cell_size) {
+			spatial_hash_.setCellSize(cell_size);
+			query_grid_.setCellSize(cell_size);
+			ccd_grid_.setCellSize(cell_size);
+			query_index_dirty_ = true;
+		}
+		/**
+		 * @brief 开启后每帧额外运行一次暴力遍历，校验当前粗检测得到的碰撞对是否一致
+		 * @param enable 是否开启校验
+		 */
+		void setBroadphaseVerification(bool enable) { verify_broadphase_ = enable; }
+		bool isBroadphaseVerificationEnabled() const { return verify_broadphase_; }
+
+		/**
+		 * @brief 启用或关闭自动休眠，关闭时立即唤醒所有物体
+		 * @param enable 是否启用
+		 */
+		void setSleepEnabled(bool enable);
+		bool isSleepEnabled() const { return sleep_enabled_; }
+		/**
+		 * @brief 标记批量注销（如场景清理）的开始与结束
+		 * @param tearing_down 为 true 时注销物体不再唤醒与其接触的物体，它们随后也会被注销
+		 */
+		void setTearingDown(bool tearing_down) { tearing_down_ = tearing_down; }
+		/**
+		 * @brief 设置休眠条件
+		 * @param velocity_threshold 各轴速度低于该值视为静止
+		 * @param force_threshold 各轴外力（不含重力）低于该值视为静止
+		 * @param steps 连续静止的步数
+		 */
+		void setSleepThresholds(float velocity_threshold, float force_threshold, int steps);
+
+		/**
+		 * @brief 设置物理步使用的线程数（含调用线程），不大于 1 时单线程执行
+		 * @param thread_count 线程数
+		 * @details 积分与瓦片解析按刚体、窄检测按候选对、瓦片触发器按刚体分块并行，
+		 *          各块输出按块号顺序合并，结果与单线程一致。
+		 */
+		void setWorkerThreadCount(size_t thread_count);
+		size_t getWorkerThreadCount() const { return worker_pool_ ? worker_pool_->getThreadCount() : 1; }
+		/**
+		 * @brief 开启后每步额外以单线程重新执行并行阶段并对比结果，不一致时输出错误（调试用）
+		 * @param enable 是否开启校验
+		 */
+		void setParallelVerification(bool enable) { verify_parallel_ = enable; }
+		bool isParallelVerificationEnabled() const { return verify_parallel_; }
+
+		/// 获取上一步的统计信息（候选对数量等）
+		const PhysicsStats& getStats() const { return stats_; }
+		/// 重置统计峰值
+		void resetStats() { stats_ = PhysicsStats{}; stats_.broadphase_mode = broadphase_mode_; }
+
+		/**
+		 * @brief 计算所有刚体 Transform 位置与速度的校验和（按位计算，用于确认两次回放结果完全一致）
+		 * @return 64 位 FNV-1a 哈希
+		 */
+		std::uint64_t computeStateHash() const;
+
+		// --- 场景查询：物体位置以最近一次物理步结束时为准 ---
+
+		/**
+		 * @brief 射线检测，返回最近的命中（瓦片或物体）
+		 * @param origin 起点（世界坐标）
+		 * @param direction 方向（无需归一化）
+		 * @param max_distance 最大距离
+		 * @param out_hit 输出命中信息
+		 * @param filter 过滤条件，默认只命中阻挡视线的瓦片与所有碰撞层的物体
+		 * @return 是否命中
+		 * @details 瓦片使用 DDA 网格遍历，物体通过查询网格筛选后做射线-AABB 测试。
+		 *          起点所在的瓦片与包含起点的碰撞体不算命中；斜坡瓦片按整格处理。
+		 */
+		bool raycast(const glm::vec2& origin, const glm::vec2& direction, float max_distance, RaycastHit& out_hit,
+			const QueryFilter& filter = {}) const;
+		/**
+		 * @brief 两点之间是否没有阻挡视线的瓦片（不考虑物体）
+		 */
+		bool hasLineOfSight(const glm::vec2& from, const glm::vec2& to, TileTypeMask blocking = tile_mask::SIGHT_BLOCKING) const;
+		/**
+		 * @brief 查询与区域相交（含边缘接触）的物体
+		 * @param rect 世界矩形
+		 * @param out_objects 输出物体（会先被清空），按刚体紧凑下标顺序
+		 * @param layer_mask 只返回碰撞层与该掩码有交集的物体
+		 * @return 物体数量
+		 */
+		size_t overlapAABB(const engine::utils::Rect& rect, std::vector<engine::object::GameObject*>& out_objects,
+			std::uint32_t layer_mask = collision_layer::ALL) const;
+		/**
+		 * @brief 查询区域覆盖的指定类型瓦片（跳过隐藏图层）
+		 * @param rect 世界矩形（右/下边界所在的瓦片也计入）
+		 * @param mask 瓦片类型掩码
+		 * @param out_tiles 输出瓦片（会先被清空），按图层、行、列顺序
+		 * @return 瓦片数量
+		 */
+		size_t queryTiles(const engine::utils::Rect& rect, TileTypeMask mask, std::vector<TileQueryHit>& out_tiles) const;
+		/**
+		 * @brief 区域内是否存在指定类型的瓦片，找到第一个即返回
+		 */
+		bool overlapsTile(const engine::utils::Rect& rect, TileTypeMask mask) const;
+
 		engine::component::TileType getTileTypeAt(const glm::vec2& world_pos) const;
 		bool tryGetLadderColumnCenterX(const glm::vec2& world_pos, float& out_center_x) const;
 
@@ -75,9 +263,20 @@ namespace engine::physics {
 
 		// 新增：碰撞检测循环
 		void checkObjectCollisions();
-		float getTileHeightAtWidth(float width, engine::component::TileType type, glm::vec2 tile_size);
+		void buildBroadphaseProxies();
+		void findBruteForcePairs(std::vector<BroadphasePair>& out_pairs) const;
+		void verifyBroadphasePairs();
+		const SlopeHeightTable* findSlopeTable(const glm::vec2& tile_size) const;
 
-		void resolveTileCollisions(engine::component::PhysicsComponent* pc, float delta_time);
+		void gatherBodies(float dt);
+		void moveKinematicBodies(float dt);
+		void stepBodies(float dt, bool parallel);
+		void verifyParallelBodyStep(float dt);
+		void syncBodyPositions();
+		void resolveTileCollisions(std::uint32_t body, float delta_time);
+		void collectCCDSolids();
+		glm::vec2 sweepSolidObjects(std::uint32_t body, glm::vec2 ds);
+		int computeCCDSubsteps(const glm::vec2& ds) const;
 		void resolveSolidObjectCollisions(engine::object::GameObject* move_obj, engine::object::GameObject* solid_obj);
 
 		void resolveXAxisCollision(
@@ -85,16 +284,44 @@ namespace engine::physics {
 			glm::vec2& aabb_pos,
 			float dx,
 			const glm::vec2& collider_size,
-			engine::component::TileLayerComponent* layer);
+			engine::component::TileLayerComponent* layer,
+			const SlopeHeightTable& slopes);
 
 		void resolveYAxisCollision(
 			engine::component::PhysicsComponent* pc,
 			glm::vec2& aabb_pos,
 			float dy,
 			const glm::vec2& collider_size,
-			engine::component::TileLayerComponent* layer);
+			engine::component::TileLayerComponent* layer,
+			const SlopeHeightTable& slopes);
 
+		void refreshQueryIndex() const;
 		void checkTileTriggers();
+		void collectTileTriggers(size_t begin, size_t end,
+			std::vector<std::pair<std::uint32_t, engine::component::TileType>>& out_triggers) const;
+		void updateContactEvents();
+		static ContactId makePairContactId(BodyHandle a, BodyHandle b);
+		static ContactId makeTileContactId(BodyHandle body, engine::component::TileType type);
+		static std::pair<BodyHandle, BodyHandle> pairContactBodies(const ContactId& id);
+		bool isBodySleeping(BodyHandle handle) const;
+		bool shouldWake(const engine::component::PhysicsComponent* pc) const;
+		void updateSleepStates();
+		void wakeAll();
+		void wakeContactsOf(BodyHandle handle);
+
+		/// 有线程池时分块并行执行 fn(begin, end, chunk)，否则在当前线程整体执行
+		template<typename Fn>
+		void parallelFor(size_t count, size_t min_grain, Fn&& fn) {
+			if (worker_pool_) {
+				worker_pool_->parallelFor(count, min_grain, std::forward<Fn>(fn));
+			}
+			else if (count > 0) {
+				fn(size_t{ 0 }, count, size_t{ 0 });
+			}
+		}
+		size_t chunkCount(size_t count, size_t min_grain) const {
+			return worker_pool_ ? worker_pool_->chunkCount(count, min_grain) : (count > 0 ? 1 : 0);
+		}
 	};
 
 }  // namespace engine::physics
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+/**
+ * @file physics_query.h
+ * @brief 定义物理场景查询（射线、区域重叠、瓦片查询）使用的数据结构。
+ */
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/ext/vector_int2.hpp>
+#include "../component/tilelayer_component.h"
+#include "../utils/math.h"
+#include "collision_layers.h"
+#include "slope_table.h"
+
+namespace engine::object {
+	class GameObject;
+}
+
+namespace engine::physics {
+
+	/// 瓦片类型掩码，第 n 位对应 TileType 的第 n 个枚举值
+	using TileTypeMask = std::uint32_t;
+
+	/// 获取单个瓦片类型对应的掩码位
+	constexpr TileTypeMask tileTypeBit(engine::component::TileType type) {
+		return TileTypeMask{ 1 } << static_cast<std::uint32_t>(type);
+	}
+
+	/// 带有指定形状标志的所有瓦片类型的掩码
+	constexpr TileTypeMask tileShapeMask(std::uint8_t shape_flags) {
+		TileTypeMask mask = 0;
+		for (std::size_t i = 0; i < TILE_SHAPES.size(); ++i) {
+			if ((TILE_SHAPES[i].flags & shape_flags) != 0) mask |= TileTypeMask{ 1 } << i;
+		}
+		return mask;
+	}
+
+	namespace tile_mask {
+		using engine::component::TileType;
+		inline constexpr TileTypeMask NONE = 0;
+		inline constexpr TileTypeMask SOLID = tileTypeBit(TileType::SOLID);
+		inline constexpr TileTypeMask UNISOLID = tileTypeBit(TileType::UNISOLID);
+		inline constexpr TileTypeMask SLOPES = tileShapeMask(tile_shape::SLOPE); ///< 由形状表生成，新增斜坡自动包含
+		inline constexpr TileTypeMask HAZARD = tileTypeBit(TileType::HAZARD);
+		inline constexpr TileTypeMask LADDER = tileTypeBit(TileType::LADDER);
+		/// 阻挡视线的瓦片（单向平台不阻挡）
+		inline constexpr TileTypeMask SIGHT_BLOCKING = SOLID | SLOPES;
+	}
+
+	/**
+	 * @struct QueryFilter
+	 * @brief 射线检测的过滤条件。
+	 */
+	struct QueryFilter {
+		TileTypeMask tile_mask = tile_mask::SIGHT_BLOCKING;        ///< 会命中的瓦片类型，NONE 表示忽略瓦片
+		std::uint32_t layer_mask = collision_layer::ALL;           ///< 会命中的碰撞层，NONE 表示忽略物体
+		const engine::object::GameObject* ignore = nullptr;        ///< 忽略的物体（通常是发出射线的物体自身）
+	};
+
+	/**
+	 * @struct RaycastHit
+	 * @brief 射线检测结果。命中物体时 object 非空，命中瓦片时 tile_type 为瓦片类型。
+	 */
+	struct RaycastHit {
+		glm::vec2 point{ 0.0f, 0.0f };                             ///< 命中点（世界坐标）
+		glm::vec2 normal{ 0.0f, 0.0f };                            ///< 命中面的法线（轴对齐）
+		float distance = 0.0f;                                     ///< 起点到命中点的距离
+		engine::object::GameObject* object = nullptr;              ///< 命中的物体
+		engine::component::TileType tile_type = engine::component::TileType::EMPTY; ///< 命中的瓦片类型
+		glm::ivec2 tile{ -1, -1 };                                 ///< 命中瓦片的网格坐标（所在图层）
+	};
+
+	/**
+	 * @struct TileQueryHit
+	 * @brief 区域瓦片查询的单个结果。
+	 */
+	struct TileQueryHit {
+		glm::ivec2 tile{ 0, 0 };                                   ///< 网格坐标（所在图层）
+		engine::component::TileType type = engine::component::TileType::EMPTY; ///< 瓦片类型
+		engine::utils::Rect world_rect{};                          ///< 瓦片的世界矩形
+	};
+
+} // namespace engine::physics
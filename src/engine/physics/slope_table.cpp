@@ -0,0 +1,32 @@
+#include "slope_table.h"
+#include <algorithm>
+
+namespace engine::physics {
+
+/**
+ * @brief 为给定瓦片尺寸预计算高度表
+ *
+ * @param tile_size 单个瓦片的像素尺寸
+ * @details 第 i 个采样为左边缘起第 i 个像素列边界处的高度：left + (right - left) * i / width，
+ *          再乘以瓦片高度换算为像素。
+ */
+SlopeHeightTable::SlopeHeightTable(const glm::ivec2& tile_size)
+	: tile_size_(tile_size)
+{
+	const int width = std::max(tile_size.x, 1);
+	const float height = static_cast<float>(std::max(tile_size.y, 0));
+	samples_ = width + 1;
+	heights_.assign(TILE_TYPE_COUNT * static_cast<std::size_t>(samples_), 0.0f);
+
+	for (std::size_t type = 0; type < TILE_TYPE_COUNT; ++type) {
+		const auto& shape = TILE_SHAPES[type];
+		if ((shape.flags & tile_shape::SLOPE) == 0) continue;
+		float* row = heights_.data() + type * static_cast<std::size_t>(samples_);
+		for (int i = 0; i < samples_; ++i) {
+			const float t = static_cast<float>(i) / static_cast<float>(width);
+			row[i] = (shape.left_height + (shape.right_height - shape.left_height) * t) * height;
+		}
+	}
+}
+
+} // namespace engine::physics
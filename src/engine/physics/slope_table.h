@@ -0,0 +1,133 @@
+#pragma once
+/**
+ * @file slope_table.h
+ * @brief 定义瓦片形状描述表（左右边缘高度与实体标志）以及按瓦片尺寸预计算的斜坡逐像素高度表。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/ext/vector_int2.hpp>
+#include "../component/tilelayer_component.h"
+
+namespace engine::physics {
+
+	/// TileType 枚举值的数量（新增类型时需保持 LEVEL_EXIT 为最后一项，或同步修改此处）
+	inline constexpr std::size_t TILE_TYPE_COUNT = static_cast<std::size_t>(engine::component::TileType::LEVEL_EXIT) + 1;
+
+	namespace tile_shape {
+		inline constexpr std::uint8_t NONE = 0;
+		inline constexpr std::uint8_t SOLID = 1u << 0;    ///< 整格实体，四个方向都阻挡
+		inline constexpr std::uint8_t ONE_WAY = 1u << 1;  ///< 单向平台，只从上方阻挡
+		inline constexpr std::uint8_t SLOPE = 1u << 2;    ///< 按左右边缘高度线性插值的斜坡，逐格处理
+	}
+
+	/**
+	 * @struct TileShape
+	 * @brief 单种瓦片类型的碰撞形状。
+	 *
+	 * 高度以瓦片高度为单位（0 为瓦片底边，1 为顶边），斜坡表面在左右边缘之间线性变化。
+	 * 新增斜坡比例（如 3:1）只需增加 TileType 枚举值并在 makeTileShapes() 中登记三段高度。
+	 */
+	struct TileShape {
+		float left_height = 0.0f;             ///< 左边缘表面高度
+		float right_height = 0.0f;            ///< 右边缘表面高度
+		std::uint8_t flags = tile_shape::NONE;///< tile_shape 标志
+		std::string_view slope_name{};        ///< Tiled 中 "slope" 属性的取值（仅斜坡）
+	};
+
+	namespace detail {
+		constexpr std::size_t tileIndex(engine::component::TileType type) { return static_cast<std::size_t>(type); }
+
+		constexpr std::array<TileShape, TILE_TYPE_COUNT> makeTileShapes() {
+			using engine::component::TileType;
+			std::array<TileShape, TILE_TYPE_COUNT> shapes{};
+			shapes[tileIndex(TileType::SOLID)] = { 1.0f, 1.0f, tile_shape::SOLID, {} };
+			shapes[tileIndex(TileType::UNISOLID)] = { 1.0f, 1.0f, tile_shape::ONE_WAY, {} };
+			// 1x1 斜坡
+			shapes[tileIndex(TileType::SLOPE_0_1)] = { 0.0f, 1.0f, tile_shape::SLOPE, "0_1" };
+			shapes[tileIndex(TileType::SLOPE_1_0)] = { 1.0f, 0.0f, tile_shape::SLOPE, "1_0" };
+			// 2x1 斜坡，两格各占一半高度
+			shapes[tileIndex(TileType::SLOPE_0_2)] = { 0.0f, 0.5f, tile_shape::SLOPE, "0_2" };
+			shapes[tileIndex(TileType::SLOPE_2_1)] = { 0.5f, 1.0f, tile_shape::SLOPE, "2_1" };
+			shapes[tileIndex(TileType::SLOPE_1_2)] = { 1.0f, 0.5f, tile_shape::SLOPE, "1_2" };
+			shapes[tileIndex(TileType::SLOPE_2_0)] = { 0.5f, 0.0f, tile_shape::SLOPE, "2_0" };
+			return shapes;
+		}
+	}
+
+	/// 按 TileType 下标排列的形状描述表
+	inline constexpr std::array<TileShape, TILE_TYPE_COUNT> TILE_SHAPES = detail::makeTileShapes();
+
+	/// 获取瓦片类型的形状描述
+	constexpr const TileShape& tileShape(engine::component::TileType type) {
+		return TILE_SHAPES[detail::tileIndex(type)];
+	}
+
+	/// 是否为斜坡瓦片
+	constexpr bool isSlopeTile(engine::component::TileType type) {
+		return (tileShape(type).flags & tile_shape::SLOPE) != 0;
+	}
+
+	/**
+	 * @brief 按 Tiled 中 "slope" 属性的取值查找斜坡类型，同时接受 "0_1" 与 "slope_0_1" 两种写法。
+	 * @return 未登记的取值返回 std::nullopt。
+	 */
+	constexpr std::optional<engine::component::TileType> findSlopeByName(std::string_view name) {
+		constexpr std::string_view prefix = "slope_";
+		if (name.starts_with(prefix)) name.remove_prefix(prefix.size());
+		for (std::size_t i = 0; i < TILE_SHAPES.size(); ++i) {
+			if ((TILE_SHAPES[i].flags & tile_shape::SLOPE) != 0 && TILE_SHAPES[i].slope_name == name) {
+				return static_cast<engine::component::TileType>(i);
+			}
+		}
+		return std::nullopt;
+	}
+
+	static_assert(isSlopeTile(engine::component::TileType::SLOPE_2_0) && !isSlopeTile(engine::component::TileType::SOLID));
+	static_assert(findSlopeByName("slope_2_1") == engine::component::TileType::SLOPE_2_1);
+
+	/**
+	 * @class SlopeHeightTable
+	 * @brief 某一瓦片尺寸下所有斜坡类型的逐像素列表面高度。
+	 *
+	 * 每种瓦片类型保存 tile_width + 1 个采样（像素列边界处的高度，单位像素），
+	 * 查询时取相邻两个采样做线性插值，不再按类型分支。在整数像素列上，结果与按左右高度直接计算
+ * left + (right - left) * x / width 逐位相同；两列之间的插值结果与直接计算只相差浮点舍入。
+	 * 非斜坡类型的高度恒为 0。表在注册瓦片图层时按图层的瓦片尺寸生成，相同尺寸的图层共用一张表。
+	 */
+	class SlopeHeightTable final {
+	private:
+		glm::ivec2 tile_size_{ 0, 0 };
+		int samples_ = 0;                     ///< 每种类型的采样数（tile_width + 1）
+		std::vector<float> heights_;          ///< [类型][像素列] 行优先
+
+	public:
+		/**
+		 * @brief 构造函数，为给定瓦片尺寸预计算高度表。
+		 * @param tile_size 单个瓦片的像素尺寸。
+		 */
+		explicit SlopeHeightTable(const glm::ivec2& tile_size);
+
+		const glm::ivec2& getTileSize() const { return tile_size_; }
+
+		/**
+		 * @brief 获取瓦片内某一横坐标处的表面高度。
+		 * @param type 瓦片类型。
+		 * @param x 相对瓦片左边缘的横坐标（像素），超出范围时取边缘值。
+		 * @return 从瓦片底边向上量的表面高度（像素）。
+		 */
+		float heightAt(engine::component::TileType type, float x) const {
+			const float max_x = static_cast<float>(samples_ - 1);
+			const float px = x < 0.0f ? 0.0f : (x > max_x ? max_x : x);
+			const int column = static_cast<int>(px) < samples_ - 1 ? static_cast<int>(px) : samples_ - 2;
+			const float* row = heights_.data() + detail::tileIndex(type) * static_cast<std::size_t>(samples_);
+			return row[column] + (row[column + 1] - row[column]) * (px - static_cast<float>(column));
+		}
+	};
+
+} // namespace engine::physics
@@ -0,0 +1,136 @@
+#include "tile_collider_set.h"
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+using engine::component::TileType;
+
+/**
+ * @brief 构建矩形集合
+ *
+ * @param types 行优先的瓦片类型网格
+ * @param map_size 网格尺寸
+ * @param tile_size 瓦片尺寸
+ * @details 逐行扫描，遇到未访问的 SOLID 瓦片时先向右扩展得到最长连续段，
+ *          再逐行向下尝试扩展：只有下一行同一区间全部为未访问的 SOLID 时才扩展。
+ *          UNISOLID 只做行内合并。
+ */
+void TileColliderSet::build(const std::vector<std::uint8_t>& types, const glm::ivec2& map_size, const glm::ivec2& tile_size)
+{
+	rects_.clear();
+	buckets_.clear();
+	bucket_count_ = { 0, 0 };
+	source_tile_count_ = 0;
+	if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0 || tile_size.y <= 0) return;
+	if (types.size() != static_cast<size_t>(map_size.x) * static_cast<size_t>(map_size.y)) return;
+
+	const auto index = [&](int x, int y) { return static_cast<size_t>(y) * static_cast<size_t>(map_size.x) + static_cast<size_t>(x); };
+	const auto typeAt = [&](int x, int y) { return static_cast<TileType>(types[index(x, y)]); };
+	std::vector<std::uint8_t> visited(types.size(), 0);
+	const glm::vec2 tile = glm::vec2(tile_size);
+
+	for (int y = 0; y < map_size.y; ++y) {
+		for (int x = 0; x < map_size.x; ++x) {
+			if (visited[index(x, y)]) continue;
+			const TileType type = typeAt(x, y);
+			if (type != TileType::SOLID && type != TileType::UNISOLID) continue;
+
+			// 1. 向右扩展
+			int width = 1;
+			while (x + width < map_size.x && !visited[index(x + width, y)] && typeAt(x + width, y) == type) {
+				++width;
+			}
+
+			// 2. 向下扩展（仅 SOLID）
+			int height = 1;
+			if (type == TileType::SOLID) {
+				while (y + height < map_size.y) {
+					bool row_ok = true;
+					for (int i = 0; i < width; ++i) {
+						if (visited[index(x + i, y + height)] || typeAt(x + i, y + height) != type) {
+							row_ok = false;
+							break;
+						}
+					}
+					if (!row_ok) break;
+					++height;
+				}
+			}
+
+			for (int j = 0; j < height; ++j) {
+				for (int i = 0; i < width; ++i) {
+					visited[index(x + i, y + j)] = 1;
+				}
+			}
+			source_tile_count_ += static_cast<size_t>(width) * static_cast<size_t>(height);
+
+			TileRect rect;
+			rect.min = glm::vec2(static_cast<float>(x), static_cast<float>(y)) * tile;
+			rect.max = glm::vec2(static_cast<float>(x + width), static_cast<float>(y + height)) * tile;
+			rect.type = type;
+			rects_.push_back(rect);
+		}
+	}
+
+	buildBuckets(map_size, tile_size);
+}
+
+/**
+ * @brief 将矩形登记到其覆盖的所有桶中
+ */
+void TileColliderSet::buildBuckets(const glm::ivec2& map_size, const glm::ivec2& tile_size)
+{
+	bucket_size_ = glm::vec2(tile_size) * static_cast<float>(BUCKET_TILES);
+	bucket_count_ = { (map_size.x + BUCKET_TILES - 1) / BUCKET_TILES, (map_size.y + BUCKET_TILES - 1) / BUCKET_TILES };
+	buckets_.assign(static_cast<size_t>(bucket_count_.x) * static_cast<size_t>(bucket_count_.y), {});
+
+	for (std::uint32_t i = 0; i < rects_.size(); ++i) {
+		const auto& rect = rects_[i];
+		// 矩形右/下边界恰好落在桶边界上时不登记到下一个桶，查询时会按边缘接触扩展
+		const int bx0 = static_cast<int>(rect.min.x / bucket_size_.x);
+		const int by0 = static_cast<int>(rect.min.y / bucket_size_.y);
+		const int bx1 = std::min(static_cast<int>(std::ceil(rect.max.x / bucket_size_.x)) - 1, bucket_count_.x - 1);
+		const int by1 = std::min(static_cast<int>(std::ceil(rect.max.y / bucket_size_.y)) - 1, bucket_count_.y - 1);
+		for (int by = by0; by <= by1; ++by) {
+			for (int bx = bx0; bx <= bx1; ++bx) {
+				buckets_[static_cast<size_t>(by) * static_cast<size_t>(bucket_count_.x) + static_cast<size_t>(bx)].push_back(i);
+			}
+		}
+	}
+}
+
+/**
+ * @brief 查询与区域相交的矩形
+ *
+ * @param local_min 查询区域左上角（图层局部坐标）
+ * @param local_max 查询区域右下角（图层局部坐标）
+ * @param out_indices 输出矩形下标
+ * @details 先按区域定位桶范围（向外多取一格以覆盖边缘接触），再逐个做精确的区间测试。
+ */
+void TileColliderSet::query(const glm::vec2& local_min, const glm::vec2& local_max, std::vector<std::uint32_t>& out_indices) const
+{
+	out_indices.clear();
+	if (buckets_.empty()) return;
+
+	const int bx0 = std::max(static_cast<int>(std::floor(local_min.x / bucket_size_.x)) - 1, 0);
+	const int by0 = std::max(static_cast<int>(std::floor(local_min.y / bucket_size_.y)) - 1, 0);
+	const int bx1 = std::min(static_cast<int>(std::floor(local_max.x / bucket_size_.x)), bucket_count_.x - 1);
+	const int by1 = std::min(static_cast<int>(std::floor(local_max.y / bucket_size_.y)), bucket_count_.y - 1);
+	if (bx0 > bx1 || by0 > by1) return;
+
+	for (int by = by0; by <= by1; ++by) {
+		for (int bx = bx0; bx <= bx1; ++bx) {
+			for (auto i : buckets_[static_cast<size_t>(by) * static_cast<size_t>(bucket_count_.x) + static_cast<size_t>(bx)]) {
+				const auto& rect = rects_[i];
+				if (rect.max.x < local_min.x || rect.min.x > local_max.x ||
+					rect.max.y < local_min.y || rect.min.y > local_max.y) continue;
+				out_indices.push_back(i);
+			}
+		}
+	}
+	std::sort(out_indices.begin(), out_indices.end());
+	out_indices.erase(std::unique(out_indices.begin(), out_indices.end()), out_indices.end());
+}
+
+} // namespace engine::physics
@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file tile_collider_set.h
+ * @brief 定义 TileColliderSet，将瓦片图层中的实体瓦片合并为少量静态矩形，供物理查询。
+ */
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include "../component/tilelayer_component.h"
+
+namespace engine::physics {
+
+	/**
+	 * @struct TileRect
+	 * @brief 合并后的静态碰撞矩形（图层局部坐标，像素）。
+	 */
+	struct TileRect {
+		glm::vec2 min{ 0.0f, 0.0f };  ///< 左上角（相对图层原点）
+		glm::vec2 max{ 0.0f, 0.0f };  ///< 右下角（相对图层原点）
+		engine::component::TileType type{ engine::component::TileType::SOLID }; ///< SOLID 或 UNISOLID
+	};
+
+	/**
+	 * @class TileColliderSet
+	 * @brief 在关卡加载时把连续的 SOLID / UNISOLID 瓦片贪心合并为轴对齐矩形，并用均匀分桶网格索引。
+	 *
+	 * - SOLID 先沿行合并，再向下扩展为二维矩形；
+	 * - UNISOLID 只沿行合并（单向平台只有顶面有意义，保持单行高度与逐格判定一致）；
+	 * - 斜坡、梯子等特殊瓦片不参与合并，仍由物理引擎逐格处理。
+	 *
+	 * 矩形使用图层局部坐标存储，图层整体移动时无需重建。
+	 */
+	class TileColliderSet final {
+	private:
+		std::vector<TileRect> rects_;                       ///< 合并后的矩形
+		std::vector<std::vector<std::uint32_t>> buckets_;   ///< 分桶网格：桶 -> 与之相交的矩形下标
+		glm::ivec2 bucket_count_{ 0, 0 };                   ///< 桶网格尺寸
+		glm::vec2 bucket_size_{ 0.0f, 0.0f };               ///< 单个桶的像素尺寸
+		size_t source_tile_count_ = 0;                      ///< 参与合并的瓦片数量（用于日志统计）
+
+		static constexpr int BUCKET_TILES = 8;              ///< 每个桶包含的瓦片数（每个方向）
+
+	public:
+		TileColliderSet() = default;
+
+		/**
+		 * @brief 根据瓦片类型网格构建矩形集合（覆盖旧数据）。
+		 * @param types 行优先的瓦片类型网格。
+		 * @param map_size 网格尺寸 (columns, rows)。
+		 * @param tile_size 单个瓦片的像素尺寸。
+		 */
+		void build(const std::vector<std::uint8_t>& types, const glm::ivec2& map_size, const glm::ivec2& tile_size);
+
+		/**
+		 * @brief 查询与局部区域相交（含边缘接触）的矩形。
+		 * @param local_min 查询区域左上角（图层局部坐标）。
+		 * @param local_max 查询区域右下角（图层局部坐标）。
+		 * @param out_indices 输出矩形下标（会先被清空），已去重且升序。
+		 */
+		void query(const glm::vec2& local_min, const glm::vec2& local_max, std::vector<std::uint32_t>& out_indices) const;
+
+		const std::vector<TileRect>& getRects() const { return rects_; }
+		const TileRect& getRect(std::uint32_t index) const { return rects_[index]; }
+		size_t getSourceTileCount() const { return source_tile_count_; }
+		bool empty() const { return rects_.empty(); }
+
+	private:
+		void buildBuckets(const glm::ivec2& map_size, const glm::ivec2& tile_size);
+	};
+
+} // namespace engine::physics
@@ -35,7 +35,7 @@
 		 * @return 转换后的屏幕坐标。
 		 */
 		glm::vec2 Camera::worldToScreen(const glm::vec2& world_pos) const {
-			glm::vec2 r = world_pos - position_;
+			glm::vec2 r = world_pos - getRenderPosition();
 			if (pixel_snap_) {
 				r.x = std::round(r.x);
 				r.y = std::round(r.y);
@@ -50,7 +50,7 @@
 		 * @return 转换后的屏幕坐标。
 		 */
 		glm::vec2 Camera::worldToScreenWithParallax(const glm::vec2& world_pos, float scroll_factor) const {
-			glm::vec2 r = world_pos - position_ * scroll_factor;
+			glm::vec2 r = world_pos - getRenderPosition() * scroll_factor;
 			if (pixel_snap_) {
 				r.x = std::round(r.x);
 				r.y = std::round(r.y);
@@ -65,7 +65,7 @@
 		 * @return 转换后的屏幕坐标。
 		 */
 		glm::vec2 Camera::worldToScreenWithParallax(const glm::vec2& world_pos, const glm::vec2& scroll_factor) const {
-			glm::vec2 r = world_pos - position_ * scroll_factor;
+			glm::vec2 r = world_pos - getRenderPosition() * scroll_factor;
 			if (pixel_snap_) {
 				r.x = std::round(r.x);
 				r.y = std::round(r.y);
@@ -84,7 +84,7 @@
 				p.x = std::round(p.x);
 				p.y = std::round(p.y);
 			}
-			return p + position_;
+			return p + getRenderPosition();
 		}
 
 		/**
@@ -94,6 +94,7 @@
 		void Camera::setPosition(const glm::vec2& position) {
 			position_ = position;
 			clampPosition();
+			previous_position_ = position_; // 直接设置视为瞬移，不做插值
 		}
 
 		/**
@@ -103,6 +104,7 @@
 		void Camera::setLimitBounds(const engine::utils::Rect& bounds) {
 			limit_bounds_ = bounds;
 			clampPosition();
+			previous_position_ = position_;
 		}
 
 		/**
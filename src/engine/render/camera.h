@@ -29,6 +29,10 @@ namespace engine::render {
 		float smooth_speed_ = 5.0f;
 		engine::component::TransformComponent* target_ = nullptr; // 跟随目标
 		bool pixel_snap_{ true };
+		/// 上一个固定步开始时的位置，用于渲染插值
+		glm::vec2 previous_position_;
+		/// 渲染插值系数 [0, 1]
+		float interpolation_alpha_{ 1.0f };
 
 	public:
 		/**
@@ -40,7 +44,7 @@ namespace engine::render {
 		explicit Camera(const glm::vec2& viewport_size,
 						const glm::vec2& position = {0.0f, 0.0f},
 						const std::optional<engine::utils::Rect>& limit_bounds = std::nullopt)
-						:viewport_size_(viewport_size), position_(position), limit_bounds_(limit_bounds) {
+						:viewport_size_(viewport_size), position_(position), limit_bounds_(limit_bounds), previous_position_(position) {
 			spdlog::trace("Camera 初始化成功，位置: {},{}", position_.x, position_.y);
 		}
 
@@ -91,6 +95,20 @@ namespace engine::render {
 		 */
 		glm::vec2 screenToWorld(const glm::vec2& screen_pos) const;
 
+		/**
+		 * @brief 记录当前位置作为"上一位置"，在每个固定步开始时调用。
+		 */
+		void savePreviousPosition() { previous_position_ = position_; }
+		/**
+		 * @brief 设置渲染插值系数，坐标转换将使用上一位置与当前位置之间的插值。
+		 * @param alpha 插值系数 [0, 1]，1 表示当前位置。
+		 */
+		void setInterpolationAlpha(float alpha) { interpolation_alpha_ = alpha; }
+		/**
+		 * @brief 获取用于渲染的插值位置。
+		 * @return glm::vec2 插值后的左上角位置。
+		 */
+		glm::vec2 getRenderPosition() const { return previous_position_ + (position_ - previous_position_) * interpolation_alpha_; }
 		void setPixelSnap(bool enabled) { pixel_snap_ = enabled; }
 		bool getPixelSnap() const { return pixel_snap_; }
 
@@ -0,0 +1,47 @@
+#pragma once
+/**
+ * @file render_order.h
+ * @brief 定义渲染排序信息 RenderOrder 以及由它和纹理绑定编号组成的 64 位排序键。
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+namespace engine::render {
+
+	namespace render_layer {
+		inline constexpr std::uint8_t FIRST = 0;
+		/// 运行时创建的对象所在的层；关卡加载器把第一个对象图层映射到这一层，之前的图层依次减一，之后的依次加一
+		inline constexpr std::uint8_t DEFAULT = 128;
+		inline constexpr std::uint8_t LAST = 255;
+	}
+
+	/**
+	 * @struct RenderOrder
+	 * @brief 一条绘制命令的排序信息，按 layer -> z -> 纹理 -> depth 的优先级升序绘制。
+	 *
+	 * layer 与 z 决定遮挡关系；layer 与 z 都相同的命令被视为互不遮挡，按纹理分组以延长批次，
+	 * depth 只在同一纹理内细分顺序。排序稳定，键完全相同的命令保持提交顺序。
+	 */
+	struct RenderOrder {
+		std::uint8_t layer = render_layer::DEFAULT; ///< 渲染层（通常对应 Tiled 图层）
+		std::int16_t z = 0;                          ///< 层内的前后顺序，越大越靠前
+		std::uint16_t depth = 0;                     ///< 同一纹理内的细分顺序
+	};
+
+	/**
+	 * @brief 组合 64 位排序键：layer(8) | z(16) | 纹理绑定编号(24) | depth(16)。
+	 * @param order 排序信息。
+	 * @param bind_id 实际绑定纹理的编号（TextureRegion::bind_id），打包进同一图集页的句柄编号相同；
+	 *                无效编号（如渲染目标纹理）排在同层同 z 的最后。
+	 */
+	constexpr std::uint64_t makeSortKey(const RenderOrder& order, std::uint32_t bind_id) {
+		const std::uint64_t z_bits = static_cast<std::uint16_t>(static_cast<std::int32_t>(order.z) + 32768);
+		const std::uint64_t texture_bits = std::min<std::uint32_t>(bind_id, 0xFFFFFFu);
+		return (static_cast<std::uint64_t>(order.layer) << 56) | (z_bits << 40) | (texture_bits << 16) | order.depth;
+	}
+
+	static_assert(makeSortKey({ 1, -1, 0 }, 0xFFFFFFFFu) < makeSortKey({ 1, 0, 0 }, 0));
+	static_assert(makeSortKey({ 0, 32767, 65535 }, 0xFFFFFFFFu) < makeSortKey({ 1, -32768, 0 }, 0));
+
+} // namespace engine::render
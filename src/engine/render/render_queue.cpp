@@ -0,0 +1,40 @@
+#include "render_queue.h"
+#include <array>
+
+namespace engine::render {
+
+/**
+ * @brief 按排序键稳定排序
+ *
+ * @details LSD 基数排序，从最低字节开始每趟按一个字节做计数排序。计数排序本身稳定，
+ *          因此最终顺序先按完整的键、键相同时按提交顺序。某一字节在所有键上都相同时该趟不改变顺序，直接跳过。
+ */
+void RenderQueue::sort()
+{
+	const size_t count = entries_.size();
+	if (count < 2) return;
+	scratch_.resize(count);
+
+	for (int shift = 0; shift < 64; shift += 8) {
+		std::array<size_t, 256> offsets{};
+		for (const auto& entry : entries_) {
+			++offsets[(entry.key >> shift) & 0xFFu];
+		}
+		if (offsets[(entries_.front().key >> shift) & 0xFFu] == count) {
+			continue;
+		}
+
+		size_t sum = 0;
+		for (auto& offset : offsets) {
+			const size_t bucket_count = offset;
+			offset = sum;
+			sum += bucket_count;
+		}
+		for (const auto& entry : entries_) {
+			scratch_[offsets[(entry.key >> shift) & 0xFFu]++] = entry;
+		}
+		entries_.swap(scratch_);
+	}
+}
+
+} // namespace engine::render
@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file render_queue.h
+ * @brief 定义 RenderQueue：收集一帧内的纹理四边形命令，按排序键做稳定的基数排序后提交。
+ */
+
+#include <cstdint>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <SDL3/SDL_rect.h>
+#include "render_order.h"
+
+struct SDL_Texture;
+
+namespace engine::render {
+
+	/**
+	 * @struct RenderCommand
+	 * @brief 一个已换算到屏幕坐标的纹理四边形。
+	 */
+	struct RenderCommand {
+		SDL_Texture* texture = nullptr;
+		glm::vec2 texture_size{ 0.0f, 0.0f };        ///< 纹理尺寸（计算 UV）
+		SDL_FRect src_rect{};                        ///< 纹理中的源矩形
+		SDL_FRect dest_rect{};                       ///< 屏幕上的目标矩形
+		double angle = 0.0;                          ///< 绕目标矩形中心的旋转角度（度）
+		bool flip_horizontal = false;                ///< 是否水平翻转
+	};
+
+	/**
+	 * @class RenderQueue
+	 * @brief 帧内绘制命令队列。
+	 *
+	 * 命令与排序键分开存放，排序只移动 (键, 下标) 对。基数排序为 LSD、每趟 8 位，
+	 * 所有键在某一字节上相同时跳过该趟（layer 与 depth 往往只有少数取值），排序稳定。
+	 */
+	class RenderQueue final {
+	private:
+		struct SortEntry {
+			std::uint64_t key;
+			std::uint32_t index;
+		};
+
+		std::vector<RenderCommand> commands_;        ///< 按提交顺序存放的命令（帧间复用）
+		std::vector<SortEntry> entries_;             ///< 排序键（排序后为提交顺序）
+		std::vector<SortEntry> scratch_;             ///< 基数排序的缓冲区（帧间复用）
+
+	public:
+		RenderQueue() = default;
+
+		/// 追加一条命令
+		void push(std::uint64_t key, const RenderCommand& command) {
+			entries_.push_back({ key, static_cast<std::uint32_t>(commands_.size()) });
+			commands_.push_back(command);
+		}
+
+		/// 按排序键稳定排序
+		void sort();
+
+		/**
+		 * @brief 按排序后的顺序遍历命令。
+		 * @param visit 形如 void(const RenderCommand&) 的回调。
+		 */
+		template<typename Visit>
+		void forEach(Visit&& visit) const {
+			for (const auto& entry : entries_) {
+				visit(commands_[entry.index]);
+			}
+		}
+
+		/// 清空命令（保留容量）
+		void clear() {
+			commands_.clear();
+			entries_.clear();
+		}
+
+		size_t size() const { return commands_.size(); }
+		bool empty() const { return commands_.empty(); }
+
+		// 禁用拷贝和移动语义
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+		RenderQueue(RenderQueue&&) = delete;
+		RenderQueue& operator=(RenderQueue&&) = delete;
+	};
+
+} // namespace engine::render
@@ -1,11 +1,13 @@
 #include "renderer.h"
 #include "../resource/resource_manager.h" // 确保包含完整类型声明
+#include "../resource/texture_atlas.h"
 #include "camera.h"
 #include "sprite.h"
 #include <SDL3/SDL.h>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 #include <cmath>
+#include <utility>
 
 namespace engine::render {
     /**
@@ -36,19 +38,21 @@ namespace engine::render {
      * @param position 精灵在世界空间中的左上角坐标。
      * @param scale 精灵的缩放比例。
      * @param angle 旋转角度（单位为度）。
+     * @param order 排序信息。
      */
 	void Renderer::drawSprite(const Camera& camera,
                               const Sprite& sprite,
                               const glm::vec2& position,
                               const glm::vec2& scale,
-                              double angle) {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
+                              double angle,
+                              const RenderOrder& order) {
+        const auto* region = resource_manager_->getTextureRegion(sprite.getTextureHandle());
+        if (!region) {
             spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
             return;
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, *region);
         if (!src_rect.has_value()) {
             spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
             return;
@@ -79,8 +83,8 @@ namespace engine::render {
             return;
         }
 
-        // 执行绘制(默认旋转中心为精灵的中心点)
-        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.getIsFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+        // 加入批次(旋转中心为精灵的中心点)
+        if (!submitQuad(order, region->bind_id, region->texture, region->texture_size, src_rect.value(), dest_rect, angle, sprite.getIsFlipped())) {
             spdlog::error("渲染旋转纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
         }
 	}
@@ -96,20 +100,22 @@ namespace engine::render {
      * @param scroll_factor 视差滚动因子 (0.0 表示跟随相机不动, 1.0 表示完全跟随世界移动)。
      * @param repeat 指定在各个轴上是否平铺填充。
      * @param scale 视觉缩放比例。
+     * @param order 排序信息。
      */
 	void Renderer::drawParallax(const Camera& camera,
                                 const Sprite& sprite,
                                 const glm::vec2& position,
                                 const glm::vec2& scroll_factor,
                                 const glm::bvec2& repeat,
-                                const glm::vec2& scale) {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-		if (!texture) {
+                                const glm::vec2& scale,
+                                const RenderOrder& order) {
+        const auto* region = resource_manager_->getTextureRegion(sprite.getTextureHandle());
+		if (!region) {
 			spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
 			return;
 		}
 
-		auto src_rect = getSpriteSrcRect(sprite);
+		auto src_rect = getSpriteSrcRect(sprite, *region);
 		if (!src_rect.has_value()) {
 			spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
 			return;
@@ -121,6 +127,8 @@ namespace engine::render {
 		float scaled_h = src_rect.value().h * scale.y;
 		glm::vec2 start, stop;
 		glm::vec2 viewport_size = camera.getViewportSize();
+        // 视差背景总是绘制整张图片（尺寸仍按源矩形计算；图片可能位于图集页内）
+        const SDL_FRect texture_rect = { region->offset.x, region->offset.y, region->size.x, region->size.y };
         
         if (repeat.x && scaled_w > 0) {
             float phase = std::fmod(position_screen.x, scaled_w);
@@ -149,7 +157,7 @@ namespace engine::render {
                 // 这里恢复为浮点并在尺寸上增加微小重叠(epsilon)以消除缝隙
                 SDL_FRect dest_rect = { x, y, scaled_w + 0.1f, scaled_h + 0.1f };
                 
-                if (!SDL_RenderTexture(renderer_, texture, nullptr, &dest_rect)) {
+                if (!submitQuad(order, region->bind_id, region->texture, region->texture_size, texture_rect, dest_rect, 0.0, false)) {
                     spdlog::error("渲染视差纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
                     return;
                 }
@@ -169,12 +177,12 @@ namespace engine::render {
     void Renderer::drawUISprite(const Sprite& sprite,
                                 const glm::vec2& position,
                                 const std::optional<glm::vec2>& size) {
-		auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
+		const auto* region = resource_manager_->getTextureRegion(sprite.getTextureHandle());
+        if (!region) {
             spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
             return;
         }
-		auto src_rect = getSpriteSrcRect(sprite);
+		auto src_rect = getSpriteSrcRect(sprite, *region);
 		if (!src_rect.has_value()) {
 			spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
 			return;
@@ -187,22 +195,228 @@ namespace engine::render {
             dest_w,
             dest_h
         };
-        if (!SDL_RenderTexture(renderer_, texture, &src_rect.value(), &dest_rect)) {
+        if (!pushQuad(region->texture, region->texture_size, src_rect.value(), dest_rect, 0.0, false)) {
             spdlog::error("渲染 UI 纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
         }
     }
 
+    /**
+     * @brief 在世界空间中绘制一张外部纹理。
+     * 
+     * 纹理按原始尺寸绘制，用于瓦片分块等由调用方持有的渲染目标纹理。
+     * 
+     * @param camera 当前活动相机。
+     * @param texture 纹理。
+     * @param texture_size 纹理尺寸。
+     * @param position 纹理左上角的世界坐标。
+     * @param order 排序信息。
+     */
+    void Renderer::drawTexture(const Camera& camera, SDL_Texture* texture, const glm::vec2& texture_size, const glm::vec2& position,
+                               const RenderOrder& order) {
+        const glm::vec2 position_screen = camera.worldToScreen(position);
+        const SDL_FRect dest_rect = { position_screen.x, position_screen.y, texture_size.x, texture_size.y };
+        if (!isRectInViewport(camera, dest_rect)) {
+            return;
+        }
+        const SDL_FRect src_rect = { 0.0f, 0.0f, texture_size.x, texture_size.y };
+        if (!submitQuad(order, engine::resource::TextureRegion::INVALID_BIND_ID, texture, texture_size, src_rect, dest_rect, 0.0, false)) {
+            spdlog::error("渲染纹理失败：{}", SDL_GetError());
+        }
+    }
+
+    /**
+     * @brief 开始收集世界空间的绘制命令。
+     */
+    void Renderer::beginQueue() {
+        queue_.clear();
+        queue_recording_ = true;
+    }
+
+    /**
+     * @brief 排序并提交队列。
+     * 
+     * 排序后的命令依次追加到批次，相邻的同纹理命令自然合并为一个批次。
+     */
+    void Renderer::submitQueue() {
+        queue_recording_ = false;
+        queue_.sort();
+        queue_.forEach([this](const RenderCommand& command) {
+            if (!pushQuad(command.texture, command.texture_size, command.src_rect, command.dest_rect, command.angle, command.flip_horizontal)) {
+                spdlog::error("提交渲染命令失败：{}", SDL_GetError());
+            }
+        });
+        queue_.clear();
+    }
+
+    /**
+     * @brief 把四边形加入队列或直接追加到批次。
+     * 
+     * @return 直接绘制时返回 pushQuad 的结果，加入队列时总是返回 true。
+     */
+    bool Renderer::submitQuad(const RenderOrder& order, std::uint32_t bind_id, SDL_Texture* texture, const glm::vec2& texture_size,
+                              const SDL_FRect& src_rect, const SDL_FRect& dest_rect, double angle, bool flip_horizontal) {
+        if (!queue_recording_) {
+            return pushQuad(texture, texture_size, src_rect, dest_rect, angle, flip_horizontal);
+        }
+        queue_.push(makeSortKey(order, bind_id), RenderCommand{ texture, texture_size, src_rect, dest_rect, angle, flip_horizontal });
+        return true;
+    }
+
+    /**
+     * @brief 把渲染目标切换为纹理并清空为透明。
+     * 
+     * @param target 渲染目标纹理。
+     * @return 成功返回 true。
+     */
+    bool Renderer::beginTextureTarget(SDL_Texture* target) {
+        flush();
+        if (!SDL_SetRenderTarget(renderer_, target)) {
+            spdlog::error("切换渲染目标失败：{}", SDL_GetError());
+            return false;
+        }
+        Uint8 r = 0, g = 0, b = 0, a = 0;
+        SDL_GetRenderDrawColor(renderer_, &r, &g, &b, &a);
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+        SDL_RenderClear(renderer_);
+        SDL_SetRenderDrawColor(renderer_, r, g, b, a);
+        ++frame_stats_.draw_calls;
+        return true;
+    }
+
+    /**
+     * @brief 提交批次并恢复窗口渲染目标。
+     */
+    void Renderer::endTextureTarget() {
+        flush();
+        if (!SDL_SetRenderTarget(renderer_, nullptr)) {
+            spdlog::error("恢复渲染目标失败：{}", SDL_GetError());
+        }
+    }
+
     /**
      * @brief 更新屏幕，将当前缓冲区的内容呈现。
      */
     void Renderer::present() {
+        flush();
         SDL_RenderPresent(renderer_);
+
+        last_frame_stats_ = frame_stats_;
+        total_stats_.draw_calls += frame_stats_.draw_calls;
+        total_stats_.sprites += frame_stats_.sprites;
+        total_stats_.batches += frame_stats_.batches;
+        frame_stats_ = RenderStats{};
+        ++frame_count_;
+        // 纹理可能在帧间被释放，下一帧重新查询尺寸
+        batch_texture_ = nullptr;
+    }
+
+    /**
+     * @brief 提交挂起的精灵批次。
+     * 
+     * 一个批次内的所有四边形共用同一纹理，通过一次 SDL_RenderGeometry 绘制。
+     */
+    void Renderer::flush() {
+        if (batch_indices_.empty()) {
+            return;
+        }
+        if (!SDL_RenderGeometry(renderer_, batch_texture_,
+                                batch_vertices_.data(), static_cast<int>(batch_vertices_.size()),
+                                batch_indices_.data(), static_cast<int>(batch_indices_.size()))) {
+            spdlog::error("提交精灵批次失败：{}", SDL_GetError());
+        }
+        ++frame_stats_.draw_calls;
+        ++frame_stats_.batches;
+        batch_vertices_.clear();
+        batch_indices_.clear();
+    }
+
+    /**
+     * @brief 在直接绘制之前提交批次并记录绘制调用数。
+     * 
+     * @param draw_calls 即将发生的绘制调用数。
+     */
+    void Renderer::flushForExternalDraw(size_t draw_calls) {
+        flush();
+        frame_stats_.draw_calls += draw_calls;
+    }
+
+    /**
+     * @brief 启用或关闭精灵批处理。
+     * 
+     * @param enabled 是否启用。
+     */
+    void Renderer::setBatchingEnabled(bool enabled) {
+        flush();
+        batching_enabled_ = enabled;
+    }
+
+    /**
+     * @brief 把一个纹理四边形追加到当前批次。
+     * 
+     * 纹理与当前批次不同时先提交旧批次。四个顶点按 SDL_RenderTextureRotated 的约定计算：
+     * 水平翻转交换左右 UV，再绕目标矩形中心顺时针旋转 angle 度。
+     * 纹理尺寸由调用方从句柄缓存中取得，切换纹理时不再查询 SDL。
+     * 
+     * @return 成功返回 true。
+     */
+    bool Renderer::pushQuad(SDL_Texture* texture, const glm::vec2& texture_size, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, double angle, bool flip_horizontal) {
+        ++frame_stats_.sprites;
+        if (!batching_enabled_) {
+            ++frame_stats_.draw_calls;
+            return SDL_RenderTextureRotated(renderer_, texture, &src_rect, &dest_rect, angle, nullptr,
+                                            flip_horizontal ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+        }
+
+        if (texture != batch_texture_ || batch_indices_.size() >= MAX_BATCH_QUADS * 6) {
+            flush();
+            if (texture != batch_texture_) {
+                if (texture_size.x <= 0.0f || texture_size.y <= 0.0f) {
+                    batch_texture_ = nullptr;
+                    return false;
+                }
+                batch_texture_ = texture;
+                batch_texture_size_ = texture_size;
+            }
+        }
+
+        float u0 = src_rect.x / batch_texture_size_.x;
+        float u1 = (src_rect.x + src_rect.w) / batch_texture_size_.x;
+        const float v0 = src_rect.y / batch_texture_size_.y;
+        const float v1 = (src_rect.y + src_rect.h) / batch_texture_size_.y;
+        if (flip_horizontal) {
+            std::swap(u0, u1);
+        }
+
+        // 以目标矩形中心为原点的四个角（左上、右上、右下、左下）
+        const float half_w = dest_rect.w * 0.5f;
+        const float half_h = dest_rect.h * 0.5f;
+        const glm::vec2 center = { dest_rect.x + half_w, dest_rect.y + half_h };
+        glm::vec2 corners[4] = { { -half_w, -half_h }, { half_w, -half_h }, { half_w, half_h }, { -half_w, half_h } };
+        if (angle != 0.0) {
+            const double radians = angle * (3.14159265358979323846 / 180.0);
+            const float c = static_cast<float>(std::cos(radians));
+            const float s = static_cast<float>(std::sin(radians));
+            for (auto& corner : corners) {
+                corner = { corner.x * c - corner.y * s, corner.x * s + corner.y * c };
+            }
+        }
+
+        const SDL_FColor white = { 1.0f, 1.0f, 1.0f, 1.0f };
+        const float us[4] = { u0, u1, u1, u0 };
+        const float vs[4] = { v0, v0, v1, v1 };
+        const int base = static_cast<int>(batch_vertices_.size());
+        for (int i = 0; i < 4; ++i) {
+            batch_vertices_.push_back({ { center.x + corners[i].x, center.y + corners[i].y }, white, { us[i], vs[i] } });
+        }
+        batch_indices_.insert(batch_indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        return true;
     }
 
     /**
      * @brief 清除当前渲染目标的所有内容。
      */
     void Renderer::clearScreen() {
+        flush();
         if (SDL_RenderClear(renderer_) == false) {
             spdlog::error("清除渲染器失败：{}", SDL_GetError());
         }
@@ -225,33 +439,31 @@ namespace engine::render {
     /**
      * @brief 获取精灵在纹理中的源矩形。
      * 
-     * 如果精灵没有自定义裁剪区域，则返回纹理的完整尺寸。
+     * 如果精灵没有自定义裁剪区域，则返回图片的完整尺寸。结果已加上区域偏移，
+     * 纹理位于图集页内时直接得到图集坐标。
      * 
      * @param sprite 精灵对象。
+     * @param region 精灵纹理的区域（句柄缓存值）。
      * @return std::optional<SDL_FRect> 成功返回矩形区域，失败返回 nullopt。
      */
-    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite) {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
-            spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
-            return std::nullopt;
-        }
+    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite, const engine::resource::TextureRegion& region) {
         auto src_rect = sprite.getSourceRect();
         if (src_rect.has_value()) {
             if (src_rect.value().w <= 0 || src_rect.value().h <= 0) {
                 spdlog::error("源矩形尺寸无效，ID: {}", sprite.getTextureId());
                 return std::nullopt;
             }
-            return src_rect;
         }
         else {
-            SDL_FRect result = { 0, 0, 0, 0 };
-            if (!SDL_GetTextureSize(texture, &result.w, &result.h)) {
+            if (region.size.x <= 0.0f || region.size.y <= 0.0f) {
                 spdlog::error("无法获取纹理尺寸，ID: {}", sprite.getTextureId());
                 return std::nullopt;
             }
-            return result;
+            src_rect = SDL_FRect{ 0.0f, 0.0f, region.size.x, region.size.y };
         }
+        src_rect->x += region.offset.x;
+        src_rect->y += region.offset.y;
+        return src_rect;
     }
 
     /**
@@ -327,7 +539,8 @@ namespace engine::render {
                                static_cast<Uint8>(color.b * 255),
                                static_cast<Uint8>(color.a * 255));
 
-        // 填充矩形
+        // 填充矩形（先提交批次以保持绘制顺序）
+        flushForExternalDraw();
         if (!SDL_RenderFillRect(renderer_, &sdl_rect)) {
             spdlog::error("渲染填充矩形失败：{}", SDL_GetError());
         }
@@ -358,7 +571,8 @@ namespace engine::render {
                                static_cast<Uint8>(color.b * 255),
                                static_cast<Uint8>(color.a * 255));
 
-        // 绘制矩形边框
+        // 绘制矩形边框（先提交批次以保持绘制顺序）
+        flushForExternalDraw();
         if (!SDL_RenderRect(renderer_, &sdl_rect)) {
             spdlog::error("渲染矩形边框失败：{}", SDL_GetError());
         }
@@ -1,19 +1,41 @@
 #pragma once
 #include "sprite.h"
+#include <vector>
 #include <glm/glm.hpp>
+#include <SDL3/SDL_render.h>
 #include "../utils/math.h"
+#include "tile_chunk_cache.h"
+#include "render_queue.h"
 
-struct SDL_Renderer;
 namespace engine::resource {
 	class ResourceManager;
+	struct TextureRegion;
 }
 
 namespace engine::render {
 	class Camera;
 
+	/**
+	 * @struct RenderStats
+	 * @brief 渲染统计，用于确认批处理的效果。
+	 */
+	struct RenderStats {
+		size_t draw_calls = 0;   ///< 提交给 SDL 的绘制调用数（含批次、矩形与文本）
+		size_t sprites = 0;      ///< 绘制的精灵四边形数
+		size_t batches = 0;      ///< 其中通过 SDL_RenderGeometry 提交的批次数
+	};
+
 	/**
 	 * @class Renderer
 	 * @brief 核心渲染类，负责封装 SDL 渲染操作和处理场景绘制逻辑。
+	 *
+	 * 精灵、视差背景和 UI 精灵不会立即绘制，而是把四边形（含 UV、翻转与旋转）追加到当前批次，
+	 * 纹理变化、需要直接绘制的操作（矩形、文本）或帧结束时通过一次 SDL_RenderGeometry 提交，
+	 * 因此连续使用同一纹理的瓦片和精灵只产生一次绘制调用，绘制顺序保持不变。
+	 *
+	 * 在 beginQueue() 与 submitQueue() 之间，世界空间的绘制（drawSprite / drawParallax / drawTexture）
+	 * 不直接进入批次，而是带着 RenderOrder 排序键进入 RenderQueue，提交时排序后再依次合批，
+	 * 绘制顺序由排序键决定，同层同 z 的命令按纹理分组。UI 绘制始终立即执行。
 	 */
 	class Renderer final {
 	private:
@@ -22,6 +44,24 @@ namespace engine::render {
 		/// 用于获取纹理和资源的管理类指针
 		engine::resource::ResourceManager* resource_manager_ = nullptr;
 
+		static constexpr size_t MAX_BATCH_QUADS = 8192;   ///< 单个批次的四边形上限
+
+		bool batching_enabled_ = true;                    ///< 关闭时每个精灵单独调用 SDL_RenderTextureRotated（用于对比）
+		SDL_Texture* batch_texture_ = nullptr;            ///< 当前批次的纹理
+		glm::vec2 batch_texture_size_{ 0.0f, 0.0f };      ///< 当前批次纹理的尺寸（计算 UV）
+		std::vector<SDL_Vertex> batch_vertices_;          ///< 当前批次的顶点（帧间复用）
+		std::vector<int> batch_indices_;                  ///< 当前批次的索引（帧间复用）
+
+		RenderStats frame_stats_;                         ///< 当前帧的统计
+		RenderStats last_frame_stats_;                    ///< 上一帧的统计
+		RenderStats total_stats_;                         ///< 累计统计
+		size_t frame_count_ = 0;                          ///< 已呈现的帧数
+
+		TileChunkCache tile_chunk_cache_;                 ///< 静态瓦片图层的分块纹理缓存（所有图层共用预算）
+
+		RenderQueue queue_;                               ///< 世界空间绘制命令队列（帧间复用）
+		bool queue_recording_ = false;                    ///< 是否正在把世界空间绘制收集到队列
+
 	public:
 		/**
 		 * @brief 构造 Renderer 实例。
@@ -39,12 +79,14 @@ namespace engine::render {
 		 * @param position 精灵的世界空间位置。
 		 * @param scale 缩放比例，默认为 {1.0f, 1.0f}。
 		 * @param angle 旋转角度（度），默认为 0.0f。
+		 * @param order 排序信息（仅在收集队列时使用）。
 		 */
 		void drawSprite(const Camera& camera,
 						const Sprite& sprite, 
 						const glm::vec2& position, 
 						const glm::vec2& scale = { 1.0f, 1.0f }, 
-						double angle = 0.0f);
+						double angle = 0.0f,
+						const RenderOrder& order = {});
 
 		/**
 		 * @brief 绘制具有视差滚动效果的精灵（通常用于背景）。
@@ -54,13 +96,15 @@ namespace engine::render {
 		 * @param scroll_factor 滚动因子（例如 0.5f 表示移动速度是相机的一半）。
 		 * @param repeat 是否在 X/Y 轴上重复平铺。
 		 * @param scale 缩放比例。
+		 * @param order 排序信息（仅在收集队列时使用）。
 		 */
 		void drawParallax(const Camera& camera,
 						  const Sprite& sprite, 
 						  const glm::vec2& position,
 						  const glm::vec2& scroll_factor,
 						  const glm::bvec2& repeat = { true, true },
-						  const glm::vec2& scale = { 1.0f, 1.0f });
+						  const glm::vec2& scale = { 1.0f, 1.0f },
+						  const RenderOrder& order = {});
 
 		/**
 		 * @brief 在屏幕空间（UI 层）中绘制一个精灵。
@@ -72,6 +116,42 @@ namespace engine::render {
 					  const glm::vec2& position, 
 					  const std::optional<glm::vec2>& size = std::nullopt);
 
+		/**
+		 * @brief 在世界空间中按原始尺寸绘制一张不由 ResourceManager 管理的纹理（如瓦片分块）。
+		 * @param camera 用于计算屏幕坐标的相机。
+		 * @param texture 纹理。
+		 * @param texture_size 纹理尺寸。
+		 * @param position 纹理左上角的世界坐标。
+		 * @param order 排序信息（仅在收集队列时使用）。
+		 */
+		void drawTexture(const Camera& camera, SDL_Texture* texture, const glm::vec2& texture_size, const glm::vec2& position,
+						 const RenderOrder& order = {});
+
+		/**
+		 * @brief 开始收集世界空间的绘制命令。
+		 * @details 之后的 drawSprite / drawParallax / drawTexture 进入队列，直到 submitQueue()。
+		 */
+		void beginQueue();
+
+		/**
+		 * @brief 按排序键排序队列中的命令并提交到批次，然后恢复立即绘制。
+		 */
+		void submitQueue();
+
+		/// 是否正在收集队列
+		bool isQueueRecording() const { return queue_recording_; }
+
+		/**
+		 * @brief 把后续绘制重定向到渲染目标纹理，并清空为透明。
+		 * @param target SDL_TEXTUREACCESS_TARGET 纹理。
+		 * @return 成功返回 true；失败时渲染目标保持不变。
+		 * @details 切换前先提交挂起的批次，结束后必须调用 endTextureTarget()。
+		 */
+		bool beginTextureTarget(SDL_Texture* target);
+
+		/// 提交批次并把渲染目标恢复为窗口
+		void endTextureTarget();
+
 		/**
 		 * @brief 在屏幕空间（UI 层）中绘制一个填充矩形。
 		 * @param rect 矩形区域。
@@ -87,10 +167,37 @@ namespace engine::render {
 		void drawUIOutlineRect(const engine::utils::Rect& rect, const engine::utils::FColor& color);
 
 		/**
-		 * @brief 将当前的后备缓冲区呈现到屏幕。
+		 * @brief 将当前的后备缓冲区呈现到屏幕（先提交挂起的批次）。
 		 */
 		void present();
 
+		/**
+		 * @brief 立即提交挂起的精灵批次。
+		 */
+		void flush();
+
+		/**
+		 * @brief 在绕过 Renderer 直接向 SDL 渲染器绘制（如 SDL3_ttf 文本）之前调用。
+		 * @param draw_calls 即将发生的绘制调用数，计入统计。
+		 * @details 先提交挂起的批次，保证绘制顺序不变。
+		 */
+		void flushForExternalDraw(size_t draw_calls = 1);
+
+		/// 启用/关闭精灵批处理（切换前会先提交挂起的批次）
+		void setBatchingEnabled(bool enabled);
+		bool isBatchingEnabled() const { return batching_enabled_; }
+
+		/// 上一帧的渲染统计
+		const RenderStats& getLastFrameStats() const { return last_frame_stats_; }
+		/// 自启动以来的累计渲染统计
+		const RenderStats& getTotalStats() const { return total_stats_; }
+		/// 已呈现的帧数
+		size_t getFrameCount() const { return frame_count_; }
+
+		/// 瓦片分块纹理缓存
+		TileChunkCache& getTileChunkCache() { return tile_chunk_cache_; }
+		const TileChunkCache& getTileChunkCache() const { return tile_chunk_cache_; }
+
 		/**
 		 * @brief 清除当前屏幕缓冲区。
 		 */
@@ -117,9 +224,31 @@ namespace engine::render {
 		/**
 		 * @brief 根据精灵状态（如动画帧）计算纹理的源矩形区域。
 		 * @param sprite 精灵对象。
-		 * @return std::optional<SDL_FRect> 源矩形，若无有效纹理则返回 nullopt。
+		 * @param region 精灵纹理的区域（可能位于图集页内）。
+		 * @return std::optional<SDL_FRect> 已换算到实际纹理坐标的源矩形，若无有效纹理则返回 nullopt。
+		 */
+		std::optional<SDL_FRect> getSpriteSrcRect(const Sprite& sprite, const engine::resource::TextureRegion& region);
+
+		/**
+		 * @brief 把一个纹理四边形追加到批次（批处理关闭时直接绘制）。
+		 * @param texture 纹理。
+		 * @param texture_size 纹理尺寸（用于计算 UV）。
+		 * @param src_rect 纹理中的源矩形（像素）。
+		 * @param dest_rect 屏幕上的目标矩形。
+		 * @param angle 绕目标矩形中心的旋转角度（度，顺时针）。
+		 * @param flip_horizontal 是否水平翻转。
+		 * @return 成功返回 true。
+		 */
+		bool pushQuad(SDL_Texture* texture, const glm::vec2& texture_size, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, double angle, bool flip_horizontal);
+
+		/**
+		 * @brief 收集队列时把四边形加入队列，否则直接追加到批次。
+		 * @param order 排序信息。
+		 * @param bind_id 纹理绑定编号（参与排序键）。
+		 * @return 成功返回 true。
 		 */
-		std::optional<SDL_FRect> getSpriteSrcRect(const Sprite& sprite);
+		bool submitQuad(const RenderOrder& order, std::uint32_t bind_id, SDL_Texture* texture, const glm::vec2& texture_size,
+						const SDL_FRect& src_rect, const SDL_FRect& dest_rect, double angle, bool flip_horizontal);
 
 		/**
 		 * @brief 检查一个矩形是否在相机的可见视口内。
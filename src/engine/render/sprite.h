@@ -3,6 +3,7 @@
 #include <string>
 #include <optional>
 #include <SDL3/SDL_rect.h>
+#include "../resource/texture_handle.h"
 
 namespace engine::render {
 	/**
@@ -11,8 +12,8 @@ namespace engine::render {
 	 */
 	class Sprite final {
 	private:
-		/** @brief 纹理在资源管理器中的唯一标识符 */
-		std::string texture_id_;
+		/** @brief 纹理句柄（创建时由纹理路径解析一次，绘制时直接作为下标使用） */
+		engine::resource::TextureHandle texture_handle_;
 
 		/** @brief 纹理的源裁剪矩形。如果为 nullopt，则渲染整个纹理。 */
 		std::optional<SDL_FRect> source_rect_;
@@ -32,7 +33,18 @@ namespace engine::render {
 		explicit Sprite(const std::string& texture_id,
 						const std::optional<SDL_FRect>& source_rect = std::nullopt, 
 						bool is_flipped = false)
-						: texture_id_(texture_id), source_rect_(source_rect), is_flipped_(is_flipped) {}
+						: texture_handle_(engine::resource::TextureRegistry::acquire(texture_id)), source_rect_(source_rect), is_flipped_(is_flipped) {}
+
+		/**
+		 * @brief 使用已解析的纹理句柄构造 Sprite。
+		 * @param texture_handle 纹理句柄。
+		 * @param source_rect 纹理的源裁剪区域，默认为 nullopt。
+		 * @param is_flipped 是否水平翻转，默认为 false。
+		 */
+		explicit Sprite(engine::resource::TextureHandle texture_handle,
+						const std::optional<SDL_FRect>& source_rect = std::nullopt,
+						bool is_flipped = false)
+						: texture_handle_(texture_handle), source_rect_(source_rect), is_flipped_(is_flipped) {}
 
 		/** @brief 默认析构函数 */
 		~Sprite() = default;
@@ -40,10 +52,15 @@ namespace engine::render {
 		// Getters
 
 		/**
-		 * @brief 获取纹理的标识符。
-		 * @return 纹理 ID 的常量引用。
+		 * @brief 获取纹理的标识符（路径），用于日志和重新构造 Sprite，绘制时使用句柄。
+		 * @return 纹理 ID 的常量引用，没有纹理时为空字符串。
 		 */
-		[[nodiscard]] const std::string& getTextureId() const { return texture_id_; }
+		[[nodiscard]] const std::string& getTextureId() const { return engine::resource::TextureRegistry::getPath(texture_handle_); }
+
+		/**
+		 * @brief 获取纹理句柄。
+		 */
+		[[nodiscard]] engine::resource::TextureHandle getTextureHandle() const { return texture_handle_; }
 
 		/**
 		 * @brief 获取纹理的源裁剪矩形。
@@ -63,7 +80,13 @@ namespace engine::render {
 		 * @brief 设置纹理的标识符。
 		 * @param texture_id 新的纹理 ID。
 		 */
-		void setTextureId(const std::string& texture_id) { texture_id_ = texture_id; }
+		void setTextureId(const std::string& texture_id) { texture_handle_ = engine::resource::TextureRegistry::acquire(texture_id); }
+
+		/**
+		 * @brief 设置纹理句柄。
+		 * @param texture_handle 新的纹理句柄。
+		 */
+		void setTextureHandle(engine::resource::TextureHandle texture_handle) { texture_handle_ = texture_handle; }
 
 		/**
 		 * @brief 设置纹理的源裁剪矩形。
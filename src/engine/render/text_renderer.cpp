@@ -1,5 +1,6 @@
 #include "text_renderer.h"
 #include "camera.h"
+#include "renderer.h"
 #include <stdexcept>
 #include <string>
 #include <glm/glm.hpp>
@@ -18,10 +19,11 @@ namespace engine::render {
      * @brief 构造 TextRenderer 实例。
      * @param sdl_renderer SDL 渲染器指针
      * @param resource_manager 资源管理器指针
+     * @param sprite_renderer 精灵渲染器指针，可为空
      * @throw std::runtime_error 如果初始化失败
      */
-    TextRenderer::TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager)
-        : sdl_renderer_(sdl_renderer), resource_manager_(resource_manager) {
+    TextRenderer::TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager, Renderer* sprite_renderer)
+        : sdl_renderer_(sdl_renderer), resource_manager_(resource_manager), sprite_renderer_(sprite_renderer) {
 
         ++text_renderer_instances;
         
@@ -61,6 +63,12 @@ namespace engine::render {
         }
     }
     
+    void TextRenderer::flushSpriteBatch() {
+        if (sprite_renderer_) {
+            sprite_renderer_->flushForExternalDraw(2);
+        }
+    }
+
     /**
      * @brief 在世界空间中绘制文本（跟随相机移动）。
      * @param camera 用于计算屏幕坐标的相机
@@ -90,6 +98,7 @@ namespace engine::render {
         if (!ttf_text) {
             return;
         }
+        flushSpriteBatch();
         TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
         TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2);
         
@@ -146,6 +155,7 @@ namespace engine::render {
             }
         }
 
+        flushSpriteBatch();
         TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
         TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2);
 
@@ -169,6 +179,7 @@ namespace engine::render {
             return;
         }
         
+        flushSpriteBatch();
         TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
         TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2); 
 
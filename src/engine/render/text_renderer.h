@@ -24,6 +24,7 @@ namespace engine::resource {
 
 namespace engine::render {
     class Camera;
+    class Renderer;
 
     /**
      * @class TextRenderer
@@ -39,6 +40,8 @@ namespace engine::render {
         SDL_Renderer* sdl_renderer_ = nullptr;
         /// 资源管理器指针，用于获取字体
         engine::resource::ResourceManager* resource_manager_ = nullptr;
+        /// 精灵渲染器，绘制文本前提交其挂起的批次以保持绘制顺序（可为空）
+        Renderer* sprite_renderer_ = nullptr;
         /// SDL3_ttf 文本引擎，用于高效渲染文本
         TTF_TextEngine* text_engine_ = nullptr;
         struct TTFTextDeleter {
@@ -50,8 +53,9 @@ namespace engine::render {
          * @brief 构造 TextRenderer 实例。
          * @param sdl_renderer SDL 渲染器指针。
          * @param resource_manager 资源管理器指针。
+         * @param sprite_renderer 共用同一 SDL 渲染器的精灵渲染器，可为空。
          */
-        TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager);
+        TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager, Renderer* sprite_renderer = nullptr);
 
         /**
          * @brief 析构函数，释放资源。
@@ -117,6 +121,8 @@ namespace engine::render {
         TextRenderer(TextRenderer&&) = delete;
         TextRenderer& operator=(TextRenderer&&) = delete;
     private:
+        /// 绘制前提交精灵批次（每段文本绘制两次：阴影与正文）
+        void flushSpriteBatch();
         TTF_Text* getTTFText(const std::string& text);
         TTF_Text* createTTFText(const std::string& text, TTF_Font* font);
     };
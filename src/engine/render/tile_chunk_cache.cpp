@@ -0,0 +1,138 @@
+#include "tile_chunk_cache.h"
+#include <algorithm>
+#include <atomic>
+#include <SDL3/SDL_render.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+void TileChunkCache::SDLTextureDeleter::operator()(SDL_Texture* texture) const
+{
+	if (texture) {
+		SDL_DestroyTexture(texture);
+	}
+}
+
+TileChunkCache::~TileChunkCache() = default;
+
+/**
+ * @brief 生成新的图层 id
+ *
+ * @details 使用 id 而不是图层指针作为键，避免图层销毁后同一地址上的新图层取到旧块。
+ */
+std::uint32_t TileChunkCache::nextOwnerId()
+{
+	static std::atomic<std::uint32_t> next_id{ 1 };
+	return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 查找已烘焙的块
+ */
+SDL_Texture* TileChunkCache::find(std::uint32_t owner, const glm::ivec2& chunk, std::size_t frame)
+{
+	for (auto& entry : entries_) {
+		if (entry.owner == owner && entry.chunk == chunk) {
+			entry.last_used_frame = frame;
+			return entry.texture.get();
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @brief 创建块纹理
+ *
+ * @details 纹理使用预乘 alpha 混合：瓦片以普通 alpha 混合烘焙到透明背景后，颜色已乘过 alpha，
+ *          合成到屏幕时再按普通混合会让半透明边缘变暗。
+ */
+SDL_Texture* TileChunkCache::create(SDL_Renderer* renderer, std::uint32_t owner, const glm::ivec2& chunk, const glm::ivec2& size, std::size_t frame)
+{
+	const std::size_t bytes = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * BYTES_PER_PIXEL;
+	if (!evictFor(bytes, frame) && !over_budget_warned_) {
+		spdlog::warn("瓦片分块缓存超出预算：可见块需要 {} KB，预算 {} KB", (used_bytes_ + bytes) / 1024, budget_bytes_ / 1024);
+		over_budget_warned_ = true;
+	}
+
+	SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+	if (!texture) {
+		spdlog::error("创建瓦片分块纹理失败 ({}x{})：{}", size.x, size.y, SDL_GetError());
+		return nullptr;
+	}
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+	SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+	Entry entry;
+	entry.owner = owner;
+	entry.chunk = chunk;
+	entry.size = size;
+	entry.last_used_frame = frame;
+	entry.texture.reset(texture);
+	entries_.push_back(std::move(entry));
+	used_bytes_ += bytes;
+	++bake_count_;
+	return texture;
+}
+
+/**
+ * @brief 释放某个图层的所有块
+ */
+void TileChunkCache::release(std::uint32_t owner)
+{
+	auto it = std::remove_if(entries_.begin(), entries_.end(), [owner](const Entry& entry) { return entry.owner == owner; });
+	for (auto released = it; released != entries_.end(); ++released) {
+		used_bytes_ -= static_cast<std::size_t>(released->size.x) * static_cast<std::size_t>(released->size.y) * BYTES_PER_PIXEL;
+	}
+	entries_.erase(it, entries_.end());
+}
+
+/**
+ * @brief 释放所有块
+ */
+void TileChunkCache::clear()
+{
+	entries_.clear();
+	used_bytes_ = 0;
+}
+
+/**
+ * @brief 启用/关闭分块缓存，关闭时立即释放所有块
+ */
+void TileChunkCache::setEnabled(bool enabled)
+{
+	enabled_ = enabled;
+	if (!enabled_) {
+		clear();
+	}
+}
+
+/**
+ * @brief 按 LRU 淘汰块
+ *
+ * @param bytes 即将新建的块所需的字节数
+ * @param frame 当前帧号，本帧使用过的块不淘汰
+ * @return 淘汰后能否在预算内容纳新块
+ */
+bool TileChunkCache::evictFor(std::size_t bytes, std::size_t frame)
+{
+	while (used_bytes_ + bytes > budget_bytes_) {
+		auto victim = entries_.end();
+		for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+			if (it->last_used_frame < frame && (victim == entries_.end() || it->last_used_frame < victim->last_used_frame)) {
+				victim = it;
+			}
+		}
+		if (victim == entries_.end()) {
+			return false;
+		}
+		used_bytes_ -= static_cast<std::size_t>(victim->size.x) * static_cast<std::size_t>(victim->size.y) * BYTES_PER_PIXEL;
+		if (victim != entries_.end() - 1) {
+			*victim = std::move(entries_.back());
+		}
+		entries_.pop_back();
+		++eviction_count_;
+	}
+	return true;
+}
+
+} // namespace engine::render
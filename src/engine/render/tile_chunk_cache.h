@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * @file tile_chunk_cache.h
+ * @brief 定义 TileChunkCache，保存静态瓦片图层预烘焙的分块渲染目标纹理，并在显存预算内按 LRU 淘汰。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/ext/vector_int2.hpp>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine::render {
+
+	/**
+	 * @class TileChunkCache
+	 * @brief 所有瓦片图层共用的分块纹理缓存。
+	 *
+	 * 每个块由（图层 id，块坐标）标识，纹理为 SDL_TEXTUREACCESS_TARGET，由图层在块首次进入视野时烘焙。
+	 * 所有块共享同一个显存预算：新建块时超出预算则淘汰最久未使用的块，
+	 * 但本帧已使用的块不会被淘汰（预算小于可见块总量时会暂时超出并给出一次警告）。
+	 */
+	class TileChunkCache final {
+	public:
+		static constexpr int CHUNK_SIZE = 512;                     ///< 块的边长（像素）
+		static constexpr std::size_t BYTES_PER_PIXEL = 4;          ///< RGBA8888
+
+	private:
+		struct SDLTextureDeleter {
+			void operator()(SDL_Texture* texture) const;
+		};
+
+		struct Entry {
+			std::uint32_t owner = 0;                               ///< 图层 id
+			glm::ivec2 chunk{ 0, 0 };                              ///< 块坐标
+			glm::ivec2 size{ 0, 0 };                               ///< 纹理尺寸（像素）
+			std::size_t last_used_frame = 0;                       ///< 最近一次使用的帧号
+			std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+		};
+
+		std::vector<Entry> entries_;                               ///< 常驻的块（数量很少，线性查找）
+		bool enabled_ = true;                                      ///< 关闭时图层逐瓦片绘制
+		std::size_t budget_bytes_ = 64u * 1024u * 1024u;           ///< 显存预算
+		std::size_t used_bytes_ = 0;                               ///< 常驻块占用的显存
+		std::size_t bake_count_ = 0;                               ///< 累计烘焙次数
+		std::size_t eviction_count_ = 0;                           ///< 累计淘汰次数
+		bool over_budget_warned_ = false;
+
+	public:
+		TileChunkCache() = default;
+		~TileChunkCache();
+
+		/// 生成一个新的图层 id（线程安全，可在后台加载线程中构造图层）
+		static std::uint32_t nextOwnerId();
+
+		/**
+		 * @brief 查找已烘焙的块，并把它标记为本帧使用。
+		 * @return 块纹理，不存在时返回 nullptr。
+		 */
+		SDL_Texture* find(std::uint32_t owner, const glm::ivec2& chunk, std::size_t frame);
+
+		/**
+		 * @brief 为块创建渲染目标纹理，必要时按 LRU 淘汰其它块。
+		 * @param renderer SDL 渲染器。
+		 * @param owner 图层 id。
+		 * @param chunk 块坐标。
+		 * @param size 纹理尺寸（像素，不超过 CHUNK_SIZE）。
+		 * @param frame 当前帧号。
+		 * @return 新纹理（内容未初始化，由调用方烘焙），失败返回 nullptr。
+		 */
+		SDL_Texture* create(SDL_Renderer* renderer, std::uint32_t owner, const glm::ivec2& chunk, const glm::ivec2& size, std::size_t frame);
+
+		/// 释放某个图层的所有块（图层销毁时调用）
+		void release(std::uint32_t owner);
+
+		/// 释放所有块
+		void clear();
+
+		void setEnabled(bool enabled);
+		bool isEnabled() const { return enabled_; }
+
+		/// 设置显存预算（字节），超出部分在下次创建块时淘汰
+		void setBudgetBytes(std::size_t budget_bytes) { budget_bytes_ = budget_bytes; }
+		std::size_t getBudgetBytes() const { return budget_bytes_; }
+
+		std::size_t getUsedBytes() const { return used_bytes_; }
+		std::size_t getResidentCount() const { return entries_.size(); }
+		std::size_t getBakeCount() const { return bake_count_; }
+		std::size_t getEvictionCount() const { return eviction_count_; }
+
+		// 禁用拷贝和移动语义
+		TileChunkCache(const TileChunkCache&) = delete;
+		TileChunkCache& operator=(const TileChunkCache&) = delete;
+		TileChunkCache(TileChunkCache&&) = delete;
+		TileChunkCache& operator=(TileChunkCache&&) = delete;
+
+	private:
+		/// 淘汰本帧未使用的最久未用块，直到能容纳 bytes；返回是否已满足预算
+		bool evictFor(std::size_t bytes, std::size_t frame);
+	};
+
+} // namespace engine::render
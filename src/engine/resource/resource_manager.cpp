@@ -44,6 +44,15 @@ SDL_Texture* engine::resource::ResourceManager::getTexture(const std::string& fi
 	return texture_manager_->getTexture(file_path);
 }
 
+/**
+ * @brief 通过纹理句柄获取纹理。
+ * @param handle 纹理句柄。
+ * @return SDL_Texture 指针。
+ */
+SDL_Texture* engine::resource::ResourceManager::getTexture(TextureHandle handle) {
+	return texture_manager_->getTexture(handle);
+}
+
 /**
  * @brief 卸载指定的纹理资源并从缓存中移除。
  * @param file_path 要卸载的纹理文件路径。
@@ -61,6 +70,79 @@ glm::vec2 engine::resource::ResourceManager::getTextureSize(const std::string& f
 	return texture_manager_->getTextureSize(file_path);
 }
 
+/**
+ * @brief 通过纹理句柄获取纹理尺寸。
+ * @param handle 纹理句柄。
+ * @return 包含宽度（x）和高度（y）的 glm::vec2。
+ */
+glm::vec2 engine::resource::ResourceManager::getTextureSize(TextureHandle handle) {
+	return texture_manager_->getTextureSize(handle);
+}
+
+/**
+ * @brief 通过纹理句柄获取纹理区域。
+ * @param handle 纹理句柄。
+ * @return 纹理区域指针，失败返回 nullptr。
+ */
+const engine::resource::TextureRegion* engine::resource::ResourceManager::getTextureRegion(TextureHandle handle) {
+	return texture_manager_->getTextureRegion(handle);
+}
+
+/**
+ * @brief 把一组图片打包为纹理图集。
+ * @param file_paths 图片路径。
+ * @return 打包进图集的图片数量。
+ */
+size_t engine::resource::ResourceManager::buildTextureAtlas(const std::vector<std::string>& file_paths) {
+	return texture_manager_->buildAtlas(file_paths);
+}
+
+/**
+ * @brief 设置是否启用纹理图集。
+ */
+void engine::resource::ResourceManager::setTextureAtlasEnabled(bool enabled) {
+	texture_manager_->setAtlasEnabled(enabled);
+	if (!enabled) {
+		texture_manager_->clearAtlas();
+	}
+}
+
+/**
+ * @brief 预加载使用的图集页边长。
+ */
+int engine::resource::ResourceManager::getTextureAtlasPageSize() const {
+	return texture_manager_->getAtlasPageSize();
+}
+
+/**
+ * @brief 解码一组图片并排好图集页（可在后台线程调用）。
+ */
+std::unique_ptr<engine::resource::PreparedTextures> engine::resource::ResourceManager::prepareTextures(
+	const std::vector<std::string>& file_paths, int page_size, const std::atomic<bool>* cancelled) {
+	return TextureManager::prepareTextures(file_paths, page_size, cancelled);
+}
+
+/**
+ * @brief 暂存预加载的图片。
+ */
+void engine::resource::ResourceManager::stageTextures(std::unique_ptr<PreparedTextures> prepared) {
+	texture_manager_->stageTextures(std::move(prepared));
+}
+
+/**
+ * @brief 在时间预算内上传暂存的图片。
+ */
+bool engine::resource::ResourceManager::uploadStagedTextures(float budget_ms) {
+	return texture_manager_->uploadStagedTextures(budget_ms);
+}
+
+/**
+ * @brief 丢弃暂存的图片。
+ */
+void engine::resource::ResourceManager::discardStagedTextures() {
+	texture_manager_->discardStagedTextures();
+}
+
 /**
  * @brief 清空所有已加载的纹理资源。
  */
@@ -1,7 +1,10 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
+#include "texture_handle.h"
 
 // Forward declarations of SDL and SDL-related types in global namespace
 struct SDL_Renderer;
@@ -11,6 +14,8 @@ struct TTF_Font;
 
 namespace engine::resource {
 	class TextureManager;
+	struct TextureRegion;
+	struct PreparedTextures;
 	class FontManager;
 	class AudioManager;
 
@@ -59,6 +64,13 @@ namespace engine::resource {
 		 */
 		SDL_Texture* getTexture(const std::string& file_path);
 
+		/**
+		 * @brief 通过纹理句柄获取纹理（绘制时使用，不对路径做哈希）。
+		 * @param handle 纹理句柄。
+		 * @return SDL_Texture 指针，失败返回 nullptr。
+		 */
+		SDL_Texture* getTexture(TextureHandle handle);
+
 		/**
 		 * @brief 卸载指定的纹理资源并从缓存中移除。
 		 * @param file_path 要卸载的纹理文件路径。
@@ -72,6 +84,62 @@ namespace engine::resource {
 		 */
 		glm::vec2 getTextureSize(const std::string& file_path);
 
+		/**
+		 * @brief 通过纹理句柄获取纹理尺寸（加载时缓存）。
+		 * @param handle 纹理句柄。
+		 * @return 包含宽度（x）和高度（y）的 glm::vec2。
+		 */
+		glm::vec2 getTextureSize(TextureHandle handle);
+
+		/**
+		 * @brief 通过纹理句柄获取纹理区域（纹理可能是图集页，绘制时需加上区域偏移）。
+		 * @param handle 纹理句柄。
+		 * @return 纹理区域指针，失败返回 nullptr。
+		 */
+		const TextureRegion* getTextureRegion(TextureHandle handle);
+
+		/**
+		 * @brief 把一组图片打包为纹理图集，替换上一次构建的图集。
+		 * @param file_paths 图片路径。
+		 * @return 打包进图集的图片数量。
+		 */
+		size_t buildTextureAtlas(const std::vector<std::string>& file_paths);
+
+		/**
+		 * @brief 设置是否启用纹理图集（关闭时 buildTextureAtlas 不做任何事）。
+		 */
+		void setTextureAtlasEnabled(bool enabled);
+
+		/**
+		 * @brief 预加载使用的图集页边长（在主线程查询后交给后台线程），未启用图集时返回 0。
+		 */
+		int getTextureAtlasPageSize() const;
+
+		/**
+		 * @brief 解码一组图片并排好图集页，不创建纹理（线程安全，供后台预加载调用）。
+		 * @param file_paths 图片路径。
+		 * @param page_size getTextureAtlasPageSize() 的结果。
+		 * @param cancelled 取消标志，可为空。
+		 */
+		static std::unique_ptr<PreparedTextures> prepareTextures(const std::vector<std::string>& file_paths, int page_size,
+			const std::atomic<bool>* cancelled = nullptr);
+
+		/**
+		 * @brief 暂存预加载的图片，之后由 uploadStagedTextures 逐帧上传，
+		 *        下一次 buildTextureAtlas 请求相同的图片时直接换上。
+		 */
+		void stageTextures(std::unique_ptr<PreparedTextures> prepared);
+
+		/**
+		 * @brief 在时间预算内上传暂存的图片。
+		 * @param budget_ms 本帧可用的时间（毫秒）。
+		 * @return 没有暂存或已全部上传时返回 true。
+		 */
+		bool uploadStagedTextures(float budget_ms);
+
+		/** @brief 丢弃暂存的图片。 */
+		void discardStagedTextures();
+
 		/**
 		 * @brief 清空所有已加载的纹理资源。
 		 */
@@ -0,0 +1,101 @@
+#include "texture_atlas.h"
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <algorithm>
+
+namespace engine::resource {
+
+PreparedTextures::~PreparedTextures()
+{
+	for (auto& image : standalone) {
+		SDL_DestroySurface(image.surface);
+	}
+	for (auto& page : pages) {
+		SDL_DestroySurface(page.surface);
+		if (page.texture) {
+			SDL_DestroyTexture(page.texture);
+		}
+	}
+}
+
+SkylinePacker::SkylinePacker(const glm::ivec2& size)
+	: size_(size)
+{
+	skyline_.push_back({ 0, 0, size_.x });
+}
+
+/**
+ * @brief 计算矩形从某一段开始放置时的 y
+ *
+ * @details 矩形横跨的所有段中最高的那段决定矩形的底边（y 向下增长，轮廓线记录的是已占用区域的下边界）。
+ */
+int SkylinePacker::fitAt(size_t index, const glm::ivec2& rect_size) const
+{
+	const int x = skyline_[index].x;
+	if (x + rect_size.x > size_.x) return -1;
+
+	int y = 0;
+	int remaining = rect_size.x;
+	for (size_t i = index; remaining > 0; ++i) {
+		if (i >= skyline_.size()) return -1;
+		y = std::max(y, skyline_[i].y);
+		if (y + rect_size.y > size_.y) return -1;
+		remaining -= skyline_[i].width;
+	}
+	return y;
+}
+
+/**
+ * @brief 放置一个矩形
+ *
+ * @param rect_size 矩形尺寸
+ * @return 左上角位置
+ */
+std::optional<glm::ivec2> SkylinePacker::insert(const glm::ivec2& rect_size)
+{
+	if (rect_size.x <= 0 || rect_size.y <= 0) return std::nullopt;
+
+	size_t best_index = skyline_.size();
+	int best_y = 0;
+	for (size_t i = 0; i < skyline_.size(); ++i) {
+		const int y = fitAt(i, rect_size);
+		if (y >= 0 && (best_index == skyline_.size() || y < best_y)) {
+			best_index = i;
+			best_y = y;
+		}
+	}
+	if (best_index == skyline_.size()) return std::nullopt;
+
+	const glm::ivec2 position{ skyline_[best_index].x, best_y };
+
+	// 插入新段，并裁掉被新段覆盖的部分
+	skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(best_index), { position.x, best_y + rect_size.y, rect_size.x });
+	const int new_right = position.x + rect_size.x;
+	size_t i = best_index + 1;
+	while (i < skyline_.size() && skyline_[i].x < new_right) {
+		const int shrink = new_right - skyline_[i].x;
+		if (skyline_[i].width <= shrink) {
+			skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+			continue;
+		}
+		skyline_[i].x += shrink;
+		skyline_[i].width -= shrink;
+		break;
+	}
+
+	// 合并相同高度的相邻段
+	for (size_t j = 0; j + 1 < skyline_.size();) {
+		if (skyline_[j].y == skyline_[j + 1].y) {
+			skyline_[j].width += skyline_[j + 1].width;
+			skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(j + 1));
+		}
+		else {
+			++j;
+		}
+	}
+
+	used_height_ = std::max(used_height_, best_y + rect_size.y);
+	return position;
+}
+
+} // namespace engine::resource
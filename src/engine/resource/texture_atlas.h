@@ -0,0 +1,125 @@
+#pragma once
+/**
+ * @file texture_atlas.h
+ * @brief 定义 TextureRegion（纹理在实际绑定纹理中的位置）、图集打包使用的 SkylinePacker，
+ *        以及可在后台线程准备、主线程分批上传的 PreparedTextures。
+ */
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/ext/vector_int2.hpp>
+#include "texture_handle.h"
+
+struct SDL_Texture;
+struct SDL_Surface;
+
+namespace engine::resource {
+
+	/**
+	 * @struct TextureRegion
+	 * @brief 一张逻辑纹理在实际绑定的 SDL 纹理中的位置。
+	 *
+	 * 独立加载的纹理 offset 为 0、texture_size 等于 size；打包进图集的纹理指向图集页，
+	 * 绘制时把精灵的源矩形加上 offset 即得到图集坐标，动画帧等运行时修改的源矩形无需重新映射。
+	 */
+	struct TextureRegion {
+		static constexpr std::uint32_t INVALID_BIND_ID = 0xFFFFFFFFu;
+
+		SDL_Texture* texture = nullptr;          ///< 绑定的纹理（独立纹理或图集页）
+		glm::vec2 size{ 0.0f, 0.0f };            ///< 原始图片尺寸
+		glm::vec2 offset{ 0.0f, 0.0f };          ///< 原始图片左上角在 texture 中的位置
+		glm::vec2 texture_size{ 0.0f, 0.0f };    ///< texture 的实际尺寸（计算 UV）
+		std::uint32_t bind_id = INVALID_BIND_ID; ///< texture 的稠密绑定编号（同一张 SDL 纹理相同），渲染队列按它分组
+	};
+
+	/**
+	 * @struct PreparedTextures
+	 * @brief 已解码并排好版、尚未（或尚未全部）上传的一组图片。
+	 *
+	 * 解码与排版只使用 SDL_Surface，可以在任意线程完成；创建纹理必须在渲染线程，
+	 * 由 TextureManager 按时间预算逐个上传（先独立图片，后图集页），全部上传后再把句柄映射到图集页。
+	 * 析构时释放尚未上传的表面和尚未被接管的图集页纹理。
+	 */
+	struct PreparedTextures {
+		/// 一张图集页
+		struct Page {
+			SDL_Surface* surface = nullptr;      ///< 排好版的页面（上传后释放）
+			SDL_Texture* texture = nullptr;      ///< 上传得到的纹理（应用图集时由 TextureManager 接管）
+			glm::ivec2 size{ 0, 0 };
+		};
+		/// 打包进图集的一张图片
+		struct Item {
+			TextureHandle handle;
+			glm::ivec2 size{ 0, 0 };             ///< 原始图片尺寸
+			glm::ivec2 position{ 0, 0 };         ///< 图片左上角在页中的位置（已去掉留边）
+			size_t page = 0;
+		};
+		/// 不打包、单独上传的图片（过大或未启用图集）
+		struct Standalone {
+			std::string path;
+			SDL_Surface* surface = nullptr;
+		};
+
+		std::vector<TextureHandle> handles;      ///< 请求的全部图片（排序去重），用于判断是否与之后的图集请求一致
+		std::vector<Page> pages;
+		std::vector<Item> items;
+		std::vector<Standalone> standalone;
+		size_t next_upload = 0;                  ///< 下一个待上传的对象下标（standalone 在前，pages 在后）
+
+		PreparedTextures() = default;
+		~PreparedTextures();
+
+		PreparedTextures(const PreparedTextures&) = delete;
+		PreparedTextures& operator=(const PreparedTextures&) = delete;
+		PreparedTextures(PreparedTextures&&) = delete;
+		PreparedTextures& operator=(PreparedTextures&&) = delete;
+
+		/// 是否已全部上传
+		bool isUploaded() const { return next_upload >= standalone.size() + pages.size(); }
+	};
+
+	/**
+	 * @class SkylinePacker
+	 * @brief 天际线（Skyline Bottom-Left）矩形打包器。
+	 *
+	 * 维护已占用区域的上轮廓线，每个矩形放在能让其顶边最低的位置（相同时取最左）。
+	 * 输入按高度降序排列时空间利用率较好，足以应对关卡中几十张精灵图。
+	 */
+	class SkylinePacker final {
+	private:
+		struct Node {
+			int x = 0;
+			int y = 0;
+			int width = 0;
+		};
+
+		glm::ivec2 size_{ 0, 0 };
+		std::vector<Node> skyline_;
+		int used_height_ = 0;
+
+	public:
+		/**
+		 * @brief 构造函数。
+		 * @param size 页面尺寸（像素）。
+		 */
+		explicit SkylinePacker(const glm::ivec2& size);
+
+		/**
+		 * @brief 放置一个矩形。
+		 * @param rect_size 矩形尺寸（已包含留边）。
+		 * @return 左上角位置，放不下时返回 std::nullopt。
+		 */
+		std::optional<glm::ivec2> insert(const glm::ivec2& rect_size);
+
+		/** @brief 已占用的高度（用于裁剪页面） */
+		int getUsedHeight() const { return used_height_; }
+		const glm::ivec2& getSize() const { return size_; }
+
+	private:
+		/// 以第 index 段为起点放置宽度为 width 的矩形时矩形的 y，放不下返回 -1
+		int fitAt(size_t index, const glm::ivec2& rect_size) const;
+	};
+
+} // namespace engine::resource
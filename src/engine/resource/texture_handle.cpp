@@ -0,0 +1,52 @@
+#include "texture_handle.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace engine::resource {
+
+namespace {
+	struct RegistryData {
+		std::mutex mutex;
+		std::unordered_map<std::string, std::uint32_t> ids;   ///< 路径 -> 句柄
+		std::deque<std::string> paths;                         ///< 句柄 -> 路径（deque 追加不移动已有元素）
+	};
+
+	RegistryData& registry()
+	{
+		static RegistryData data;
+		return data;
+	}
+}
+
+TextureHandle TextureRegistry::acquire(const std::string& file_path)
+{
+	if (file_path.empty()) return {};
+
+	auto& data = registry();
+	std::lock_guard<std::mutex> lock(data.mutex);
+	const auto [it, inserted] = data.ids.try_emplace(file_path, static_cast<std::uint32_t>(data.paths.size()));
+	if (inserted) {
+		data.paths.push_back(file_path);
+	}
+	return TextureHandle{ it->second };
+}
+
+const std::string& TextureRegistry::getPath(TextureHandle handle)
+{
+	static const std::string empty_path;
+	if (!handle.isValid()) return empty_path;
+
+	auto& data = registry();
+	std::lock_guard<std::mutex> lock(data.mutex);
+	return handle.id < data.paths.size() ? data.paths[handle.id] : empty_path;
+}
+
+std::uint32_t TextureRegistry::size()
+{
+	auto& data = registry();
+	std::lock_guard<std::mutex> lock(data.mutex);
+	return static_cast<std::uint32_t>(data.paths.size());
+}
+
+} // namespace engine::resource
@@ -0,0 +1,61 @@
+#pragma once
+/**
+ * @file texture_handle.h
+ * @brief 定义 TextureHandle（纹理的紧凑整数句柄）以及把纹理路径映射为句柄的 TextureRegistry。
+ */
+
+#include <cstdint>
+#include <compare>
+#include <string>
+
+namespace engine::resource {
+
+	/**
+	 * @struct TextureHandle
+	 * @brief 纹理的紧凑整数句柄。
+	 *
+	 * 同一路径在进程内总是得到同一个句柄，句柄从 0 开始连续分配，
+	 * 可直接作为 TextureManager 中纹理数组的下标，绘制时无需再对路径字符串做哈希。
+	 */
+	struct TextureHandle {
+		static constexpr std::uint32_t INVALID_ID = 0xFFFFFFFFu;
+
+		std::uint32_t id = INVALID_ID;
+
+		/** @brief 句柄是否指向某个纹理路径（不代表纹理已加载成功） */
+		constexpr bool isValid() const { return id != INVALID_ID; }
+
+		auto operator<=>(const TextureHandle&) const = default;
+	};
+
+	/**
+	 * @class TextureRegistry
+	 * @brief 进程内的纹理路径登记表，负责把路径字符串解析为 TextureHandle。
+	 *
+	 * 句柄只与路径绑定，与纹理是否加载、是否被卸载无关，因此 Sprite 和瓦片可以在
+	 * 创建时（尚未拿到 ResourceManager）解析一次句柄，之后一直使用。登记表只增不减，
+	 * 所有接口都是线程安全的，可以在后台线程加载关卡时调用。
+	 */
+	class TextureRegistry final {
+	public:
+		TextureRegistry() = delete;
+
+		/**
+		 * @brief 获取路径对应的句柄，首次出现的路径分配新的句柄。
+		 * @param file_path 纹理文件路径。
+		 * @return 空路径返回无效句柄。
+		 */
+		static TextureHandle acquire(const std::string& file_path);
+
+		/**
+		 * @brief 获取句柄对应的路径。
+		 * @param handle 纹理句柄。
+		 * @return 路径的常量引用（在进程生命周期内有效），无效句柄返回空字符串。
+		 */
+		static const std::string& getPath(TextureHandle handle);
+
+		/** @brief 已登记的路径数量（即句柄上限） */
+		static std::uint32_t size();
+	};
+
+} // namespace engine::resource
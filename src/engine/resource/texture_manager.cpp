@@ -2,6 +2,8 @@
 #include <SDL3_image/SDL_image.h>
 #include <SDL3/SDL_render.h>
 #include <spdlog/spdlog.h>  
+#include <algorithm>
+#include <SDL3/SDL_timer.h>
 
 /**
  * @brief 构造函数，初始化纹理管理器。
@@ -23,6 +25,7 @@ SDL_Texture* engine::resource::TextureManager::loadTexture(const std::string& fi
     // 检查是否已加载
     auto it = textures_.find(file_path);
     if (it != textures_.end()) {
+        bindStandaloneRegion(file_path, it->second.get());
         return it->second.get();
     }
 
@@ -34,19 +37,83 @@ SDL_Texture* engine::resource::TextureManager::loadTexture(const std::string& fi
         spdlog::error("加载纹理失败: '{}': {}", file_path, SDL_GetError());
         return nullptr;
     }
-    if (raw_texture) {
-        if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
-            spdlog::warn("无法设置纹理缩放模式为最邻近插值");
-        }
+    return cacheTexture(file_path, raw_texture);
+}
+
+/**
+ * @brief 把已创建的纹理存入缓存并绑定句柄。
+ * @param file_path 纹理文件的路径。
+ * @param raw_texture 新创建的纹理，所有权转移给缓存。
+ * @return SDL_Texture* 即 raw_texture。
+ */
+SDL_Texture* engine::resource::TextureManager::cacheTexture(const std::string& file_path, SDL_Texture* raw_texture) {
+    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+        spdlog::warn("无法设置纹理缩放模式为最邻近插值");
     }
 
     // 使用带有自定义删除器的 unique_ptr 存储加载的纹理
     textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+
+    bindStandaloneRegion(file_path, raw_texture);
     spdlog::debug("成功加载并缓存纹理: {}", file_path);
 
     return raw_texture;
 }
 
+/**
+ * @brief 让句柄指向独立纹理。
+ * @param file_path 纹理文件的路径。
+ * @param texture 已加载的独立纹理。
+ * @details 同步句柄下标的缓存，尺寸只在此时查询一次；已映射到图集的句柄保持指向图集。
+ */
+void engine::resource::TextureManager::bindStandaloneRegion(const std::string& file_path, SDL_Texture* texture) {
+    const auto handle = TextureRegistry::acquire(file_path);
+    if (handle.id >= regions_.size()) {
+        regions_.resize(static_cast<size_t>(handle.id) + 1);
+    }
+    auto& region = regions_[handle.id];
+    if (region.texture) {
+        return;
+    }
+    region.texture = texture;
+    region.bind_id = acquireBindId(texture);
+    region.offset = glm::vec2(0);
+    if (!SDL_GetTextureSize(texture, &region.size.x, &region.size.y)) {
+        spdlog::error("无法查询纹理尺寸: {}", file_path);
+        region.size = glm::vec2(0);
+    }
+    region.texture_size = region.size;
+}
+
+/**
+ * @brief 获取纹理的绑定编号。
+ * @param texture 独立纹理或图集页。
+ * @return 稠密编号，同一张纹理总是相同；用作渲染排序键的纹理字段，使共用图集页的句柄排在一起。
+ */
+std::uint32_t engine::resource::TextureManager::acquireBindId(SDL_Texture* texture) {
+    if (const auto it = bind_ids_.find(texture); it != bind_ids_.end()) {
+        return it->second;
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(bind_ids_.size());
+    if (!free_bind_ids_.empty()) {
+        id = free_bind_ids_.back();
+        free_bind_ids_.pop_back();
+    }
+    bind_ids_.emplace(texture, id);
+    return id;
+}
+
+/**
+ * @brief 归还纹理的绑定编号，供之后创建的纹理复用。
+ * @param texture 即将销毁的纹理。
+ */
+void engine::resource::TextureManager::releaseBindId(SDL_Texture* texture) {
+    if (const auto it = bind_ids_.find(texture); it != bind_ids_.end()) {
+        free_bind_ids_.push_back(it->second);
+        bind_ids_.erase(it);
+    }
+}
+
 /**
  * @brief 尝试获取已加载纹理的指针。
  * @param file_path 纹理文件的路径。
@@ -61,6 +128,31 @@ SDL_Texture* engine::resource::TextureManager::getTexture(const std::string& fil
     return loadTexture(file_path);
 }
 
+/**
+ * @brief 通过句柄获取纹理。
+ * @param handle 纹理句柄。
+ * @return SDL_Texture* 命中句柄缓存时直接返回，否则按句柄对应的路径加载。
+ */
+SDL_Texture* engine::resource::TextureManager::getTexture(TextureHandle handle) {
+    const TextureRegion* region = getTextureRegion(handle);
+    return region ? region->texture : nullptr;
+}
+
+/**
+ * @brief 通过句柄获取纹理区域。
+ * @param handle 纹理句柄。
+ * @return 命中句柄缓存时直接返回，否则按句柄对应的路径加载后返回。
+ */
+const engine::resource::TextureRegion* engine::resource::TextureManager::getTextureRegion(TextureHandle handle) {
+    if (handle.id < regions_.size() && regions_[handle.id].texture) {
+        return &regions_[handle.id];
+    }
+    if (!handle.isValid() || !loadTexture(TextureRegistry::getPath(handle))) {
+        return nullptr;
+    }
+    return &regions_[handle.id];
+}
+
 /**
  * @brief 从缓存中卸载指定的纹理资源并释放内存。
  * @param file_path 要卸载的纹理文件的路径。
@@ -68,6 +160,11 @@ SDL_Texture* engine::resource::TextureManager::getTexture(const std::string& fil
 void engine::resource::TextureManager::unloadTexture(const std::string& file_path) {
     auto it = textures_.find(file_path);
     if (it != textures_.end()) {
+        if (const auto handle = TextureRegistry::acquire(file_path);
+            handle.id < regions_.size() && regions_[handle.id].texture == it->second.get()) {
+            regions_[handle.id] = TextureRegion{};
+        }
+        releaseBindId(it->second.get());
         textures_.erase(it);
         spdlog::debug("已卸载纹理: {}", file_path);
     } else {
@@ -81,19 +178,20 @@ void engine::resource::TextureManager::unloadTexture(const std::string& file_pat
  * @return glm::vec2 包含该纹理宽度 (x) 和高度 (y) 的向量。若纹理无效则返回 {0, 0}。
  */
 glm::vec2 engine::resource::TextureManager::getTextureSize(const std::string& file_path) {
-    SDL_Texture* texture = getTexture(file_path);
-    if (!texture) {
-        spdlog::error("无法获取纹理: {}", file_path);
-        return glm::vec2(0);
-    }
+    return getTextureSize(TextureRegistry::acquire(file_path));
+}
 
-    // 获取纹理尺寸
-    glm::vec2 size;
-    if (!SDL_GetTextureSize(texture, &size.x, &size.y)) {
-        spdlog::error("无法查询纹理尺寸: {}", file_path);
+/**
+ * @brief 通过句柄获取纹理尺寸。
+ * @param handle 纹理句柄。
+ * @return glm::vec2 加载时缓存的纹理尺寸。若纹理无效则返回 {0, 0}。
+ */
+glm::vec2 engine::resource::TextureManager::getTextureSize(TextureHandle handle) {
+    if (!getTexture(handle)) {
+        spdlog::error("无法获取纹理: {}", TextureRegistry::getPath(handle));
         return glm::vec2(0);
     }
-    return size;
+    return regions_[handle.id].size;
 }
 
 /**
@@ -104,6 +202,289 @@ void engine::resource::TextureManager::clearTextures() {
         spdlog::debug("纹理资源已为空，无需清空");
         return;
     }
+    staged_.reset();
     textures_.clear();
+    regions_.clear();
+    atlas_pages_.clear();
+    atlas_handles_.clear();
+    bind_ids_.clear();
+    free_bind_ids_.clear();
     spdlog::debug("已清空所有纹理资源");
-}
\ No newline at end of file
+}
+/**
+ * @brief 把一组图片打包为图集页，并把它们的句柄映射到图集。
+ * @param file_paths 图片路径（可重复，内部去重）。
+ * @return 打包进图集的图片数量。
+ * @details 暂存的预加载图片与本次请求的图片集合相同时直接使用，否则当场解码排版。
+ *          已加载的独立纹理保留在 textures_ 中，只有句柄改为指向图集。
+ */
+size_t engine::resource::TextureManager::buildAtlas(const std::vector<std::string>& file_paths) {
+    auto prepared = std::move(staged_);
+    if (prepared) {
+        std::vector<TextureHandle> handles;
+        for (const auto& path : file_paths) {
+            handles.push_back(TextureRegistry::acquire(path));
+        }
+        std::sort(handles.begin(), handles.end(), [](TextureHandle a, TextureHandle b) { return a.id < b.id; });
+        handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+        if (handles != prepared->handles) {
+            spdlog::debug("图集: 预加载的图片与请求不一致，已丢弃");
+            prepared.reset();
+        }
+    }
+    if (!prepared) {
+        if (!atlas_enabled_ || file_paths.empty()) {
+            clearAtlas();
+            return 0;
+        }
+        prepared = prepareTextures(file_paths, getAtlasPageSize());
+    }
+
+    uploadPreparedTextures(*prepared, 0);
+    applyAtlas(*prepared);
+    spdlog::info("图集: {} 张图片打包为 {} 页", atlas_handles_.size(), atlas_pages_.size());
+    return atlas_handles_.size();
+}
+
+/**
+ * @brief 图集页边长。
+ * @return 未启用图集时返回 0，否则为 ATLAS_PAGE_SIZE 与渲染器最大纹理尺寸中的较小者。
+ */
+int engine::resource::TextureManager::getAtlasPageSize() const {
+    if (!atlas_enabled_) {
+        return 0;
+    }
+    int page_size = ATLAS_PAGE_SIZE;
+    const auto max_texture_size = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer_),
+                                                        SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (max_texture_size > 0) {
+        page_size = std::min(page_size, static_cast<int>(max_texture_size));
+    }
+    return page_size;
+}
+
+/**
+ * @brief 解码一组图片并排好图集页。
+ * @param file_paths 图片路径（可重复，内部去重）。
+ * @param page_size 图集页边长，为 0 时所有图片都作为独立图片。
+ * @param cancelled 不为空且被置位时尽快返回。
+ * @return 准备好的图片。
+ * @details 只操作 SDL_Surface，不访问渲染器和成员，可以在后台线程调用。
+ *          图片按高度降序用 SkylinePacker 放入页面，每张图片四周复制 ATLAS_PADDING 像素的边缘，
+ *          线性过滤或子像素坐标下也不会采样到相邻图片。
+ */
+std::unique_ptr<engine::resource::PreparedTextures> engine::resource::TextureManager::prepareTextures(
+    const std::vector<std::string>& file_paths, int page_size, const std::atomic<bool>* cancelled) {
+    auto prepared = std::make_unique<PreparedTextures>();
+    auto is_cancelled = [cancelled]() { return cancelled && cancelled->load(std::memory_order_relaxed); };
+
+    struct Item {
+        TextureHandle handle;
+        SDL_Surface* surface = nullptr;
+        glm::ivec2 position{ 0, 0 };
+        size_t page = 0;
+    };
+    std::vector<Item> items;
+    items.reserve(file_paths.size());
+
+    for (const auto& path : file_paths) {
+        if (is_cancelled()) break;
+        const auto handle = TextureRegistry::acquire(path);
+        if (std::find(prepared->handles.begin(), prepared->handles.end(), handle) != prepared->handles.end()) {
+            continue;
+        }
+        prepared->handles.push_back(handle);
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        if (!loaded) {
+            spdlog::warn("图集: 无法读取图片 '{}': {}", path, SDL_GetError());
+            continue;
+        }
+        const int max_side = std::min(ATLAS_MAX_ITEM_SIZE, page_size - 2 * ATLAS_PADDING);
+        if (loaded->w > max_side || loaded->h > max_side) {
+            if (page_size > 0) {
+                spdlog::debug("图集: 图片 '{}' ({}x{}) 过大，保持独立纹理", path, loaded->w, loaded->h);
+            }
+            prepared->standalone.push_back({ path, loaded });
+            continue;
+        }
+        SDL_Surface* surface = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!surface) {
+            spdlog::warn("图集: 无法转换图片格式 '{}': {}", path, SDL_GetError());
+            continue;
+        }
+        items.push_back({ handle, surface });
+    }
+    std::sort(prepared->handles.begin(), prepared->handles.end(), [](TextureHandle a, TextureHandle b) { return a.id < b.id; });
+
+    // 按高度降序放置，高度相同时按宽度降序
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w;
+    });
+
+    std::vector<SkylinePacker> packers;
+    for (auto& item : items) {
+        const glm::ivec2 padded{ item.surface->w + 2 * ATLAS_PADDING, item.surface->h + 2 * ATLAS_PADDING };
+        std::optional<glm::ivec2> position;
+        for (size_t i = 0; i < packers.size() && !position; ++i) {
+            if ((position = packers[i].insert(padded))) {
+                item.page = i;
+            }
+        }
+        if (!position) {
+            packers.emplace_back(glm::ivec2(page_size));
+            position = packers.back().insert(padded);
+            item.page = packers.size() - 1;
+        }
+        item.position = *position;
+    }
+
+    // 每页生成一张表面，复制图片和边缘
+    for (const auto& packer : packers) {
+        const glm::ivec2 size{ packer.getSize().x, packer.getUsedHeight() };
+        SDL_Surface* page = SDL_CreateSurface(size.x, size.y, SDL_PIXELFORMAT_RGBA32);
+        if (page) {
+            SDL_FillSurfaceRect(page, nullptr, 0);
+        }
+        else {
+            spdlog::error("图集: 无法创建页面表面: {}", SDL_GetError());
+        }
+        prepared->pages.push_back({ page, nullptr, size });
+    }
+
+    for (const auto& item : items) {
+        SDL_Surface* page = prepared->pages[item.page].surface;
+        SDL_Surface* src = item.surface;
+        if (page && !is_cancelled()) {
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+            const int pad = ATLAS_PADDING;
+            const int x = item.position.x + pad;
+            const int y = item.position.y + pad;
+            const int w = src->w;
+            const int h = src->h;
+
+            // 图片本体与四条边（SDL_BlitSurfaceScaled 用最近邻把 1 像素宽的边拉伸为 pad 宽）
+            SDL_Rect dst{ x, y, w, h };
+            SDL_BlitSurface(src, nullptr, page, &dst);
+            const SDL_Rect edges_src[4] = { { 0, 0, w, 1 }, { 0, h - 1, w, 1 }, { 0, 0, 1, h }, { w - 1, 0, 1, h } };
+            const SDL_Rect edges_dst[4] = { { x, y - pad, w, pad }, { x, y + h, w, pad }, { x - pad, y, pad, h }, { x + w, y, pad, h } };
+            for (int i = 0; i < 4; ++i) {
+                SDL_BlitSurfaceScaled(src, &edges_src[i], page, &edges_dst[i], SDL_SCALEMODE_NEAREST);
+            }
+
+            // 四个角用角上的像素填充
+            const glm::ivec2 corners[4] = { { 0, 0 }, { w - 1, 0 }, { 0, h - 1 }, { w - 1, h - 1 } };
+            const SDL_Rect corners_dst[4] = { { x - pad, y - pad, pad, pad }, { x + w, y - pad, pad, pad },
+                                              { x - pad, y + h, pad, pad }, { x + w, y + h, pad, pad } };
+            for (int i = 0; i < 4; ++i) {
+                Uint8 r = 0, g = 0, b = 0, a = 0;
+                SDL_ReadSurfacePixel(src, corners[i].x, corners[i].y, &r, &g, &b, &a);
+                SDL_FillSurfaceRect(page, &corners_dst[i], SDL_MapSurfaceRGBA(page, r, g, b, a));
+            }
+            prepared->items.push_back({ item.handle, glm::ivec2(src->w, src->h), item.position + ATLAS_PADDING, item.page });
+        }
+        SDL_DestroySurface(src);
+    }
+    return prepared;
+}
+
+/**
+ * @brief 在时间预算内逐个上传准备好的图片。
+ * @param prepared 准备好的图片。
+ * @param budget_ns 时间预算（纳秒），0 表示全部上传。
+ * @return 是否已全部上传。
+ * @details 每次至少上传一个对象，预算再小也能推进；独立图片直接进入纹理缓存，图集页等到 applyAtlas 时才生效。
+ */
+bool engine::resource::TextureManager::uploadPreparedTextures(PreparedTextures& prepared, std::uint64_t budget_ns) {
+    const std::uint64_t start = SDL_GetTicksNS();
+    while (!prepared.isUploaded()) {
+        if (prepared.next_upload < prepared.standalone.size()) {
+            auto& image = prepared.standalone[prepared.next_upload];
+            if (!textures_.contains(image.path)) {
+                if (SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, image.surface)) {
+                    cacheTexture(image.path, texture);
+                }
+                else {
+                    spdlog::error("加载纹理失败: '{}': {}", image.path, SDL_GetError());
+                }
+            }
+            SDL_DestroySurface(image.surface);
+            image.surface = nullptr;
+        }
+        else {
+            auto& page = prepared.pages[prepared.next_upload - prepared.standalone.size()];
+            if (page.surface) {
+                page.texture = SDL_CreateTextureFromSurface(renderer_, page.surface);
+                if (page.texture) {
+                    SDL_SetTextureScaleMode(page.texture, SDL_SCALEMODE_NEAREST);
+                    SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_BLEND);
+                }
+                else {
+                    spdlog::error("图集: 无法创建页面纹理: {}", SDL_GetError());
+                }
+                SDL_DestroySurface(page.surface);
+                page.surface = nullptr;
+            }
+        }
+        ++prepared.next_upload;
+        if (budget_ns > 0 && SDL_GetTicksNS() - start >= budget_ns) {
+            break;
+        }
+    }
+    return prepared.isUploaded();
+}
+
+/**
+ * @brief 接管已上传的图集页，把图片句柄映射到图集。
+ * @param prepared 已全部上传的图片。
+ */
+void engine::resource::TextureManager::applyAtlas(PreparedTextures& prepared) {
+    clearAtlas();
+    for (auto& page : prepared.pages) {
+        atlas_pages_.emplace_back(page.texture);
+        page.texture = nullptr;
+    }
+    for (const auto& item : prepared.items) {
+        SDL_Texture* page = atlas_pages_[item.page].get();
+        if (!page) continue;
+        if (item.handle.id >= regions_.size()) {
+            regions_.resize(static_cast<size_t>(item.handle.id) + 1);
+        }
+        auto& region = regions_[item.handle.id];
+        region.texture = page;
+        region.bind_id = acquireBindId(page);
+        region.size = glm::vec2(item.size);
+        region.offset = glm::vec2(item.position);
+        region.texture_size = glm::vec2(prepared.pages[item.page].size);
+        atlas_handles_.push_back(item.handle);
+    }
+}
+
+/**
+ * @brief 在时间预算内上传暂存的图片。
+ * @param budget_ms 时间预算（毫秒）。
+ * @return 没有暂存或已全部上传时返回 true。
+ */
+bool engine::resource::TextureManager::uploadStagedTextures(float budget_ms) {
+    if (!staged_) {
+        return true;
+    }
+    const auto budget_ns = static_cast<std::uint64_t>(std::max(budget_ms, 0.001f) * 1'000'000.0f);
+    return uploadPreparedTextures(*staged_, budget_ns);
+}
+
+/**
+ * @brief 释放图集页，映射到图集的句柄恢复为按需加载的独立纹理。
+ */
+void engine::resource::TextureManager::clearAtlas() {
+    for (const auto handle : atlas_handles_) {
+        if (handle.id < regions_.size()) {
+            regions_[handle.id] = TextureRegion{};
+        }
+    }
+    atlas_handles_.clear();
+    for (const auto& page : atlas_pages_) {
+        releaseBindId(page.get());
+    }
+    atlas_pages_.clear();
+}
@@ -1,10 +1,15 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>       // 用于 std::unique_ptr
 #include <stdexcept>    // 用于 std::runtime_error
 #include <string>       // 用于 std::string
 #include <unordered_map> // 用于 std::unordered_map
+#include <vector>
 #include <SDL3/SDL_render.h> // 用于 SDL_Texture 和 SDL_Renderer
 #include <glm/glm.hpp>
+#include "texture_handle.h"
+#include "texture_atlas.h"
 
 namespace engine::resource {
 
@@ -14,6 +19,8 @@ namespace engine::resource {
 	 * 
 	 * 该类通过 std::unordered_map 提供纹理缓存功能，避免同一资源的重复加载，
 	 * 并利用 std::unique_ptr 确保在对象销毁或资源卸载时自动调用 SDL_DestroyTexture。
+	 * 另外按 TextureHandle 下标保存纹理的 TextureRegion，绘制时通过句柄直接索引，不再查找路径。
+	 * 关卡加载时可把关卡用到的图片打包为少数几张图集页（buildAtlas），被打包的句柄改为指向图集页。
 	 */
 	class TextureManager final {
 	private:
@@ -36,6 +43,20 @@ namespace engine::resource {
 		SDL_Renderer* renderer_; ///< 指向 SDL 渲染上下文的指针，用于生成纹理。
 		std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_; ///< 存储已加载纹理的映射表，键为文件路径。
 
+		/// 按句柄下标缓存的纹理区域（不持有所有权，指向 textures_ 中的独立纹理或 atlas_pages_ 中的图集页）
+		std::vector<TextureRegion> regions_;
+
+		static constexpr int ATLAS_PAGE_SIZE = 2048;     ///< 图集页的最大边长（同时受渲染器最大纹理尺寸限制）
+		static constexpr int ATLAS_PADDING = 2;          ///< 每张图片四周复制边缘像素的宽度，防止采样到相邻图片
+		static constexpr int ATLAS_MAX_ITEM_SIZE = 1024; ///< 超过该边长的图片（如大背景）不打包
+
+		bool atlas_enabled_ = true;                      ///< 关闭时 buildAtlas() 不做任何事（用于对比）
+		std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>> atlas_pages_; ///< 当前关卡的图集页
+		std::vector<TextureHandle> atlas_handles_;       ///< 已映射到图集页的句柄
+		std::unique_ptr<PreparedTextures> staged_;       ///< 预加载的下一关图片（逐帧上传，下次 buildAtlas 请求相同图片时直接换上）
+		std::unordered_map<SDL_Texture*, std::uint32_t> bind_ids_; ///< 每张独立纹理或图集页的绑定编号
+		std::vector<std::uint32_t> free_bind_ids_;       ///< 已释放、可复用的绑定编号（保持编号稠密）
+
 	public:
 		/**
 		 * @brief 构造函数，初始化纹理管理器。
@@ -61,6 +82,18 @@ private:
 		 */
 		SDL_Texture* loadTexture(const std::string& file_path);
 
+		/// 把已创建的纹理存入缓存并绑定句柄（设置最邻近缩放）
+		SDL_Texture* cacheTexture(const std::string& file_path, SDL_Texture* raw_texture);
+
+		/// 让路径对应的句柄指向独立纹理（句柄已指向图集或其它纹理时不变）
+		void bindStandaloneRegion(const std::string& file_path, SDL_Texture* texture);
+
+		/// 获取纹理的绑定编号，首次绑定时分配（优先复用已释放的编号）
+		std::uint32_t acquireBindId(SDL_Texture* texture);
+
+		/// 纹理销毁前归还其绑定编号
+		void releaseBindId(SDL_Texture* texture);
+
 		/**
 		 * @brief 尝试获取已加载纹理的指针。
 		 * @param file_path 纹理文件的路径。
@@ -68,6 +101,67 @@ private:
 		 */
 		SDL_Texture* getTexture(const std::string& file_path);
 
+		/**
+		 * @brief 通过句柄获取纹理，未加载时按句柄对应的路径加载。
+		 * @param handle 纹理句柄。
+		 * @return SDL_Texture* 纹理指针，句柄无效或加载失败返回 nullptr。
+		 */
+		SDL_Texture* getTexture(engine::resource::TextureHandle handle);
+
+		/**
+		 * @brief 通过句柄获取纹理区域，未加载时按句柄对应的路径加载。
+		 * @param handle 纹理句柄。
+		 * @return 纹理区域，句柄无效或加载失败返回 nullptr。
+		 */
+		const TextureRegion* getTextureRegion(engine::resource::TextureHandle handle);
+
+		/**
+		 * @brief 把一组图片打包为图集页，并把它们的句柄映射到图集。
+		 * @param file_paths 图片路径（可重复，内部去重）。
+		 * @return 打包进图集的图片数量。
+		 * @details 先释放上一次构建的图集。无法读取或尺寸过大的图片保持独立纹理。
+		 *          暂存的预加载图片与请求的图片一致时直接使用（只补传剩余部分），不再解码。
+		 */
+		size_t buildAtlas(const std::vector<std::string>& file_paths);
+
+		/// 释放图集页，映射到图集的句柄恢复为按需加载的独立纹理
+		void clearAtlas();
+
+		/// 图集页边长（受渲染器最大纹理尺寸限制），未启用图集时返回 0
+		int getAtlasPageSize() const;
+
+		/**
+		 * @brief 解码一组图片并排好图集页（只操作 SDL_Surface，可在后台线程调用）。
+		 * @param file_paths 图片路径（可重复，内部去重）。
+		 * @param page_size 图集页边长，为 0 时所有图片都作为独立图片。
+		 * @param cancelled 不为空且被置位时尽快返回（结果不完整）。
+		 * @return 准备好的图片。
+		 */
+		static std::unique_ptr<PreparedTextures> prepareTextures(const std::vector<std::string>& file_paths, int page_size,
+			const std::atomic<bool>* cancelled = nullptr);
+
+		/**
+		 * @brief 在时间预算内逐个上传准备好的图片（至少上传一个）。
+		 * @param prepared 准备好的图片。
+		 * @param budget_ns 时间预算（纳秒），0 表示全部上传。
+		 * @return 是否已全部上传。
+		 */
+		bool uploadPreparedTextures(PreparedTextures& prepared, std::uint64_t budget_ns);
+
+		/// 释放当前图集，把已上传的图集页接管为当前图集并映射句柄
+		void applyAtlas(PreparedTextures& prepared);
+
+		/// 暂存预加载的图片，替换之前暂存的
+		void stageTextures(std::unique_ptr<PreparedTextures> prepared) { staged_ = std::move(prepared); }
+
+		/// 在时间预算（毫秒）内上传暂存的图片，没有暂存或已全部上传时返回 true
+		bool uploadStagedTextures(float budget_ms);
+
+		/// 丢弃暂存的图片（已上传的独立图片保留在缓存中）
+		void discardStagedTextures() { staged_.reset(); }
+
+		void setAtlasEnabled(bool enabled) { atlas_enabled_ = enabled; }
+
 		/**
 		 * @brief 从缓存中卸载指定的纹理资源并释放内存。
 		 * @param file_path 要卸载的纹理文件的路径。
@@ -81,6 +175,13 @@ private:
 		 */
 		glm::vec2 getTextureSize(const std::string& file_path);
 
+		/**
+		 * @brief 通过句柄获取纹理尺寸（加载时缓存，不再查询 SDL）。
+		 * @param handle 纹理句柄。
+		 * @return glm::vec2 纹理尺寸，纹理无效时返回 {0, 0}。
+		 */
+		glm::vec2 getTextureSize(engine::resource::TextureHandle handle);
+
 		/**
 		 * @brief 清空当前所有的纹理缓存，释放所有占用的 SDL 纹理资源。
 		 */
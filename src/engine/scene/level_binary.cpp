@@ -0,0 +1,325 @@
+#include "level_binary.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::scene::level_binary {
+
+namespace {
+
+	/// 区间 [offset, offset + count * size) 是否位于 [0, limit) 内，且 offset 按 align 对齐
+	bool inRange(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t limit, std::uint64_t align)
+	{
+		return offset % align == 0 && offset <= limit && count * size <= limit - offset;
+	}
+
+	template<typename T>
+	bool sectionInRange(const Section& section, size_t file_size)
+	{
+		return inRange(section.offset, section.count, sizeof(T), file_size, alignof(T));
+	}
+
+	/// 数据区按 4 字节对齐，格子（u16）与 CBOR 数据都从对齐位置开始
+	size_t alignUp(size_t value, size_t align)
+	{
+		return (value + align - 1) / align * align;
+	}
+
+} // namespace
+
+std::string bakedPathFor(const std::string& map_path)
+{
+	return std::filesystem::path(map_path).replace_extension(EXTENSION).string();
+}
+
+// --- LevelFile ---
+
+std::unique_ptr<LevelFile> LevelFile::open(const std::string& path)
+{
+	if constexpr (std::endian::native != std::endian::little) {
+		spdlog::warn("预编译关卡只支持小端序平台: {}", path);
+		return nullptr;
+	}
+
+	std::unique_ptr<LevelFile> file(new LevelFile());
+#ifdef _WIN32
+	const std::wstring wide_path = std::filesystem::path(path).wstring();
+	HANDLE handle = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		spdlog::error("无法打开预编译关卡: {}", path);
+		return nullptr;
+	}
+	file->file_handle_ = handle;
+	LARGE_INTEGER file_size{};
+	if (!GetFileSizeEx(handle, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+		spdlog::error("预编译关卡文件过小: {}", path);
+		return nullptr;
+	}
+	file->size_ = static_cast<size_t>(file_size.QuadPart);
+	file->mapping_handle_ = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!file->mapping_handle_) {
+		spdlog::error("无法映射预编译关卡: {}", path);
+		return nullptr;
+	}
+	file->data_ = static_cast<const std::byte*>(MapViewOfFile(file->mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+	if (!file->data_) {
+		spdlog::error("无法映射预编译关卡: {}", path);
+		return nullptr;
+	}
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		spdlog::error("无法打开预编译关卡: {}", path);
+		return nullptr;
+	}
+	struct stat st {};
+	if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+		spdlog::error("预编译关卡文件过小: {}", path);
+		::close(fd);
+		return nullptr;
+	}
+	file->size_ = static_cast<size_t>(st.st_size);
+	void* mapped = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);    // 映射建立后即可关闭文件描述符
+	if (mapped == MAP_FAILED) {
+		spdlog::error("无法映射预编译关卡: {}", path);
+		file->size_ = 0;
+		return nullptr;
+	}
+	file->data_ = static_cast<const std::byte*>(mapped);
+#endif
+
+	if (!file->validate(path)) {
+		return nullptr;
+	}
+	return file;
+}
+
+LevelFile::~LevelFile()
+{
+#ifdef _WIN32
+	if (data_) UnmapViewOfFile(data_);
+	if (mapping_handle_) CloseHandle(mapping_handle_);
+	if (file_handle_) CloseHandle(file_handle_);
+#else
+	if (data_) munmap(const_cast<std::byte*>(data_), size_);
+#endif
+}
+
+/**
+ * @brief 校验文件
+ *
+ * @details 校验文件头、每张记录表的边界与对齐，以及记录中引用的字符串、瓦片、对象、动画、帧、音效和数据区范围。
+ *          通过后读取路径上不再做任何检查。
+ */
+bool LevelFile::validate(const std::string& path) const
+{
+	const Header& h = header();
+	if (h.magic != MAGIC) {
+		spdlog::error("预编译关卡 '{}' 的文件标识无效", path);
+		return false;
+	}
+	if (h.version != VERSION) {
+		spdlog::warn("预编译关卡 '{}' 的版本 ({}) 与当前版本 ({}) 不符", path, h.version, VERSION);
+		return false;
+	}
+
+	const bool sections_ok =
+		sectionInRange<StringRecord>(h.strings, size_) &&
+		sectionInRange<char>(h.string_data, size_) &&
+		sectionInRange<std::uint32_t>(h.dependencies, size_) &&
+		sectionInRange<TileRecord>(h.tiles, size_) &&
+		sectionInRange<LayerRecord>(h.layers, size_) &&
+		sectionInRange<ObjectRecord>(h.objects, size_) &&
+		sectionInRange<AnimationRecord>(h.animations, size_) &&
+		sectionInRange<FrameRecord>(h.frames, size_) &&
+		sectionInRange<SoundRecord>(h.sounds, size_) &&
+		inRange(h.payload.offset, h.payload.count, 1, size_, 4);
+	if (!sections_ok) {
+		spdlog::error("预编译关卡 '{}' 的记录表越界", path);
+		return false;
+	}
+
+	auto fail = [&path](const char* what) {
+		spdlog::error("预编译关卡 '{}' 的{}越界", path, what);
+		return false;
+	};
+	auto string_ok = [&h](std::uint32_t index) { return index == NO_INDEX || index < h.strings.count; };
+	auto blob_ok = [&h](const Blob& blob, std::uint64_t align) { return inRange(blob.offset, blob.size, 1, h.payload.count, align); };
+
+	for (const auto& record : section<StringRecord>(h.strings)) {
+		if (!inRange(record.offset, record.length, 1, h.string_data.count, 1)) return fail("字符串");
+	}
+	for (const auto index : dependencies()) {
+		if (index >= h.strings.count) return fail("依赖文件");
+	}
+	if (!string_ok(h.broadphase)) return fail("地图属性");
+	for (const auto& tile : tiles()) {
+		if (!string_ok(tile.texture) || !blob_ok(tile.json, 1) ||
+			!inRange(tile.first_animation, tile.animation_count, 1, h.animations.count, 1) ||
+			!inRange(tile.first_sound, tile.sound_count, 1, h.sounds.count, 1)) {
+			return fail("瓦片");
+		}
+	}
+	for (const auto& layer : layers()) {
+		if (!string_ok(layer.name) || !string_ok(layer.image) ||
+			!inRange(layer.first_object, layer.object_count, 1, h.objects.count, 1)) {
+			return fail("图层");
+		}
+		if (layer.type == LayerType::TILE) {
+			if (layer.width < 0 || layer.height < 0 ||
+				layer.cells.size != static_cast<std::uint64_t>(layer.width) * static_cast<std::uint64_t>(layer.height) * sizeof(std::uint16_t) ||
+				!blob_ok(layer.cells, alignof(std::uint16_t))) {
+				return fail("瓦片图层");
+			}
+			for (const auto cell : cells(layer)) {
+				if (cell >= h.tiles.count) return fail("瓦片图层");
+			}
+		}
+	}
+	for (const auto& object : objects()) {
+		if ((object.tile != NO_INDEX && object.tile >= h.tiles.count) || !blob_ok(object.json, 1)) return fail("对象");
+	}
+	for (const auto& animation : animations()) {
+		if (!string_ok(animation.name) || !inRange(animation.first_frame, animation.frame_count, 1, h.frames.count, 1)) return fail("动画");
+	}
+	for (const auto& sound : sounds()) {
+		if (!string_ok(sound.name) || !string_ok(sound.path)) return fail("音效");
+	}
+	return true;
+}
+
+std::string_view LevelFile::string(std::uint32_t index) const
+{
+	if (index == NO_INDEX) return {};
+	const auto& record = section<StringRecord>(header().strings)[index];
+	return { reinterpret_cast<const char*>(data_ + header().string_data.offset + record.offset), record.length };
+}
+
+std::span<const std::uint16_t> LevelFile::cells(const LayerRecord& layer) const
+{
+	return { reinterpret_cast<const std::uint16_t*>(data_ + header().payload.offset + layer.cells.offset),
+		layer.cells.size / sizeof(std::uint16_t) };
+}
+
+std::span<const std::uint8_t> LevelFile::bytes(const Blob& blob) const
+{
+	return { reinterpret_cast<const std::uint8_t*>(data_ + header().payload.offset + blob.offset), blob.size };
+}
+
+// --- LevelWriter ---
+
+std::uint32_t LevelWriter::addString(const std::string& value)
+{
+	auto [it, inserted] = string_indices_.try_emplace(value, static_cast<std::uint32_t>(strings_.size()));
+	if (inserted) {
+		strings_.push_back(value);
+	}
+	return it->second;
+}
+
+Blob LevelWriter::addCells(const std::vector<std::uint16_t>& cells)
+{
+	payload_.resize(alignUp(payload_.size(), 4));
+	const Blob blob{ static_cast<std::uint32_t>(payload_.size()), static_cast<std::uint32_t>(cells.size() * sizeof(std::uint16_t)) };
+	payload_.resize(payload_.size() + blob.size);
+	if (blob.size > 0) {
+		std::memcpy(payload_.data() + blob.offset, cells.data(), blob.size);
+	}
+	return blob;
+}
+
+Blob LevelWriter::addBytes(const std::vector<std::uint8_t>& bytes)
+{
+	payload_.resize(alignUp(payload_.size(), 4));
+	const Blob blob{ static_cast<std::uint32_t>(payload_.size()), static_cast<std::uint32_t>(bytes.size()) };
+	payload_.insert(payload_.end(), bytes.begin(), bytes.end());
+	return blob;
+}
+
+/**
+ * @brief 写出文件
+ *
+ * @details 各表依次排在文件头之后，每张表起点按 8 字节对齐。
+ */
+bool LevelWriter::write(const std::string& path)
+{
+	std::vector<std::byte> buffer(sizeof(Header));
+	auto append = [&buffer](const void* data, size_t size) {
+		buffer.resize(alignUp(buffer.size(), 8));
+		const Section section{ static_cast<std::uint32_t>(buffer.size()), 0 };
+		buffer.resize(buffer.size() + size);
+		if (size > 0) {
+			std::memcpy(buffer.data() + section.offset, data, size);
+		}
+		return section;
+	};
+	auto appendRecords = [&append](const auto& records) {
+		Section section = append(records.data(), records.size() * sizeof(records[0]));
+		section.count = static_cast<std::uint32_t>(records.size());
+		return section;
+	};
+
+	std::vector<StringRecord> string_records;
+	std::string string_data;
+	for (const auto& value : strings_) {
+		string_records.push_back({ static_cast<std::uint32_t>(string_data.size()), static_cast<std::uint32_t>(value.size()) });
+		string_data += value;
+	}
+
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.strings = appendRecords(string_records);
+	header.string_data = append(string_data.data(), string_data.size());
+	header.string_data.count = static_cast<std::uint32_t>(string_data.size());
+	header.dependencies = appendRecords(dependencies);
+	header.tiles = appendRecords(tiles);
+	header.layers = appendRecords(layers);
+	header.objects = appendRecords(objects);
+	header.animations = appendRecords(animations);
+	header.frames = appendRecords(frames);
+	header.sounds = appendRecords(sounds);
+	header.payload = append(payload_.data(), payload_.size());
+	header.payload.count = static_cast<std::uint32_t>(payload_.size());
+	std::memcpy(buffer.data(), &header, sizeof(Header));
+
+	const std::string temp_path = path + ".tmp";
+	{
+		std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+		if (!out.is_open()) {
+			spdlog::error("无法写入预编译关卡: {}", temp_path);
+			return false;
+		}
+		out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		if (!out.good()) {
+			spdlog::error("写入预编译关卡失败: {}", temp_path);
+			return false;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp_path, path, ec);
+	if (ec) {
+		spdlog::error("无法重命名预编译关卡 '{}': {}", temp_path, ec.message());
+		std::filesystem::remove(temp_path, ec);
+		return false;
+	}
+	return true;
+}
+
+} // namespace engine::scene::level_binary
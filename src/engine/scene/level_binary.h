@@ -0,0 +1,253 @@
+#pragma once
+/**
+ * @file level_binary.h
+ * @brief 定义预编译关卡文件（.lvb）的二进制布局，以及通过内存映射读取它的 LevelFile 与离线转换使用的 LevelWriter。
+ *
+ * 文件为小端序，由文件头和若干连续的定长记录表组成，读取时只校验边界，不做任何解析：
+ * - 字符串表：StringRecord 指向字符数据区，其它记录通过下标引用字符串；
+ * - 瓦片表：关卡内所有用到的瓦片（下标 0 为空瓦片），瓦片图层的格子是指向该表的 u16 下标数组；
+ * - 图层表：保持 Tiled 中的图层顺序（渲染层按此分配），对象图层引用对象表的一段；
+ * - 对象表：对象的瓦片下标以及原始对象 JSON（CBOR 编码），对象构建器仍按 Tiled 属性工作；
+ * - 动画表、帧表、音效表：由瓦片属性 "animation" / "sound" 中的 JSON 字符串预先解析而来。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::scene::level_binary {
+
+	inline constexpr std::array<char, 4> MAGIC{ 'S', 'L', 'V', 'B' };
+	inline constexpr std::uint32_t VERSION = 1;
+	inline constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;   ///< 字符串、瓦片等下标的空值
+	inline constexpr const char* EXTENSION = ".lvb";         ///< 预编译关卡文件的扩展名（与 .tmj 位于同一目录）
+
+	/// 一张记录表在文件中的位置：offset 为相对文件开头的字节偏移，count 为记录数（字节数据区为字节数）
+	struct Section {
+		std::uint32_t offset = 0;
+		std::uint32_t count = 0;
+	};
+
+	/// 数据区中的一段字节：offset 相对数据区（Header::payload）开头
+	struct Blob {
+		std::uint32_t offset = 0;
+		std::uint32_t size = 0;
+	};
+
+	struct StringRecord {
+		std::uint32_t offset = 0;   ///< 相对字符数据区开头
+		std::uint32_t length = 0;
+	};
+
+	inline constexpr std::uint16_t TILE_HAS_ANIMATION = 1u << 0;   ///< 瓦片有可解析的 "animation" 属性（动画表可能为空）
+	inline constexpr std::uint16_t TILE_HAS_SOUND = 1u << 1;       ///< 瓦片有可解析的 "sound" 属性
+
+	struct TileRecord {
+		std::uint32_t texture = NO_INDEX;   ///< 纹理路径（相对地图文件所在目录）
+		float src_x = 0.0f;
+		float src_y = 0.0f;
+		float src_w = 0.0f;
+		float src_h = 0.0f;
+		std::uint8_t type = 0;              ///< engine::component::TileType
+		std::uint8_t has_src_rect = 0;
+		std::uint16_t flags = 0;            ///< TILE_HAS_ANIMATION / TILE_HAS_SOUND
+		Blob json;                          ///< 瓦片 JSON（CBOR），只为对象引用的瓦片保存，size 为 0 表示没有
+		std::uint32_t first_animation = 0;
+		std::uint32_t animation_count = 0;
+		std::uint32_t first_sound = 0;
+		std::uint32_t sound_count = 0;
+	};
+
+	enum class LayerType : std::uint8_t {
+		IMAGE = 0,
+		TILE = 1,
+		OBJECT = 2,
+	};
+
+	struct LayerRecord {
+		LayerType type = LayerType::TILE;
+		std::uint8_t visible = 1;
+		std::uint8_t repeat_x = 0;
+		std::uint8_t repeat_y = 0;
+		std::uint32_t name = NO_INDEX;
+		float offset_x = 0.0f;
+		float offset_y = 0.0f;
+		float parallax_x = 1.0f;
+		float parallax_y = 1.0f;
+		std::uint32_t image = NO_INDEX;     ///< 图片图层：图片路径（相对地图文件所在目录）
+		std::int32_t width = 0;             ///< 瓦片图层：网格尺寸
+		std::int32_t height = 0;
+		Blob cells;                         ///< 瓦片图层：width * height 个 u16 瓦片下标
+		std::uint32_t first_object = 0;     ///< 对象图层：对象表中的范围
+		std::uint32_t object_count = 0;
+	};
+
+	struct ObjectRecord {
+		std::uint32_t tile = NO_INDEX;      ///< 瓦片表下标，形状对象为 NO_INDEX
+		std::uint32_t gid = 0;              ///< 原始 gid（仅用于日志）
+		Blob json;                          ///< 对象 JSON（CBOR）
+	};
+
+	struct AnimationRecord {
+		std::uint32_t name = NO_INDEX;
+		std::uint32_t first_frame = 0;
+		std::uint32_t frame_count = 0;
+		std::uint8_t loop = 1;
+		std::uint8_t reserved[3]{};
+	};
+
+	struct FrameRecord {
+		std::int32_t column = 0;            ///< 帧所在列，源矩形在构建对象时按精灵尺寸换算
+		std::int32_t row = 0;
+		float duration = 0.0f;              ///< 秒
+	};
+
+	struct SoundRecord {
+		std::uint32_t name = NO_INDEX;
+		std::uint32_t path = NO_INDEX;      ///< 音效文件路径（原样保存）
+	};
+
+	struct Header {
+		std::array<char, 4> magic = MAGIC;
+		std::uint32_t version = VERSION;
+		std::int32_t map_width = 0;
+		std::int32_t map_height = 0;
+		std::int32_t tile_width = 0;
+		std::int32_t tile_height = 0;
+		std::uint32_t broadphase = NO_INDEX; ///< 地图属性 "broadphase"
+		std::uint32_t reserved = 0;
+		Section strings;                    ///< StringRecord
+		Section string_data;                ///< 字符数据（字节）
+		Section dependencies;               ///< u32 字符串下标：生成该文件的源文件（相对地图文件所在目录）
+		Section tiles;                      ///< TileRecord
+		Section layers;                     ///< LayerRecord
+		Section objects;                    ///< ObjectRecord
+		Section animations;                 ///< AnimationRecord
+		Section frames;                     ///< FrameRecord
+		Section sounds;                     ///< SoundRecord
+		Section payload;                    ///< 格子与 CBOR 数据（字节）
+	};
+
+	static_assert(sizeof(TileRecord) == 48);
+	static_assert(sizeof(LayerRecord) == 52);
+	static_assert(sizeof(Header) == 112);
+
+	/**
+	 * @brief 地图文件对应的预编译关卡路径（替换扩展名为 .lvb）。
+	 */
+	std::string bakedPathFor(const std::string& map_path);
+
+	/**
+	 * @class LevelFile
+	 * @brief 以只读内存映射方式打开的预编译关卡文件。
+	 *
+	 * open() 一次性校验文件头与所有记录表、格子和 CBOR 数据的边界，之后的访问不再检查。
+	 * 返回的 span / string_view 直接指向映射内存，仅在 LevelFile 存活期间有效。
+	 */
+	class LevelFile final {
+	private:
+		const std::byte* data_ = nullptr;
+		size_t size_ = 0;
+#ifdef _WIN32
+		void* file_handle_ = nullptr;
+		void* mapping_handle_ = nullptr;
+#endif
+
+		LevelFile() = default;
+
+	public:
+		/**
+		 * @brief 打开并校验预编译关卡文件。
+		 * @param path 文件路径。
+		 * @return 失败（不存在、版本不符或数据越界）时返回 nullptr 并记录原因。
+		 */
+		static std::unique_ptr<LevelFile> open(const std::string& path);
+		~LevelFile();
+
+		const Header& header() const { return *reinterpret_cast<const Header*>(data_); }
+
+		/// 字符串表中的字符串，NO_INDEX 返回空串
+		std::string_view string(std::uint32_t index) const;
+
+		std::span<const std::uint32_t> dependencies() const { return section<std::uint32_t>(header().dependencies); }
+		std::span<const TileRecord> tiles() const { return section<TileRecord>(header().tiles); }
+		std::span<const LayerRecord> layers() const { return section<LayerRecord>(header().layers); }
+		std::span<const ObjectRecord> objects() const { return section<ObjectRecord>(header().objects); }
+		std::span<const AnimationRecord> animations() const { return section<AnimationRecord>(header().animations); }
+		std::span<const FrameRecord> frames() const { return section<FrameRecord>(header().frames); }
+		std::span<const SoundRecord> sounds() const { return section<SoundRecord>(header().sounds); }
+
+		/// 瓦片图层的格子（width * height 个瓦片下标）
+		std::span<const std::uint16_t> cells(const LayerRecord& layer) const;
+
+		/// 数据区中的字节
+		std::span<const std::uint8_t> bytes(const Blob& blob) const;
+
+		// 禁用拷贝和移动语义
+		LevelFile(const LevelFile&) = delete;
+		LevelFile& operator=(const LevelFile&) = delete;
+		LevelFile(LevelFile&&) = delete;
+		LevelFile& operator=(LevelFile&&) = delete;
+
+	private:
+		template<typename T>
+		std::span<const T> section(const Section& section) const {
+			return { reinterpret_cast<const T*>(data_ + section.offset), section.count };
+		}
+
+		/// 校验所有记录表和引用的边界
+		bool validate(const std::string& path) const;
+	};
+
+	/**
+	 * @class LevelWriter
+	 * @brief 收集记录并写出预编译关卡文件（离线转换使用）。
+	 */
+	class LevelWriter final {
+	private:
+		std::vector<std::string> strings_;
+		std::unordered_map<std::string, std::uint32_t> string_indices_;
+		std::vector<std::uint8_t> payload_;
+
+	public:
+		Header header;
+		std::vector<std::uint32_t> dependencies;
+		std::vector<TileRecord> tiles;
+		std::vector<LayerRecord> layers;
+		std::vector<ObjectRecord> objects;
+		std::vector<AnimationRecord> animations;
+		std::vector<FrameRecord> frames;
+		std::vector<SoundRecord> sounds;
+
+		LevelWriter() = default;
+
+		/// 登记字符串（去重），返回下标
+		std::uint32_t addString(const std::string& value);
+
+		/// 追加格子数据，返回其在数据区中的位置
+		Blob addCells(const std::vector<std::uint16_t>& cells);
+
+		/// 追加字节数据，返回其在数据区中的位置
+		Blob addBytes(const std::vector<std::uint8_t>& bytes);
+
+		/**
+		 * @brief 写出文件（先写临时文件再改名，避免游戏读到写了一半的文件）。
+		 * @param path 输出路径。
+		 * @return 成功返回 true。
+		 */
+		bool write(const std::string& path);
+
+		// 禁用拷贝和移动语义
+		LevelWriter(const LevelWriter&) = delete;
+		LevelWriter& operator=(const LevelWriter&) = delete;
+		LevelWriter(LevelWriter&&) = delete;
+		LevelWriter& operator=(LevelWriter&&) = delete;
+	};
+
+} // namespace engine::scene::level_binary
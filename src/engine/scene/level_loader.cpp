@@ -9,6 +9,9 @@
 #include "../component/health_component.h"
 #include "../component/audio_component.h"
 #include "../physics/collider.h"
+#include "../physics/physics_engine.h"
+#include "../physics/tile_collider_set.h"
+#include "../physics/slope_table.h"
 #include "../object/game_object.h"
 #include "../object/object_builder.h"
 #include "../scene/scene.h"
@@ -16,16 +19,118 @@
 #include "../resource/resource_manager.h"
 #include "../render/sprite.h"
 #include "../render/animation.h"
+#include "../render/render_order.h"
 #include "../utils/math.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <system_error>
 
 namespace engine::scene {
 
+    LevelLoader::~LevelLoader() = default;
+
+    bool LevelLoader::preload(const std::string& level_path) {
+        prepared_path_.clear();
+        baked_file_.reset();
+        baked_tile_jsons_.clear();
+        map_json_ = nlohmann::json();
+        tileset_data_.clear();
+        tile_table_.clear();
+        cache_ = CachedTileset{};
+
+        // 预编译关卡不早于源文件时直接映射，否则读取地图 JSON 与瓦片集
+        if (!openBakedLevel(level_path) && !readMap(level_path, map_json_)) {
+            return false;
+        }
+        prepared_path_ = level_path;
+        return true;
+    }
+
+    std::vector<std::string> LevelLoader::getTexturePaths() {
+        if (!baked_file_) {
+            return collectTexturePaths(map_json_);
+        }
+        std::vector<std::string> texture_paths;
+        for (const auto& tile : baked_file_->tiles()) {
+            if (tile.texture != level_binary::NO_INDEX) {
+                texture_paths.push_back(resolvePath(std::string(baked_file_->string(tile.texture)), map_path_));
+            }
+        }
+        for (const auto& layer : baked_file_->layers()) {
+            if (layer.type == level_binary::LayerType::IMAGE && layer.visible && layer.image != level_binary::NO_INDEX) {
+                texture_paths.push_back(resolvePath(std::string(baked_file_->string(layer.image)), map_path_));
+            }
+        }
+        return texture_paths;
+    }
+
     bool LevelLoader::loadLevel(const std::string& level_path, Scene& scene) {
+        // 1~4. 读取地图（已为该路径调用过 preload 时直接使用其结果）
+        if (prepared_path_ != level_path && !preload(level_path)) {
+            return false;
+        }
+        prepared_path_.clear();
+
+        const bool loaded = baked_file_ ? loadBakedLevel(scene) : loadJsonLevel(scene);
+        map_json_ = nlohmann::json();
+        return loaded;
+    }
+
+    bool LevelLoader::loadJsonLevel(Scene& scene) {
+        const auto& json_data = map_json_;
+
+        // 关卡可通过地图自定义属性 "broadphase" 指定物体碰撞的粗检测策略
+        if (auto broadphase = getTileProperty<std::string>(json_data, "broadphase"); broadphase) {
+            applyBroadphase(*broadphase, scene);
+        }
+
+        // 把关卡用到的图片打包为纹理图集（瓦片与对象共用少数几张图集页，减少绘制时的纹理切换）
+        scene.getContext().getResourceManager().buildTextureAtlas(getTexturePaths());
+
+        // 5. 加载图层数据
+        // 渲染层按图层顺序分配：第一个对象图层对应 render_layer::DEFAULT（运行时创建的对象也在这一层），
+        // 之前的图层依次减一，之后的依次加一
+        const auto& layers = json_data["layers"];
+        const auto first_object_layer = std::find_if(layers.begin(), layers.end(),
+            [](const nlohmann::json& layer) { return layer.value("type", "none") == "objectgroup"; });
+        const int object_layer_index = static_cast<int>(std::distance(layers.begin(), first_object_layer));
+        int layer_index = 0;
+        for (const auto& layer_json : layers) {
+            current_render_layer_ = getRenderLayer(layer_index++, object_layer_index);
+
+            // 获取各图层对象中的类型（type）字段
+            std::string layer_type = layer_json.value("type", "none");
+            if (!layer_json.value("visible", true)) {
+                spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
+                continue;
+            }
+
+            // 根据图层类型决定加载方法
+            if (layer_type == "imagelayer") {
+                loadImageLayer(layer_json, scene);
+            }
+            else if (layer_type == "tilelayer") {
+                loadTileLayer(layer_json, scene);
+            }
+            else if (layer_type == "objectgroup") {
+                loadObjectLayer(layer_json, scene);
+            }
+            else {
+                spdlog::warn("不支持的图层类型: {}", layer_type);
+            }
+        }
+
+        spdlog::info("关卡加载完成: {}", map_path_);
+        return true;
+    }
+
+    bool LevelLoader::readMap(const std::string& level_path, nlohmann::json& json_data) {
         // 1. 加载 JSON 文件
         std::ifstream file(level_path);
         if (!file.is_open()) {
@@ -34,7 +139,6 @@ namespace engine::scene {
         }
 
         // 2. 解析 JSON 数据
-        nlohmann::json json_data;
         try {
             file >> json_data;
         }
@@ -62,36 +166,26 @@ namespace engine::scene {
             }
         }
 
-        // 5. 加载图层数据
         if (!json_data.contains("layers") || !json_data["layers"].is_array()) {       // 地图文件中必须有 layers 数组
             spdlog::error("地图文件 '{}' 中缺少或无效的 'layers' 数组。", level_path);
             return false;
         }
-        for (const auto& layer_json : json_data["layers"]) {
-            // 获取各图层对象中的类型（type）字段
-            std::string layer_type = layer_json.value("type", "none");
-            if (!layer_json.value("visible", true)) {
-                spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
-                continue;
-            }
+        return true;
+    }
 
-            // 根据图层类型决定加载方法
-            if (layer_type == "imagelayer") {
-                loadImageLayer(layer_json, scene);
-            }
-            else if (layer_type == "tilelayer") {
-                loadTileLayer(layer_json, scene);
-            }
-            else if (layer_type == "objectgroup") {
-                loadObjectLayer(layer_json, scene);
-            }
-            else {
-                spdlog::warn("不支持的图层类型: {}", layer_type);
-            }
+    void LevelLoader::applyBroadphase(const std::string& broadphase, Scene& scene) {
+        if (auto mode = engine::physics::parseBroadphaseMode(broadphase); mode) {
+            scene.getContext().getPhysicsEngine().setBroadphaseMode(*mode);
         }
+        else {
+            spdlog::warn("关卡 '{}' 的 broadphase 属性无效: {}", map_path_, broadphase);
+        }
+    }
 
-        spdlog::info("关卡加载完成: {}", level_path);
-        return true;
+    std::uint8_t LevelLoader::getRenderLayer(int layer_index, int object_layer_index) {
+        return static_cast<std::uint8_t>(std::clamp(
+            engine::render::render_layer::DEFAULT + layer_index - object_layer_index,
+            static_cast<int>(engine::render::render_layer::FIRST), static_cast<int>(engine::render::render_layer::LAST)));
     }
 
     void LevelLoader::loadImageLayer(const nlohmann::json& layer_json, Scene& scene) {
@@ -115,11 +209,17 @@ namespace engine::scene {
 
         /*  可用类似方法获取其它各种属性，这里我们暂时用不上 */
 
+        addImageLayer(layer_name, texture_id, offset, scroll_factor, repeat, scene);
+    }
+
+    void LevelLoader::addImageLayer(const std::string& layer_name, std::string texture_id, const glm::vec2& offset,
+        const glm::vec2& scroll_factor, const glm::bvec2& repeat, Scene& scene) {
         // 创建游戏对象
         auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
         // 依次添加Transform，Parallax组件
         game_object->addComponent<engine::component::TransformComponent>(offset);
         game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
+        game_object->setRenderLayer(current_render_layer_);
         // 添加到场景中
         scene.addGameObject(std::move(game_object));
         spdlog::info("加载图层: '{}' 完成", layer_name);
@@ -140,32 +240,60 @@ namespace engine::scene {
 
         const glm::vec2 layer_offset(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
 
-        // 准备 TileInfo Vector (瓦片数量 = 地图宽度 * 地图高度)
-        std::vector<engine::component::TileInfo> tiles;
-        tiles.reserve(static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y));
+        // 准备原型表与下标网格 (格子数量 = 地图宽度 * 地图高度)，原型下标 0 固定为空瓦片
+        std::vector<engine::component::TileInfo> prototypes;
+        prototypes.emplace_back(engine::render::Sprite(), engine::component::TileType::EMPTY);
+        std::unordered_map<int, std::uint16_t> prototype_of_gid{ { 0, std::uint16_t{ 0 } } };
+        std::vector<std::uint16_t> cells;
+        cells.reserve(static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y));
 
         // 获取图层数据 (瓦片 ID 列表)
         const auto& data = layer_json["data"];
 
-        // 根据gid获取必要信息，并依次填充 TileInfo Vector
-        for (const auto& gid : data) {
-            tiles.push_back(getTileInfoByGid(gid));
+        // 每种 gid 只解析一次，格子只记录原型下标
+        for (const auto& gid_json : data) {
+            const int gid = gid_json.get<int>();
+            auto [it, inserted] = prototype_of_gid.try_emplace(gid, std::uint16_t{ 0 });
+            if (inserted) {
+                if (prototypes.size() > std::numeric_limits<std::uint16_t>::max()) {
+                    spdlog::warn("图层 '{}' 的瓦片种类超过 {}，gid {} 按空瓦片处理。", layer_json.value("name", "Unnamed"),
+                        std::numeric_limits<std::uint16_t>::max(), gid);
+                }
+                else {
+                    it->second = static_cast<std::uint16_t>(prototypes.size());
+                    prototypes.push_back(getTileInfoByGid(gid));
+                }
+            }
+            cells.push_back(it->second);
         }
 
-        if (tiles.size() != static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y)) {
+        if (cells.size() != static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y)) {
             spdlog::warn("图层 '{}' 的瓦片数据数量({})与 width*height({})不一致。", layer_json.value("name", "Unnamed"),
-                tiles.size(), static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y));
+                cells.size(), static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y));
         }
 
         // 获取图层名称
         const std::string& layer_name = layer_json.value("name", "Unnamed");
+        addTileLayer(layer_name, layer_offset, layer_map_size, std::move(prototypes), std::move(cells), scene);
+    }
+
+    void LevelLoader::addTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& layer_map_size,
+        std::vector<engine::component::TileInfo> prototypes, std::vector<std::uint16_t> cells, Scene& scene)
+    {
         // 创建游戏对象
         auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
         // 始终添加 TransformComponent，即使 offset 为 0，保证渲染和逻辑一致性
-        game_object->addComponent<engine::component::TransformComponent>(layer_offset);
+        game_object->addComponent<engine::component::TransformComponent>(offset);
         
+        game_object->setRenderLayer(current_render_layer_);
         // 添加Tilelayer组件
-        game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, layer_map_size, std::move(tiles));
+        auto* tile_layer = game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, layer_map_size, std::move(prototypes), std::move(cells));
+
+        // 加载期合并实体瓦片，物理引擎按矩形而非逐格检测
+        if (const size_t rect_count = tile_layer->buildStaticColliders(); rect_count > 0) {
+            spdlog::info("图层 '{}' 的 {} 个实体瓦片合并为 {} 个静态碰撞矩形。", layer_name,
+                tile_layer->getStaticColliders()->getSourceTileCount(), rect_count);
+        }
         // 添加到场景中
         scene.addGameObject(std::move(game_object));
     }
@@ -183,40 +311,406 @@ namespace engine::scene {
         const auto& objects = layer_json["objects"];
         for (const auto& object : objects) {
             auto gid = object.value("gid", 0);
+            // 如果gid存在，则代表这是一个带图像的对象
+            addObject(builder, object, gid, gid != 0 ? std::optional<TileData>(getTileDataByGid(gid)) : std::nullopt, scene);
+        }
+    } 
+
+    void LevelLoader::addObject(engine::object::ObjectBuilder& builder, const nlohmann::json& object, int gid,
+        std::optional<TileData> tile_data, Scene& scene)
+    {
+        if (!tile_data) {
+            // 处理形状对象 (如矩形 trigger)
+            builder.configure(&object);
+        }
+        else {
+            if (!tile_data->info.sprite.getTextureHandle().isValid()) {
+                spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
+                return;
+            }
+            // 使用 ObjectBuilder 构建对象
+            builder.configure(&object, tile_data->json_ptr, std::move(tile_data->info));
+        }
+        builder.build();
+        auto game_object = builder.getGameObject();
+
+        if (game_object) {
+            game_object->setRenderLayer(current_render_layer_);
+            scene.addGameObject(std::move(game_object));
+            if (tile_data) {
+                spdlog::info("加载对象: '{}' 完成", object.value("name", "Unnamed"));
+            }
+        }
+    }
+
+    bool LevelLoader::openBakedLevel(const std::string& level_path)
+    {
+        namespace fs = std::filesystem;
+        namespace lb = level_binary;
 
-            if (gid == 0) {
-                // 处理形状对象 (如矩形 trigger)
-                builder.configure(&object);
-                builder.build();
-                auto game_object = builder.getGameObject();
-                if (game_object) {
-                    scene.addGameObject(std::move(game_object));
+        // 预编译文件不存在或早于地图、瓦片集时使用 JSON
+        const std::string baked_path = lb::bakedPathFor(level_path);
+        std::error_code ec;
+        const auto baked_time = fs::last_write_time(baked_path, ec);
+        if (ec) {
+            return false;
+        }
+        if (const auto source_time = fs::last_write_time(level_path, ec); !ec && source_time > baked_time) {
+            spdlog::info("预编译关卡 '{}' 早于地图文件，使用 JSON 加载。", baked_path);
+            return false;
+        }
+        auto file = lb::LevelFile::open(baked_path);
+        if (!file) {
+            return false;
+        }
+        const auto map_dir = fs::path(level_path).parent_path();
+        for (const auto index : file->dependencies()) {
+            const auto dependency = map_dir / fs::path(std::string(file->string(index)));
+            if (const auto time = fs::last_write_time(dependency, ec); !ec && time > baked_time) {
+                spdlog::info("预编译关卡 '{}' 早于 '{}'，使用 JSON 加载。", baked_path, dependency.string());
+                return false;
+            }
+        }
+
+        // 先解码对象用到的瓦片 JSON（CBOR），失败时场景尚未改动，可以退回 JSON 加载
+        std::unordered_map<std::uint32_t, nlohmann::json> tile_jsons;
+        const auto tiles = file->tiles();
+        try {
+            for (std::uint32_t i = 0; i < tiles.size(); ++i) {
+                if (tiles[i].json.size > 0) {
+                    const auto bytes = file->bytes(tiles[i].json);
+                    tile_jsons.emplace(i, nlohmann::json::from_cbor(bytes.begin(), bytes.end()));
                 }
             }
-            else {
-                // 如果gid存在，则代表这是一个带图像的对象
-                auto tile_data = getTileDataByGid(gid);
-                auto& tile_info = tile_data.info;
-                auto* tile_json = tile_data.json_ptr;
+        }
+        catch (const nlohmann::json::exception& e) {
+            spdlog::error("预编译关卡 '{}' 的瓦片数据无效: {}", baked_path, e.what());
+            return false;
+        }
 
-                if (tile_info.sprite.getTextureId().empty()) {
-                    spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
-                    continue;
+        const auto& header = file->header();
+        map_path_ = level_path;
+        map_size_ = glm::ivec2(header.map_width, header.map_height);
+        tile_size_ = glm::ivec2(header.tile_width, header.tile_height);
+        baked_file_ = std::move(file);
+        baked_tile_jsons_ = std::move(tile_jsons);
+        return true;
+    }
+
+    bool LevelLoader::loadBakedLevel(Scene& scene)
+    {
+        namespace lb = level_binary;
+        const auto& baked = *baked_file_;
+        const auto& header = baked.header();
+        const auto tiles = baked.tiles();
+
+        if (header.broadphase != lb::NO_INDEX) {
+            applyBroadphase(std::string(baked.string(header.broadphase)), scene);
+        }
+
+        // 瓦片原型（纹理路径按地图目录解析，与 JSON 加载得到的路径一致）
+        std::vector<engine::component::TileInfo> prototypes;
+        prototypes.reserve(tiles.size());
+        for (const auto& tile : tiles) {
+            const auto type = static_cast<engine::component::TileType>(tile.type);
+            if (tile.texture == lb::NO_INDEX) {
+                prototypes.emplace_back(engine::render::Sprite(), type);
+                continue;
+            }
+            auto texture_id = resolvePath(std::string(baked.string(tile.texture)), map_path_);
+            const auto src_rect = tile.has_src_rect ? std::optional<SDL_FRect>(SDL_FRect{ tile.src_x, tile.src_y, tile.src_w, tile.src_h }) : std::nullopt;
+            prototypes.emplace_back(engine::render::Sprite(texture_id, src_rect), type);
+        }
+        scene.getContext().getResourceManager().buildTextureAtlas(getTexturePaths());
+
+        // 图层（渲染层的分配与 JSON 加载相同）
+        const auto layers = baked.layers();
+        const auto first_object_layer = std::find_if(layers.begin(), layers.end(),
+            [](const lb::LayerRecord& layer) { return layer.type == lb::LayerType::OBJECT; });
+        const int object_layer_index = static_cast<int>(std::distance(layers.begin(), first_object_layer));
+        const auto objects = baked.objects();
+        int layer_index = 0;
+        for (const auto& layer : layers) {
+            current_render_layer_ = getRenderLayer(layer_index++, object_layer_index);
+            const std::string layer_name = layer.name != lb::NO_INDEX ? std::string(baked.string(layer.name)) : "Unnamed";
+            if (!layer.visible) {
+                spdlog::info("图层 '{}' 不可见，跳过加载。", layer_name);
+                continue;
+            }
+            const glm::vec2 offset(layer.offset_x, layer.offset_y);
+
+            switch (layer.type) {
+            case lb::LayerType::IMAGE:
+                if (layer.image == lb::NO_INDEX) {
+                    spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_name);
+                    break;
+                }
+                addImageLayer(layer_name, resolvePath(std::string(baked.string(layer.image)), map_path_), offset,
+                    glm::vec2(layer.parallax_x, layer.parallax_y), glm::bvec2(layer.repeat_x != 0, layer.repeat_y != 0), scene);
+                break;
+            case lb::LayerType::TILE: {
+                const auto cells = baked.cells(layer);
+                addTileLayer(layer_name, offset, glm::ivec2(layer.width, layer.height), prototypes,
+                    std::vector<std::uint16_t>(cells.begin(), cells.end()), scene);
+                break;
+            }
+            case lb::LayerType::OBJECT: {
+                engine::object::ObjectBuilder builder(*this, scene.getContext());
+                for (const auto& object : objects.subspan(layer.first_object, layer.object_count)) {
+                    const auto bytes = baked.bytes(object.json);
+                    const auto object_json = nlohmann::json::from_cbor(bytes.begin(), bytes.end(), true, false);
+                    if (object_json.is_discarded()) {
+                        spdlog::error("预编译关卡 '{}' 中图层 '{}' 的对象数据无效。", map_path_, layer_name);
+                        continue;
+                    }
+                    std::optional<TileData> tile_data;
+                    if (object.tile != lb::NO_INDEX) {
+                        const auto it = baked_tile_jsons_.find(object.tile);
+                        tile_data = TileData{ prototypes[object.tile], it != baked_tile_jsons_.end() ? &it->second : nullptr };
+                    }
+                    addObject(builder, object_json, static_cast<int>(object.gid), std::move(tile_data), scene);
                 }
+                break;
+            }
+            }
+        }
+
+        spdlog::info("关卡加载完成（预编译）: {}", map_path_);
+        return true;
+    }
+
+    const level_binary::TileRecord* LevelLoader::findBakedTile(const nlohmann::json& tile_json) const
+    {
+        if (!baked_file_) return nullptr;
+        for (const auto& [index, json] : baked_tile_jsons_) {
+            if (&json == &tile_json) {
+                return &baked_file_->tiles()[index];
+            }
+        }
+        return nullptr;
+    }
+
+    void LevelLoader::addBakedAnimations(const level_binary::TileRecord& tile, engine::component::AnimationComponent* anim_comp, const glm::vec2& size) const
+    {
+        if (!baked_file_ || !anim_comp) return;
+        const auto frames = baked_file_->frames();
+        for (const auto& record : baked_file_->animations().subspan(tile.first_animation, tile.animation_count)) {
+            auto animation = std::make_unique<engine::render::Animation>(std::string(baked_file_->string(record.name)), record.loop != 0);
+            for (const auto& frame : frames.subspan(record.first_frame, record.frame_count)) {
+                animation->addFrame(SDL_FRect{ frame.column * size.x, frame.row * size.y, size.x, size.y }, frame.duration);
+            }
+            anim_comp->addAnimation(std::move(animation));
+        }
+    }
+
+    void LevelLoader::addBakedSounds(const level_binary::TileRecord& tile, engine::component::AudioComponent* audio) const
+    {
+        if (!baked_file_ || !audio) return;
+        for (const auto& record : baked_file_->sounds().subspan(tile.first_sound, tile.sound_count)) {
+            audio->registerSound(std::string(baked_file_->string(record.name)), std::string(baked_file_->string(record.path)));
+        }
+    }
+
+    bool LevelLoader::bakeLevel(const std::string& map_path, const std::string& output_path)
+    {
+        namespace fs = std::filesystem;
+        namespace lb = level_binary;
+
+        nlohmann::json json_data;
+        if (!readMap(map_path, json_data)) {
+            return false;
+        }
+
+        lb::LevelWriter writer;
+        writer.header.map_width = map_size_.x;
+        writer.header.map_height = map_size_.y;
+        writer.header.tile_width = tile_size_.x;
+        writer.header.tile_height = tile_size_.y;
+        if (auto broadphase = getTileProperty<std::string>(json_data, "broadphase"); broadphase) {
+            writer.header.broadphase = writer.addString(*broadphase);
+        }
+
+        // 路径统一保存为相对地图文件所在目录，预编译文件可以随资源目录一起移动
+        const auto map_dir = fs::path(map_path).parent_path();
+        auto relative_to_map = [&map_dir](const std::string& path) {
+            std::error_code ec;
+            const auto relative = fs::relative(path, map_dir, ec);
+            return ec || relative.empty() ? path : relative.generic_string();
+        };
+        writer.dependencies.push_back(writer.addString(fs::path(map_path).filename().generic_string()));
+        for (const auto& [first_gid, tileset] : tileset_data_) {
+            writer.dependencies.push_back(writer.addString(relative_to_map(tileset.value("file_path", ""))));
+        }
+
+        // 瓦片表：下标 0 为空瓦片，其余按首次出现的顺序登记
+        writer.tiles.push_back(lb::TileRecord{});
+        writer.tiles.back().type = static_cast<std::uint8_t>(engine::component::TileType::EMPTY);
+        std::unordered_map<int, std::uint32_t> tile_of_gid{ { 0, 0u } };
+        std::vector<const nlohmann::json*> tile_json_of_index{ nullptr };
+        auto tile_index = [&](int gid) {
+            auto [it, inserted] = tile_of_gid.try_emplace(gid, static_cast<std::uint32_t>(writer.tiles.size()));
+            if (inserted) {
+                const auto tile_data = getTileDataByGid(gid);
+                lb::TileRecord record;
+                if (tile_data.info.sprite.getTextureHandle().isValid()) {
+                    record.texture = writer.addString(relative_to_map(tile_data.info.sprite.getTextureId()));
+                }
+                if (const auto& src_rect = tile_data.info.sprite.getSourceRect(); src_rect) {
+                    record.src_x = src_rect->x;
+                    record.src_y = src_rect->y;
+                    record.src_w = src_rect->w;
+                    record.src_h = src_rect->h;
+                    record.has_src_rect = 1;
+                }
+                record.type = static_cast<std::uint8_t>(tile_data.info.type);
+                writer.tiles.push_back(record);
+                tile_json_of_index.push_back(tile_data.json_ptr);
+            }
+            return it->second;
+        };
+
+        // 对象引用的瓦片保存 JSON，并预先解析动画与音效
+        auto attach_tile_json = [&](std::uint32_t index) {
+            const nlohmann::json* tile_json = tile_json_of_index[index];
+            auto& record = writer.tiles[index];
+            if (!tile_json || record.json.size > 0) return;
+            record.json = writer.addBytes(nlohmann::json::to_cbor(*tile_json));
+            record.first_animation = static_cast<std::uint32_t>(writer.animations.size());
+            record.first_sound = static_cast<std::uint32_t>(writer.sounds.size());
+            bakeTileTables(*tile_json, record, writer);
+            record.animation_count = static_cast<std::uint32_t>(writer.animations.size()) - record.first_animation;
+            record.sound_count = static_cast<std::uint32_t>(writer.sounds.size()) - record.first_sound;
+        };
 
-                // 使用 ObjectBuilder 构建对象
-                builder.configure(&object, tile_json, std::move(tile_info));
-                builder.build();
-                auto game_object = builder.getGameObject();
-                
-                if (game_object) {
-                    scene.addGameObject(std::move(game_object));
-                    spdlog::info("加载对象: '{}' 完成", object.value("name", "Unnamed"));
+        for (const auto& layer_json : json_data["layers"]) {
+            const std::string layer_type = layer_json.value("type", "none");
+            lb::LayerRecord record;
+            record.name = writer.addString(layer_json.value("name", "Unnamed"));
+            record.visible = layer_json.value("visible", true) ? 1 : 0;
+            record.offset_x = layer_json.value("offsetx", 0.0f);
+            record.offset_y = layer_json.value("offsety", 0.0f);
+
+            if (layer_type == "imagelayer") {
+                record.type = lb::LayerType::IMAGE;
+                if (const std::string image_path = layer_json.value("image", ""); !image_path.empty()) {
+                    record.image = writer.addString(image_path);
+                }
+                record.parallax_x = layer_json.value("parallaxx", 1.0f);
+                record.parallax_y = layer_json.value("parallaxy", 1.0f);
+                record.repeat_x = layer_json.value("repeatx", false) ? 1 : 0;
+                record.repeat_y = layer_json.value("repeaty", false) ? 1 : 0;
+            }
+            else if (layer_type == "tilelayer") {
+                record.type = lb::LayerType::TILE;
+                const int width = layer_json.value("width", 0);
+                const int height = layer_json.value("height", 0);
+                if (record.visible && layer_json.contains("data") && layer_json["data"].is_array() && width > 0 && height > 0) {
+                    const auto& data = layer_json["data"];
+                    if (data.size() != static_cast<size_t>(width) * static_cast<size_t>(height)) {
+                        spdlog::warn("图层 '{}' 的瓦片数据数量({})与 width*height({})不一致，按 width*height 截断或补空。",
+                            layer_json.value("name", "Unnamed"), data.size(), static_cast<size_t>(width) * static_cast<size_t>(height));
+                    }
+                    std::vector<std::uint16_t> cells(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+                    for (size_t i = 0; i < std::min(cells.size(), data.size()); ++i) {
+                        const std::uint32_t index = tile_index(data[i].get<int>());
+                        if (index > std::numeric_limits<std::uint16_t>::max()) {
+                            spdlog::warn("关卡 '{}' 的瓦片种类超过 {}，多出的瓦片按空瓦片处理。", map_path, std::numeric_limits<std::uint16_t>::max());
+                            continue;
+                        }
+                        cells[i] = static_cast<std::uint16_t>(index);
+                    }
+                    record.width = width;
+                    record.height = height;
+                    record.cells = writer.addCells(cells);
+                }
+                else {
+                    record.visible = 0;   // 无效或不可见的图层只保留位置，保证渲染层分配不变
+                }
+            }
+            else if (layer_type == "objectgroup") {
+                record.type = lb::LayerType::OBJECT;
+                record.first_object = static_cast<std::uint32_t>(writer.objects.size());
+                if (record.visible && layer_json.contains("objects") && layer_json["objects"].is_array()) {
+                    for (const auto& object : layer_json["objects"]) {
+                        lb::ObjectRecord object_record;
+                        const int gid = object.value("gid", 0);
+                        object_record.gid = static_cast<std::uint32_t>(gid);
+                        if (gid != 0) {
+                            object_record.tile = tile_index(gid);
+                            attach_tile_json(object_record.tile);
+                        }
+                        object_record.json = writer.addBytes(nlohmann::json::to_cbor(object));
+                        writer.objects.push_back(object_record);
+                    }
                 }
+                record.object_count = static_cast<std::uint32_t>(writer.objects.size()) - record.first_object;
             }
+            else {
+                spdlog::warn("不支持的图层类型: {}", layer_type);
+                record.type = lb::LayerType::IMAGE;
+                record.visible = 0;
+            }
+            writer.layers.push_back(record);
         }
-    } 
-    
+
+        if (!writer.write(output_path)) {
+            return false;
+        }
+        spdlog::info("关卡 '{}' 已预编译为 '{}'：{} 种瓦片，{} 个图层，{} 个对象。", map_path, output_path,
+            writer.tiles.size(), writer.layers.size(), writer.objects.size());
+        return true;
+    }
+
+    void LevelLoader::bakeTileTables(const nlohmann::json& tile_json, level_binary::TileRecord& record, level_binary::LevelWriter& writer)
+    {
+        // 与 ObjectBuilder::buildAnimation / buildAudio 的解析规则相同
+        if (auto anim_string = getTileProperty<std::string>(tile_json, "animation"); anim_string) {
+            const auto anim_json = nlohmann::json::parse(*anim_string, nullptr, false);
+            if (anim_json.is_object()) {
+                record.flags |= level_binary::TILE_HAS_ANIMATION;
+                for (const auto& anim : anim_json.items()) {
+                    const auto& anim_info = anim.value();
+                    if (!anim_info.is_object() || !anim_info.contains("frames") || !anim_info["frames"].is_array()) {
+                        spdlog::warn("动画 '{}' 的信息无效或缺少 'frames' 数组。", anim.key());
+                        continue;
+                    }
+                    level_binary::AnimationRecord animation;
+                    animation.name = writer.addString(anim.key());
+                    animation.loop = anim_info.value("loop", true) ? 1 : 0;
+                    animation.first_frame = static_cast<std::uint32_t>(writer.frames.size());
+                    const float duration = static_cast<float>(anim_info.value("duration", 100)) / 1000.0f;
+                    const int row = anim_info.value("row", 0);
+                    for (const auto& frame : anim_info["frames"]) {
+                        if (!frame.is_number_integer()) {
+                            spdlog::warn("动画 {} 中 frames 数组格式错误！", anim.key());
+                            continue;
+                        }
+                        writer.frames.push_back({ frame.get<int>(), row, duration });
+                    }
+                    animation.frame_count = static_cast<std::uint32_t>(writer.frames.size()) - animation.first_frame;
+                    writer.animations.push_back(animation);
+                }
+            }
+            else {
+                spdlog::error("解析动画 JSON 字符串失败: {}", *anim_string);
+            }
+        }
+        if (auto sound_string = getTileProperty<std::string>(tile_json, "sound"); sound_string) {
+            const auto sound_json = nlohmann::json::parse(*sound_string, nullptr, false);
+            if (sound_json.is_object()) {
+                record.flags |= level_binary::TILE_HAS_SOUND;
+                for (const auto& kv : sound_json.items()) {
+                    if (kv.value().is_string()) {
+                        writer.sounds.push_back({ writer.addString(kv.key()), writer.addString(kv.value().get<std::string>()) });
+                    }
+                }
+            }
+            else {
+                spdlog::error("解析音效 JSON 字符串失败: {}", *sound_string);
+            }
+        }
+    }
+
     const nlohmann::json* LevelLoader::findTileset(int gid)
     {
         // 清除GID的最高三位（翻转信息），得到原始GID值
@@ -246,28 +740,50 @@ namespace engine::scene {
 
     TileData LevelLoader::getTileDataByGid(int gid)
     {
-        auto make_empty_data = []() {
-            return TileData{ engine::component::TileInfo(engine::render::Sprite(), engine::component::TileType::EMPTY), nullptr };
-        };
-
         // 清除GID的最高三位（翻转信息），得到原始GID值
         const int FLIP_MASK = 0x1FFFFFFF;
         int original_gid = gid & FLIP_MASK;
 
+        // 绝大多数 gid 在加载瓦片集时已解析
+        if (original_gid > 0 && static_cast<size_t>(original_gid) < tile_table_.size() && tile_table_[original_gid].resolved) {
+            return tile_table_[original_gid].data;
+        }
+
         const nlohmann::json* tileset_ptr = findTileset(original_gid);
         if (!tileset_ptr) {
             if (original_gid != 0) spdlog::warn("gid为 {} 的瓦片未找到图块集。", original_gid);
-            return make_empty_data();
+            return makeEmptyTileData();
         }
-
-        const auto& tileset = *tileset_ptr;
+        // 超出瓦片集声明范围的 id 逐个解析（不缓存）
         auto local_id = original_gid - cache_.first_gid;
+        return makeTileData(*tileset_ptr, local_id, findTileJson(*tileset_ptr, local_id));
+    }
+
+    TileData LevelLoader::makeEmptyTileData()
+    {
+        return TileData{ engine::component::TileInfo(engine::render::Sprite(), engine::component::TileType::EMPTY), nullptr };
+    }
+
+    const nlohmann::json* LevelLoader::findTileJson(const nlohmann::json& tileset, int local_id)
+    {
+        if (tileset.contains("tiles") && tileset["tiles"].is_array()) {
+            for (const auto& tile_json : tileset["tiles"]) {
+                if (tile_json.value("id", -1) == local_id) {
+                    return &tile_json;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    TileData LevelLoader::makeTileData(const nlohmann::json& tileset, int local_id, const nlohmann::json* tile_json)
+    {
         const std::string file_path = tileset.value("file_path", "");
 
         if (tileset.contains("image")) {
             // Case 1: 单一图片 (Tileset Image)
             std::string image_path = tileset.value("image", "");
-            if (image_path.empty()) return make_empty_data();
+            if (image_path.empty()) return makeEmptyTileData();
 
             auto texture_id = resolvePath(image_path, file_path);
             
@@ -289,50 +805,57 @@ namespace engine::scene {
             };
             
             engine::render::Sprite sprite{ texture_id, texture_rect };
-            
-            // 查找瓦片的特定 JSON 配置用于获取类型和碰撞框
-            const nlohmann::json* tile_json = nullptr;
-            if (tileset.contains("tiles")) {
-                const auto& tiles_json = tileset["tiles"];
-                if (tiles_json.is_array()) {
-                    for (const auto& tj : tiles_json) {
-                        if (tj.value("id", -1) == local_id) {
-                            tile_json = &tj;
-                            break;
-                        }
-                    }
-                }
-            }
-
             auto tile_type = tile_json ? getTileType(*tile_json) : engine::component::TileType::NORMAL;
             return TileData{ engine::component::TileInfo(sprite, tile_type), tile_json };
         }
-        else {
-            // Case 2: 多图片集合
-            if (tileset.contains("tiles")) {
-                const auto& tiles_json = tileset["tiles"];
-                if (tiles_json.is_array()) {
-                    for (const auto& tile_json : tiles_json) {
-                        if (tile_json.value("id", -1) == local_id) {
-                            if (!tile_json.contains("image")) return make_empty_data();
-
-                            std::string image_path = tile_json.value("image", "");
-                            auto texture_id = resolvePath(image_path, file_path);
-                            
-                            SDL_FRect texture_rect = {
-                                static_cast<float>(tile_json.value("x", 0)),
-                                static_cast<float>(tile_json.value("y", 0)),
-                                static_cast<float>(tile_json.value("width", tile_json.value("imagewidth", 0))),    
-                                static_cast<float>(tile_json.value("height", tile_json.value("imageheight", 0)))
-                            };
-                            return TileData{ engine::component::TileInfo(engine::render::Sprite{ texture_id, texture_rect }, getTileType(tile_json)), &tile_json };
-                        }
-                    }
-                }
+
+        // Case 2: 多图片集合
+        if (!tile_json || !tile_json->contains("image")) return makeEmptyTileData();
+
+        std::string image_path = tile_json->value("image", "");
+        auto texture_id = resolvePath(image_path, file_path);
+        
+        SDL_FRect texture_rect = {
+            static_cast<float>(tile_json->value("x", 0)),
+            static_cast<float>(tile_json->value("y", 0)),
+            static_cast<float>(tile_json->value("width", tile_json->value("imagewidth", 0))),    
+            static_cast<float>(tile_json->value("height", tile_json->value("imageheight", 0)))
+        };
+        return TileData{ engine::component::TileInfo(engine::render::Sprite{ texture_id, texture_rect }, getTileType(*tile_json)), tile_json };
+    }
+
+    void LevelLoader::buildTileTable(int first_gid, const nlohmann::json& tileset)
+    {
+        // 瓦片 id -> 瓦片 JSON，只遍历一次 tiles 数组
+        std::unordered_map<int, const nlohmann::json*> tile_jsons;
+        int tile_count = 0;
+        if (tileset.contains("tiles") && tileset["tiles"].is_array()) {
+            for (const auto& tile_json : tileset["tiles"]) {
+                const int id = tile_json.value("id", -1);
+                if (id < 0) continue;
+                tile_jsons.try_emplace(id, &tile_json);
+                tile_count = std::max(tile_count, id + 1);
             }
         }
-        
-        return make_empty_data();
+        if (tileset.contains("image")) {
+            if (const int declared = tileset.value("tilecount", 0); declared > 0) {
+                tile_count = std::max(tile_count, declared);
+            }
+            else if (tile_size_.x > 0 && tile_size_.y > 0) {
+                tile_count = std::max(tile_count, (tileset.value("imagewidth", 0) / tile_size_.x) * (tileset.value("imageheight", 0) / tile_size_.y));
+            }
+        }
+        if (first_gid <= 0 || tile_count <= 0) return;
+
+        const size_t end_gid = static_cast<size_t>(first_gid) + static_cast<size_t>(tile_count);
+        if (tile_table_.size() < end_gid) {
+            tile_table_.resize(end_gid, ResolvedTile{ makeEmptyTileData(), false });
+        }
+        for (int local_id = 0; local_id < tile_count; ++local_id) {
+            const auto it = tile_jsons.find(local_id);
+            tile_table_[static_cast<size_t>(first_gid + local_id)] = ResolvedTile{
+                makeTileData(tileset, local_id, it != tile_jsons.end() ? it->second : nullptr), true };
+        }
     }
 
     engine::component::TileInfo LevelLoader::getTileInfoByGid(int gid)
@@ -357,24 +880,61 @@ namespace engine::scene {
             return;
         }
         ts_json["file_path"] = tileset_path;    // 将文件路径存储到json中，后续解析图片路径时需要
-        tileset_data_[first_gid] = std::move(ts_json);
+        auto& tileset = tileset_data_[first_gid];
+        tileset = std::move(ts_json);
+        cache_ = CachedTileset{};
+        // 一次性解析瓦片集中的全部瓦片，图层按 gid 直接查表（std::map 的节点地址稳定，表中的 JSON 指针一直有效）
+        buildTileTable(first_gid, tileset);
         spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
     }
 
+    std::vector<std::string> LevelLoader::collectTexturePaths(const nlohmann::json& map_json)
+    {
+        std::vector<std::string> paths;
+        if (map_json.contains("layers") && map_json["layers"].is_array()) {
+            for (const auto& layer_json : map_json["layers"]) {
+                if (layer_json.value("type", "none") == "imagelayer" && layer_json.value("visible", true)) {
+                    if (const std::string image_path = layer_json.value("image", ""); !image_path.empty()) {
+                        paths.push_back(resolvePath(image_path, map_path_));
+                    }
+                }
+            }
+        }
+        for (const auto& [first_gid, tileset] : tileset_data_) {
+            const std::string file_path = tileset.value("file_path", "");
+            if (const std::string image_path = tileset.value("image", ""); !image_path.empty()) {
+                paths.push_back(resolvePath(image_path, file_path));
+            }
+            if (tileset.contains("tiles") && tileset["tiles"].is_array()) {
+                for (const auto& tile_json : tileset["tiles"]) {
+                    if (const std::string image_path = tile_json.value("image", ""); !image_path.empty()) {
+                        paths.push_back(resolvePath(image_path, file_path));
+                    }
+                }
+            }
+        }
+        return paths;
+    }
+
     std::string LevelLoader::resolvePath(const std::string& relative_path, const std::string& file_path)
     {
+        // 获取地图文件的父目录（相对于可执行文件） "assets/maps/level1.tmj" -> "assets/maps"
+        auto map_dir = std::filesystem::path(file_path).parent_path();
+        // canonical 需要访问文件系统，同一目录下的同一相对路径只解析一次
+        auto [it, inserted] = resolved_paths_.try_emplace(map_dir.string() + '\n' + relative_path);
+        if (!inserted) {
+            return it->second;
+        }
         try {
-            // 获取地图文件的父目录（相对于可执行文件） "assets/maps/level1.tmj" -> "assets/maps"
-            auto map_dir = std::filesystem::path(file_path).parent_path();
             // 合并路径（相对于可执行文件）并返回。 /* std::filesystem::canonical：解析路径中的当前目录（.）和上级目录（..）导航符，
                                               /*  得到一个干净的路径 */
-            auto final_path = std::filesystem::canonical(map_dir / relative_path);
-            return final_path.string();
+            it->second = std::filesystem::canonical(map_dir / relative_path).string();
         }
         catch (const std::exception& e) {
             spdlog::error("解析路径失败: {}", e.what());
-            return relative_path;
+            it->second = relative_path;
         }
+        return it->second;
     }
 
     engine::component::TileType LevelLoader::getTileType(const nlohmann::json& tile_json)
@@ -389,13 +949,8 @@ namespace engine::scene {
                 }
                 else if (property.value("name", "") == "slope") {
                     std::string type_str = property.value("value", "");
-                            
-                    if (type_str == "0_1" || type_str == "slope_0_1") return engine::component::TileType::SLOPE_0_1;
-                    else if (type_str == "1_0" || type_str == "slope_1_0") return engine::component::TileType::SLOPE_1_0;
-                    else if (type_str == "0_2" || type_str == "slope_0_2") return engine::component::TileType::SLOPE_0_2;
-                    else if (type_str == "2_1" || type_str == "slope_2_1") return engine::component::TileType::SLOPE_2_1;
-                    else if (type_str == "1_2" || type_str == "slope_1_2") return engine::component::TileType::SLOPE_1_2;
-                    else if (type_str == "2_0" || type_str == "slope_2_0") return engine::component::TileType::SLOPE_2_0;
+                    // 斜坡名称登记在形状表中（slope_table.h），新增斜坡无需修改此处
+                    if (const auto slope = engine::physics::findSlopeByName(type_str)) return *slope;
                 }
                 else if (property.value("name", "") == "hazard") {
                     return property.value("value", false) ? engine::component::TileType::HAZARD : engine::component::TileType::NORMAL;
@@ -3,14 +3,20 @@
 #include <glm/vec2.hpp>
 #include <nlohmann/json.hpp>
 #include <map>
+#include <unordered_map>
 #include <optional>
+#include <vector>
+#include <cstdint>
+#include <memory>
 
 #include "../utils/math.h"
 #include "../component/tilelayer_component.h"
+#include "level_binary.h"
 namespace engine::component {
     struct TileInfo;
     enum class TileType;
 	class AnimationComponent;
+	class AudioComponent;
 
 }
 namespace engine::object {
@@ -51,8 +57,23 @@ namespace engine::scene {
         };
         CachedTileset cache_;
 
+        /// 按 gid 预先解析的瓦片（加载瓦片集时建立），图层加载时直接查表
+        struct ResolvedTile {
+            TileData data;
+            bool resolved = false;  ///< false 表示该 gid 不在任何瓦片集声明的范围内
+        };
+        std::vector<ResolvedTile> tile_table_;
+        std::unordered_map<std::string, std::string> resolved_paths_; ///< resolvePath 的结果缓存，键为 "目录\n相对路径"
+        std::uint8_t current_render_layer_ = 0; ///< 正在加载的图层对应的渲染层
+
+        std::string prepared_path_;  ///< 已通过 preload() 读取、尚未加载到场景的地图路径
+        nlohmann::json map_json_;    ///< 预加载的地图 JSON（预编译关卡不使用）
+        std::unique_ptr<level_binary::LevelFile> baked_file_;   ///< 正在加载的预编译关卡（映射内存需在对象构建期间保持有效）
+        std::unordered_map<std::uint32_t, nlohmann::json> baked_tile_jsons_; ///< 预编译关卡中对象引用的瓦片 JSON，键为瓦片表下标
+
     public:
         LevelLoader() = default;
+        ~LevelLoader();
 
         /**
          * @brief 加载关卡数据到指定的 Scene 对象中。
@@ -62,7 +83,67 @@ namespace engine::scene {
          */
         [[nodiscard]]bool loadLevel(const std::string& map_path, Scene& scene);
 
+        /**
+         * @brief 读取地图文件与瓦片集（或映射预编译关卡），不访问场景与上下文，可在后台线程调用。
+         * @param map_path 地图文件路径。
+         * @return bool 读取成功返回 true，之后以同一路径调用 loadLevel 时不再重复读取。
+         */
+        [[nodiscard]]bool preload(const std::string& map_path);
+
+        /**
+         * @brief 已读取的关卡用到的图片路径（用于构建图集与后台解码）。
+         * @return std::vector<std::string> 图片的完整路径（可能重复）。
+         */
+        std::vector<std::string> getTexturePaths();
+
+        /**
+         * @brief 把 Tiled 地图离线转换为预编译关卡文件（.lvb），不创建任何游戏对象。
+         * @param map_path Tiled JSON 地图文件路径。
+         * @param output_path 输出文件路径，一般为 level_binary::bakedPathFor(map_path)。
+         * @return bool 转换并写出成功返回 true。
+         * @note 瓦片集图片只登记路径，不会加载纹理，可在没有渲染器的情况下调用。
+         */
+        [[nodiscard]]bool bakeLevel(const std::string& map_path, const std::string& output_path);
+
     private:
+        /**
+         * @brief 读取并解析地图 JSON，设置地图信息并加载其引用的瓦片集。
+         * @param level_path 地图文件路径。
+         * @param json_data 输出的地图 JSON。
+         * @return bool 文件可读且包含 layers 数组时返回 true。
+         */
+        bool readMap(const std::string& level_path, nlohmann::json& json_data);
+
+        /** @brief 按地图属性 "broadphase" 设置物理引擎的粗检测策略。 */
+        void applyBroadphase(const std::string& broadphase, Scene& scene);
+
+        /**
+         * @brief 计算图层对应的渲染层：第一个对象图层为 render_layer::DEFAULT，前后图层依次减一、加一。
+         * @param layer_index 图层在地图中的下标。
+         * @param object_layer_index 第一个对象图层的下标（没有对象图层时为图层数量）。
+         */
+        static std::uint8_t getRenderLayer(int layer_index, int object_layer_index);
+
+        /**
+         * @brief 尝试打开与地图同目录的预编译关卡文件。
+         * @return bool 文件存在、不早于地图及瓦片集且校验通过时返回 true。
+         */
+        bool openBakedLevel(const std::string& level_path);
+
+        /** @brief 按预加载的地图 JSON 创建图层与对象。 */
+        bool loadJsonLevel(Scene& scene);
+        /** @brief 按已打开的预编译关卡创建图层与对象。 */
+        bool loadBakedLevel(Scene& scene);
+
+        /** @brief 查找瓦片 JSON 对应的预编译瓦片记录（仅预编译加载时有效），找不到返回 nullptr。 */
+        const level_binary::TileRecord* findBakedTile(const nlohmann::json& tile_json) const;
+        /** @brief 按预编译的动画表为组件添加动画，size 为单帧尺寸。 */
+        void addBakedAnimations(const level_binary::TileRecord& tile, engine::component::AnimationComponent* anim_comp, const glm::vec2& size) const;
+        /** @brief 按预编译的音效表为组件注册音效。 */
+        void addBakedSounds(const level_binary::TileRecord& tile, engine::component::AudioComponent* audio) const;
+        /** @brief 预先解析瓦片的 "animation" / "sound" 属性，写入动画表、帧表与音效表。 */
+        void bakeTileTables(const nlohmann::json& tile_json, level_binary::TileRecord& record, level_binary::LevelWriter& writer);
+
         /** @brief 解析并向场景添加图像图层（Image Layer）。 */
         void loadImageLayer(const nlohmann::json& layer_json, Scene& scene);
         /** @brief 解析并向场景添加瓦片图层（Tile Layer），包括处理每个瓦片的渲染数据。 */
@@ -70,6 +151,21 @@ namespace engine::scene {
         /** @brief 解析并向场景添加对象图层（Object Layer），如实体生成点、触发器等。 */
         void loadObjectLayer(const nlohmann::json& layer_json, Scene& scene);
 
+        /** @brief 向场景添加图片图层对象（JSON 与预编译加载共用）。 */
+        void addImageLayer(const std::string& layer_name, std::string texture_id, const glm::vec2& offset,
+            const glm::vec2& scroll_factor, const glm::bvec2& repeat, Scene& scene);
+        /** @brief 向场景添加瓦片图层对象并合并静态碰撞矩形（JSON 与预编译加载共用）。 */
+        void addTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& layer_map_size,
+            std::vector<engine::component::TileInfo> prototypes, std::vector<std::uint16_t> cells, Scene& scene);
+        /**
+         * @brief 用 ObjectBuilder 构建一个对象并加入场景（JSON 与预编译加载共用）。
+         * @param object 对象 JSON。
+         * @param gid 对象的 gid（仅用于日志）。
+         * @param tile_data 带图像对象的瓦片数据，形状对象为 std::nullopt。
+         */
+        void addObject(engine::object::ObjectBuilder& builder, const nlohmann::json& object, int gid,
+            std::optional<TileData> tile_data, Scene& scene);
+
         /**
          * @brief 获取瓦片的综合数据。
          * @param gid 全局瓦片 ID。
@@ -77,6 +173,33 @@ namespace engine::scene {
          */
         TileData getTileDataByGid(int gid);
 
+        /** @brief 空瓦片数据。 */
+        static TileData makeEmptyTileData();
+
+        /**
+         * @brief 在瓦片集的 tiles 数组中查找指定 id 的瓦片 JSON（线性查找，仅用于表外的 gid）。
+         * @param tileset 瓦片集 JSON。
+         * @param local_id 瓦片在瓦片集内的索引。
+         * @return const nlohmann::json* 找不到返回 nullptr。
+         */
+        static const nlohmann::json* findTileJson(const nlohmann::json& tileset, int local_id);
+
+        /**
+         * @brief 解析瓦片集中的一个瓦片。
+         * @param tileset 瓦片集 JSON。
+         * @param local_id 瓦片在瓦片集内的索引。
+         * @param tile_json 该瓦片在 tiles 数组中的定义，没有时为 nullptr。
+         * @return TileData 瓦片数据。
+         */
+        TileData makeTileData(const nlohmann::json& tileset, int local_id, const nlohmann::json* tile_json);
+
+        /**
+         * @brief 一次性解析瓦片集中的全部瓦片，写入 tile_table_。
+         * @param first_gid 瓦片集的起始全局 ID。
+         * @param tileset 已存入 tileset_data_ 的瓦片集 JSON。
+         */
+        void buildTileTable(int first_gid, const nlohmann::json& tileset);
+
         /**
          * @brief 获取瓦片的渲染信息（纹理坐标、源路径等）。
          * @param gid 全局瓦片 ID。
@@ -99,7 +222,14 @@ namespace engine::scene {
         void loadTileset(const std::string& tileset_path, int first_gid);
 
         /**
-         * @brief 将资源的相对路径转换为基于地图文件的绝对/完整路径。
+         * @brief 收集关卡用到的所有图片路径（可见的图片图层与已加载瓦片集中的图片），用于构建纹理图集。
+         * @param map_json 地图 JSON。
+         * @return std::vector<std::string> 图片的完整路径（可能重复）。
+         */
+        std::vector<std::string> collectTexturePaths(const nlohmann::json& map_json);
+
+        /**
+         * @brief 将资源的相对路径转换为基于地图文件的绝对/完整路径（结果按目录与相对路径缓存）。
          * @param relative_path 资源在 JSON 中记录的路径。
          * @param file_path 当前处理的文件路径。
          * @return std::string 拼接后的完整有效路径。
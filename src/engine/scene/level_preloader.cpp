@@ -0,0 +1,162 @@
+#include "level_preloader.h"
+#include "level_loader.h"
+#include "../core/context.h"
+#include "../resource/resource_manager.h"
+#include "../resource/texture_atlas.h"
+#include <spdlog/spdlog.h>
+#include <exception>
+
+namespace engine::scene {
+
+LevelPreloader::LevelPreloader(engine::core::Context& context)
+	: context_(context)
+{
+}
+
+/**
+ * @brief 析构时只等待工作线程结束，不再访问资源管理器（其可能已先于场景管理器销毁）。
+ */
+LevelPreloader::~LevelPreloader()
+{
+	cancelled_.store(true, std::memory_order_relaxed);
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+}
+
+/**
+ * @brief 开始预加载关卡。
+ * @param level_path 地图文件路径。
+ * @details 图集页尺寸需要查询渲染器，在主线程取得后再交给工作线程。
+ */
+void LevelPreloader::request(const std::string& level_path)
+{
+	if (!enabled_ || (state_ != State::IDLE && level_path_ == level_path)) {
+		return;
+	}
+	cancel();
+
+	level_path_ = level_path;
+	state_ = State::LOADING;
+	loaded_ = false;
+	worker_done_.store(false, std::memory_order_relaxed);
+	cancelled_.store(false, std::memory_order_relaxed);
+	const int page_size = context_.getResourceManager().getTextureAtlasPageSize();
+	worker_ = std::thread(&LevelPreloader::work, this, level_path, page_size);
+	spdlog::info("开始预加载关卡: {}", level_path);
+}
+
+/**
+ * @brief 工作线程：读取地图并解码关卡图片。
+ * @param level_path 地图文件路径。
+ * @param page_size 图集页边长，0 表示不打包。
+ */
+void LevelPreloader::work(std::string level_path, int page_size)
+{
+	auto level_loader = std::make_unique<LevelLoader>();
+	try {
+		loaded_ = level_loader->preload(level_path);
+		if (loaded_ && !cancelled_.load(std::memory_order_relaxed)) {
+			textures_ = engine::resource::ResourceManager::prepareTextures(level_loader->getTexturePaths(), page_size, &cancelled_);
+		}
+	}
+	catch (const std::exception& e) {
+		spdlog::error("预加载关卡 '{}' 失败: {}", level_path, e.what());
+		loaded_ = false;
+	}
+	level_loader_ = std::move(level_loader);
+	worker_done_.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief 每帧在主线程调用一次。
+ * @details 工作线程完成后把图片暂存到 ResourceManager，之后每帧在 upload_budget_ms_ 内上传。
+ */
+void LevelPreloader::update()
+{
+	if (state_ == State::LOADING && worker_done_.load(std::memory_order_acquire)) {
+		finishWorker();
+	}
+	if (state_ == State::UPLOADING && context_.getResourceManager().uploadStagedTextures(upload_budget_ms_)) {
+		state_ = State::READY;
+		spdlog::info("关卡预加载完成: {}", level_path_);
+	}
+}
+
+/**
+ * @brief 等待工作线程结束并接收其结果。
+ */
+void LevelPreloader::finishWorker()
+{
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+	if (!loaded_) {
+		spdlog::warn("预加载关卡 '{}' 失败，切换时将同步加载。", level_path_);
+		level_loader_.reset();
+		textures_.reset();
+		state_ = State::FAILED;
+		return;
+	}
+	if (textures_) {
+		context_.getResourceManager().stageTextures(std::move(textures_));
+	}
+	state_ = State::UPLOADING;
+}
+
+/**
+ * @brief 取出已预加载的关卡。
+ * @param level_path 即将加载的地图路径。
+ * @return 已读取该地图的 LevelLoader，没有可用结果时返回 nullptr。
+ */
+std::unique_ptr<LevelLoader> LevelPreloader::take(const std::string& level_path)
+{
+	if (state_ == State::IDLE || level_path_ != level_path) {
+		cancel();
+		return nullptr;
+	}
+	if (state_ == State::LOADING) {
+		spdlog::debug("等待关卡 '{}' 的预加载完成", level_path);
+		finishWorker();
+	}
+	if (state_ == State::UPLOADING) {
+		spdlog::debug("关卡 '{}' 的纹理尚未全部上传，剩余部分在构建图集时补齐", level_path);
+	}
+
+	std::unique_ptr<LevelLoader> level_loader = std::move(level_loader_);
+	state_ = State::IDLE;
+	level_path_.clear();
+	return level_loader;
+}
+
+/**
+ * @brief 取消当前预加载并丢弃结果。
+ */
+void LevelPreloader::cancel()
+{
+	if (state_ == State::IDLE) {
+		return;
+	}
+	cancelled_.store(true, std::memory_order_relaxed);
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+	if (state_ == State::UPLOADING || state_ == State::READY) {
+		context_.getResourceManager().discardStagedTextures();
+	}
+	spdlog::debug("已取消关卡 '{}' 的预加载", level_path_);
+	level_loader_.reset();
+	textures_.reset();
+	state_ = State::IDLE;
+	level_path_.clear();
+}
+
+void LevelPreloader::setEnabled(bool enabled)
+{
+	enabled_ = enabled;
+	if (!enabled_) {
+		cancel();
+	}
+}
+
+} // namespace engine::scene
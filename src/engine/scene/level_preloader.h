@@ -0,0 +1,106 @@
+#pragma once
+/**
+ * @file level_preloader.h
+ * @brief 定义 LevelPreloader，在后台线程预先读取下一关的地图并解码图片，主线程按每帧预算上传纹理。
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace engine::core {
+	class Context;
+}
+
+namespace engine::resource {
+	struct PreparedTextures;
+}
+
+namespace engine::scene {
+	class LevelLoader;
+
+	/**
+	 * @class LevelPreloader
+	 * @brief 关卡预加载器，由 SceneManager 持有，跨场景切换存在。
+	 *
+	 * 流程：
+	 * 1. request()：在工作线程中用 LevelLoader::preload() 读取地图与瓦片集，再把关卡图片解码、排版为 SDL_Surface；
+	 * 2. update()：每帧在主线程调用，工作线程完成后把图片暂存到 ResourceManager，并在时间预算内逐个上传纹理；
+	 * 3. take()：切换关卡时取出已读取地图的 LevelLoader，新场景 init() 时直接用它创建对象，
+	 *    构建图集时暂存的图片与请求一致，不再解码。
+	 *
+	 * 工作线程只访问 LevelLoader 和 SDL_Surface，不接触场景、物理引擎和渲染器。同一时刻只预加载一个关卡。
+	 */
+	class LevelPreloader final {
+	public:
+		/// 预加载进度
+		enum class State {
+			IDLE,       ///< 没有预加载
+			LOADING,    ///< 工作线程正在读取地图、解码图片
+			UPLOADING,  ///< 主线程正在逐帧上传纹理
+			READY,      ///< 全部完成，等待 take()
+			FAILED,     ///< 地图读取失败，take() 返回 nullptr（新场景照常同步加载并报告错误）
+		};
+
+	private:
+		engine::core::Context& context_;
+		bool enabled_ = true;                   ///< 关闭时 request() 不做任何事
+		float upload_budget_ms_ = 2.0f;         ///< 每帧上传纹理的时间预算（毫秒）
+
+		State state_ = State::IDLE;
+		std::string level_path_;                ///< 正在预加载的地图路径
+		std::thread worker_;
+		std::atomic<bool> worker_done_{ false };
+		std::atomic<bool> cancelled_{ false };
+
+		// 以下由工作线程写入，worker_done_ 置位并 join 之后才在主线程读取
+		std::unique_ptr<LevelLoader> level_loader_;
+		std::unique_ptr<engine::resource::PreparedTextures> textures_;
+		bool loaded_ = false;
+
+	public:
+		explicit LevelPreloader(engine::core::Context& context);
+		~LevelPreloader();
+
+		// 禁止拷贝和移动语义
+		LevelPreloader(const LevelPreloader&) = delete;
+		LevelPreloader& operator=(const LevelPreloader&) = delete;
+		LevelPreloader(LevelPreloader&&) = delete;
+		LevelPreloader& operator=(LevelPreloader&&) = delete;
+
+		/**
+		 * @brief 开始预加载关卡；已在预加载同一路径时不做任何事，其它路径的预加载会被取消。
+		 * @param level_path 地图文件路径。
+		 */
+		void request(const std::string& level_path);
+
+		/** @brief 每帧在主线程调用一次：接收工作线程的结果，并在预算内上传纹理。 */
+		void update();
+
+		/**
+		 * @brief 取出已预加载的关卡。
+		 * @param level_path 即将加载的地图路径。
+		 * @return 已读取该地图的 LevelLoader；没有预加载该路径或读取失败时返回 nullptr。
+		 * @details 工作线程尚未完成时等待其完成；未上传完的纹理留给构建图集时一次补齐。
+		 */
+		std::unique_ptr<LevelLoader> take(const std::string& level_path);
+
+		/** @brief 取消当前预加载并丢弃结果（包括已暂存的纹理）。 */
+		void cancel();
+
+		void setEnabled(bool enabled);
+		void setUploadBudget(float budget_ms) { upload_budget_ms_ = budget_ms; }
+
+		State getState() const { return state_; }
+		const std::string& getLevelPath() const { return level_path_; }
+
+	private:
+		/// 工作线程入口
+		void work(std::string level_path, int page_size);
+
+		/// 等待工作线程结束，并把解码好的图片交给 ResourceManager
+		void finishWorker();
+	};
+
+} // namespace engine::scene
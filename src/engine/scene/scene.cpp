@@ -5,7 +5,9 @@
 #include "../core/game_state.h"
 #include "../physics/physics_engine.h"
 #include "../object/game_object.h"
+#include "../component/transform_component.h"
 #include "../render/camera.h" // 添加Camera头文件
+#include "../render/renderer.h"
 #include "../ui/ui_manager.h" // 添加UI管理器头文件
 
 /**
@@ -43,6 +45,15 @@ void engine::scene::Scene::init()
 void engine::scene::Scene::update(float delta_time)
 {
 	if(!is_initialized_) return;
+	// 记录本步开始时的位姿，渲染时在上一位姿与当前位姿之间插值
+	context_.getCamera().savePreviousPosition();
+	for (const auto& obj : game_objects_) {
+		if (!obj) continue;
+		if (auto* transform = obj->getComponent<engine::component::TransformComponent>()) {
+			transform->savePreviousPose();
+		}
+	}
+
 	// 先更新物理，再更新相机与对象逻辑，避免同一帧重复积分导致抖动/延迟感
 	if(context_.getGameState().isPlaying()){
 		context_.getPhysicsEngine().update(delta_time);
@@ -77,11 +88,15 @@ void engine::scene::Scene::update(float delta_time)
 void engine::scene::Scene::render()
 {
 	if(is_initialized_){
+		// 世界空间的绘制先进入渲染队列，按 (层, z, 纹理, depth) 排序后统一提交
+		auto& renderer = context_.getRenderer();
+		renderer.beginQueue();
 		for (const auto& obj : game_objects_) {
 			if (obj) {
 				obj->render(context_);
 			}
 		}
+		renderer.submitQueue();
 		
 		// 渲染UI（在游戏对象之上）
 		if (ui_manager_) {
@@ -132,12 +147,16 @@ bool engine::scene::Scene::handleInput()
 void engine::scene::Scene::clean()
 {
 	if(is_initialized_){
+		// 所有物体都将被注销，注销时不必逐个唤醒与之接触的物体
+		auto& physics_engine = context_.getPhysicsEngine();
+		physics_engine.setTearingDown(true);
 		for (auto& obj : game_objects_) {
 			if (obj) {
 				obj->clean();
 			}
 		}
 		game_objects_.clear();
+		physics_engine.setTearingDown(false);
 		
 		// 清理UI管理器
 		if (ui_manager_) {
@@ -155,7 +174,12 @@ void engine::scene::Scene::clean()
  */
 void engine::scene::Scene::addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
 {
-	if (game_object) game_objects_.emplace_back(std::move(game_object));
+	if (!game_object) return;
+	// 加入场景前可能已被放置到别处，不从构造时的位置插值过来
+	if (auto* transform = game_object->getComponent<engine::component::TransformComponent>()) {
+		transform->resetInterpolation();
+	}
+	game_objects_.emplace_back(std::move(game_object));
 	spdlog::trace("Scene {} 添加游戏对象，当前对象数量：{}", scene_name_, game_objects_.size());
 }
 
@@ -1,5 +1,6 @@
 #include"scene_manager.h"
 #include "scene.h"
+#include "level_preloader.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::scene {
@@ -10,7 +11,8 @@ namespace engine::scene {
  */
 SceneManager::SceneManager(engine::core::Context& context)
 	: context_(context),
-	  session_data_initialized_(false)
+	  session_data_initialized_(false),
+	  level_preloader_(std::make_unique<LevelPreloader>(context))
 {
 	spdlog::info("SceneManager created");
 }
@@ -79,8 +81,11 @@ void SceneManager::update(float delta_time) {
 
 /**
  * @brief 帧渲染逻辑：从底向上叠加渲染场景栈中的所有场景。
+ * @details 固定步长下 update() 每帧可能执行多次或零次，纹理上传的每帧预算放在这里，保证每帧恰好一次。
  */
 void SceneManager::render() {
+	level_preloader_->update();
+
 	// 渲染时需要叠加渲染所有场景，而不只是栈顶
 	for (const auto& scene : scene_stack_) {
 		if (scene) {
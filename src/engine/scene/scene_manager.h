@@ -12,6 +12,7 @@ namespace engine::core {
 
 namespace engine::scene {
 	class Scene;
+	class LevelPreloader;
 
 	/**
 	 * @class SceneManager
@@ -26,6 +27,7 @@ namespace engine::scene {
 		std::vector<std::unique_ptr<Scene>> scene_stack_; ///< 场景栈，支持场景叠加（如在游戏场景上弹出UI菜单）
 		std::shared_ptr<game::data::SessionData> session_data_; ///< 共享游戏数据，跨场景持久化
 		bool session_data_initialized_; ///< 会话数据是否已初始化
+		std::unique_ptr<LevelPreloader> level_preloader_; ///< 下一关的后台预加载（跨场景切换存在）
 
 		/** @brief 待处理的场景操作类型 */
 		enum class PendingAction {
@@ -72,6 +74,9 @@ namespace engine::scene {
 		/** @brief 获取上下文引用。 */
 		engine::core::Context& getContext() const { return context_; }
 
+		/** @brief 获取关卡预加载器。 */
+		LevelPreloader& getLevelPreloader() const { return *level_preloader_; }
+
 		/**
 		 * @brief 帧更新逻辑：更新当前活跃场景，并随后处理挂起的场景操作。
 		 * @param delta_time 帧间隔时间。
@@ -79,7 +84,7 @@ namespace engine::scene {
 		void update(float delta_time);
 
 		/**
-		 * @brief 帧渲染逻辑：从底向上叠加渲染场景栈中的所有场景。
+		 * @brief 帧渲染逻辑：先在预算内上传预加载的纹理，再从底向上叠加渲染场景栈中的所有场景。
 		 */
 		void render();
 
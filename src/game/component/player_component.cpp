@@ -63,15 +63,22 @@ bool PlayerComponent::isOverLadder(engine::core::Context& context) const {
 	auto* collider = owner_->getComponent<engine::component::ColliderComponent>();
 	if (!collider) return false;
 	auto aabb = collider->getWorldAABB();
-	auto& physics_engine = context.getPhysicsEngine();
-	glm::vec2 center = aabb.position + aabb.size * 0.5f;
+	const float center_x = aabb.position.x + aabb.size.x * 0.5f;
 	const float base_y = aabb.position.y + aabb.size.y;
-	for (float dy = 2.0f; dy <= 18.0f; dy += 4.0f) {
-		if (physics_engine.getTileTypeAt(glm::vec2(center.x, base_y + dy)) == engine::component::TileType::LADDER) {
-			return true;
-		}
-	}
-	return false;
+	// 脚下 2 ~ 18 像素的竖直细条
+	const engine::utils::Rect probe{ glm::vec2(center_x, base_y + 2.0f), glm::vec2(0.0f, 16.0f) };
+	return context.getPhysicsEngine().overlapsTile(probe, engine::physics::tile_mask::LADDER);
+}
+
+bool PlayerComponent::isTouchingLadder(engine::core::Context& context) const {
+	auto* collider = owner_->getComponent<engine::component::ColliderComponent>();
+	if (!collider) return false;
+	auto aabb = collider->getWorldAABB();
+	const glm::vec2 center = aabb.position + aabb.size * 0.5f;
+	const float feet_y = aabb.position.y + aabb.size.y - 2.0f;
+	// 身体中心到脚下紧邻处的竖直细条
+	const engine::utils::Rect probe{ center, glm::vec2(0.0f, feet_y - center.y) };
+	return context.getPhysicsEngine().overlapsTile(probe, engine::physics::tile_mask::LADDER);
 }
 
 void PlayerComponent::setState(std::unique_ptr<state::PlayerState> new_state) {
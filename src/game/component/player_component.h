@@ -73,6 +73,13 @@ namespace game::component
 		 */
 		bool isOverLadder(engine::core::Context& context) const;
 
+		/**
+		 * @brief 检查玩家身体（中心到脚下）是否与梯子重叠，用于从底部进入攀爬
+		 * @param context 引擎上下文
+		 * @return 是否与梯子重叠
+		 */
+		bool isTouchingLadder(engine::core::Context& context) const;
+
 		bool isDead() const { return is_dead_; }
 		void setDead(bool is_dead) { is_dead_ = is_dead; }
 		float getMoveForce() const { return move_force_; }
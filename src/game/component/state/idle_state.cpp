@@ -47,16 +47,9 @@ std::unique_ptr<PlayerState> IdleState::jump(engine::core::Context& context)
 
 std::unique_ptr<PlayerState> IdleState::climbUp(engine::core::Context& context)
 {
-	// 底部进入梯子：允许按上进入（玩家身体中心或脚下紧邻处在梯子列中）
-	if (auto* cc = player_component_->getOwner()->getComponent<engine::component::ColliderComponent>()) {
-		auto aabb = cc->getWorldAABB();
-		glm::vec2 center = aabb.position + aabb.size * 0.5f;
-		glm::vec2 feet(center.x, aabb.position.y + aabb.size.y - 2.0f);
-		auto& pe = context.getPhysicsEngine();
-		if (pe.getTileTypeAt(center) == engine::component::TileType::LADDER || 
-		    pe.getTileTypeAt(feet) == engine::component::TileType::LADDER) {
-			return std::make_unique<ClimbState>(player_component_);
-		}
+	// 底部进入梯子：允许按上进入（玩家身体中心到脚下紧邻处与梯子重叠）
+	if (player_component_->isTouchingLadder(context)) {
+		return std::make_unique<ClimbState>(player_component_);
 	}
 	return nullptr;
 }
@@ -81,7 +74,7 @@ std::unique_ptr<PlayerState> IdleState::climbDown(engine::core::Context& context
 			{
 				glm::vec2 pos = tc->getPosition();
 				pos.x += (ladder_center_x - center.x);
-				tc->setPosition(pos);
+				tc->teleport(pos); // 吸附是瞬间完成的，不做插值
 			}
 		}
 	}
@@ -156,6 +156,10 @@ namespace game::object {
             float x_min = x_max - 90.0f;
 
             behavior = std::make_unique<game::component::JumpBehavior>(x_min, x_max, 60.0f, 250.0f, 2.0f);
+            // 跳跃产生的大冲量可能让青蛙在卡顿帧中穿透薄墙
+            if (auto* physics = game_object->getComponent<engine::component::PhysicsComponent>()) {
+                physics->setCCDEnabled(true);
+            }
             spdlog::info("GameObjectBuilder: 为 '{}' 添加 JumpBehavior, 范围: [{}, {}]",
                         game_object->getName(), x_min, x_max);
         }
@@ -169,6 +173,7 @@ namespace game::object {
             game_object->addComponent<engine::component::AIComponent>(std::move(behavior));
             // 设置敌人标签
             game_object->setTag("enemy");
+            applyCollisionFilter(game_object);
         }
     }
 
@@ -183,8 +188,15 @@ namespace game::object {
             spdlog::info("GameObjectBuilder: 为 '{}' 添加 PlayerComponent", game_object->getName());
         }
 
+        // 玩家速度最快，开启连续碰撞检测；玩家需要持续响应输入与危险瓦片，不参与自动休眠
+        if (auto* physics = game_object->getComponent<engine::component::PhysicsComponent>()) {
+            physics->setCCDEnabled(true);
+            physics->setSleepAllowed(false);
+        }
+
         // 设置玩家标签
         game_object->setTag("player");
+        applyCollisionFilter(game_object);
     }
 
     void GameObjectBuilder::buildItemComponents(engine::object::GameObject* game_object) {
@@ -196,6 +208,7 @@ namespace game::object {
 
         // 设置道具标签
         game_object->setTag("item");
+        applyCollisionFilter(game_object);
 
         // 播放idle动画
         if (auto* anim = game_object->getComponent<engine::component::AnimationComponent>()) {
@@ -25,6 +25,7 @@
 
 #include "../../engine/physics/collider.h"
 #include "../../engine/scene/level_loader.h"
+#include "../../engine/scene/level_preloader.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/render/camera.h"
 #include "../../engine/render/animation.h"
@@ -38,6 +39,8 @@
 #include "../../engine/ui/ui_button.h"
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL_rect.h>
+#include <algorithm>
+#include <limits>
 
 namespace game::scene {
 
@@ -50,17 +53,28 @@ namespace game::scene {
 
     // 构造函数：带 SessionData 的版本
     GameScene::GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager, std::shared_ptr<game::data::SessionData> session_data, std::string level_path)
+        : GameScene(std::move(name), context, scene_manager, std::move(session_data), std::move(level_path), nullptr) {
+    }
+
+    // 构造函数：带预加载结果的版本
+    GameScene::GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager, std::shared_ptr<game::data::SessionData> session_data, std::string level_path,
+        std::unique_ptr<engine::scene::LevelLoader> preloaded_level_loader)
         : Scene(name, context, scene_manager), 
           level_path_(std::move(level_path)),
-          session_data_(std::move(session_data)) {
+          session_data_(std::move(session_data)),
+          preloaded_level_loader_(std::move(preloaded_level_loader)) {
         if (!session_data_) {
             session_data_ = scene_manager_.getSessionData();
         }
         spdlog::trace("GameScene 构造完成 (带 SessionData)。");
     }
 
+    GameScene::~GameScene() = default;
+
     void GameScene::init() {
+        initCollisionHandlers();
         if (initLevel() && initPlayer() && initEnemyAndItem()) {
+            initLevelExits();
             context_.getGameState().setState(engine::core::GameStateType::Playing);
             engine::audio::AudioLocator::get().playMusic("assets/audio/platformer_level03_loop.ogg");
             spdlog::info("GameScene 初始化完成。");
@@ -73,6 +87,7 @@ namespace game::scene {
     void GameScene::update(float delta_time) {
         handleObjectCollisions();
         handleTileTriggers();
+        updateLevelPreload();
         Scene::update(delta_time);
         // HUD 更新现在由观察者模式自动处理
         // updateHUD(); // 已废弃：分数由 UIText 观察者更新，生命值由 GameScene 观察者更新
@@ -173,6 +188,8 @@ namespace game::scene {
     }
 
     void GameScene::clean() {
+        // 切换到下一关时预加载结果已被取出；其它情况（失败、返回菜单）丢弃未使用的预加载
+        scene_manager_.getLevelPreloader().cancel();
         Scene::clean();
     }
 
@@ -257,8 +274,12 @@ void GameScene::updateHUD() {
 
     bool GameScene::initLevel() {
         // 加载关卡（level_loader通常加载完成后即可销毁，因此不存为成员变量）
-        engine::scene::LevelLoader level_loader;
-        if (!level_loader.loadLevel(level_path_, *this)) {
+        // 上一关预加载过本关时，地图已在后台读取，纹理也已上传
+        auto level_loader = std::move(preloaded_level_loader_);
+        if (!level_loader) {
+            level_loader = std::make_unique<engine::scene::LevelLoader>();
+        }
+        if (!level_loader->loadLevel(level_path_, *this)) {
             spdlog::error("关卡加载失败: {}", level_path_);
             return false;
         }
@@ -556,73 +577,87 @@ void GameScene::updateHUD() {
         */
     }
 
-    void GameScene::handleObjectCollisions() {
-        // 从物理引擎中获取碰撞对
-        auto collision_pairs = context_.getPhysicsEngine().getCollisionPairs();
-        for (const auto& pair : collision_pairs) {
-            auto* obj1 = pair.first;
-            auto* obj2 = pair.second;
-
-            // 处理关卡切换触发器
-            auto checkLevelSwitch = [&](engine::object::GameObject* p, engine::object::GameObject* trigger) {
-                if (p->getTag() == "player" && (trigger->getTag() == "next_level" || trigger->getName() == "win")) {
-                    if (trigger->getName() == "win") {
-                        spdlog::info("恭喜！你赢了！");
-                        if (session_data_) {
-                            session_data_->setIsWin(true);
-                        }
-                        auto end_scene = std::make_unique<EndScene>(context_, scene_manager_, session_data_);
-                        scene_manager_.requestReplaceScene(std::move(end_scene));
-                        return true;
-                    }
-
-                    std::string next_level_path = "assets/maps/" + trigger->getName() + ".tmj";
-                    spdlog::info("玩家触碰关卡切换触发器，准备加载: {}", next_level_path);
-                    
-                    if (session_data_) {
-                        // 准备保存数据
-                        session_data_->prepareToSaveData();
-                        // 设置新的地图路径
-                        session_data_->setMapPath(next_level_path);
-                        // 保存游戏状态
-                        session_data_->save();
-                        // 取消保存数据标志
-                        session_data_->cancelSaveData();
-                    }
+    void GameScene::initCollisionHandlers() {
+        using namespace engine::physics::collision_layer;
+        using engine::physics::ContactPhase;
+        collision_dispatcher_ = std::make_unique<engine::physics::CollisionDispatcher>();
+
+        // 关卡切换触发器（next_level）与胜利区域（名为 "win" 的未分类对象）
+        collision_dispatcher_->registerHandler(PLAYER, TRIGGER, [this](auto* player, auto* trigger) {
+            return handleLevelTrigger(player, trigger);
+        });
+        collision_dispatcher_->registerHandler(PLAYER, DEFAULT, [this](auto* player, auto* trigger) {
+            return trigger->getName() == "win" && handleLevelTrigger(player, trigger);
+        });
+        // 玩家与道具：只在开始接触时处理一次
+        collision_dispatcher_->registerHandler(PLAYER, ITEM, [this](auto* player, auto* item) {
+            PlayerVSItemCollision(player, item);
+            return false;
+        });
+        // 敌人与危险物品（如尖刺对象）在持续接触期间也要处理：
+        // 无敌期间开始的接触在无敌结束后仍会造成伤害，踩踏与受伤也按每一帧的相对位置判断
+        const auto enemy_handler = [this](auto* player, auto* enemy) {
+            PlayerVSEnemyCollision(player, enemy);
+            return false;
+        };
+        collision_dispatcher_->registerHandler(PLAYER, ENEMY, enemy_handler, ContactPhase::ENTER);
+        collision_dispatcher_->registerHandler(PLAYER, ENEMY, enemy_handler, ContactPhase::STAY);
+        const auto hazard_handler = [this](auto* player, auto* /*hazard*/) {
+            processHazardDamage(player);
+            return false;
+        };
+        collision_dispatcher_->registerHandler(PLAYER, HAZARD, hazard_handler, ContactPhase::ENTER);
+        collision_dispatcher_->registerHandler(PLAYER, HAZARD, hazard_handler, ContactPhase::STAY);
+    }
 
-                    auto next_scene = std::make_unique<GameScene>("GameScene", context_, scene_manager_, session_data_, next_level_path);
-                    scene_manager_.requestReplaceScene(std::move(next_scene));
-                    return true;
+    void GameScene::handleObjectCollisions() {
+        if (!collision_dispatcher_) return;
+        // 从物理引擎中按 Enter / Stay / Exit 获取碰撞事件，按碰撞层组合分发
+        using engine::physics::ContactPhase;
+        const auto& physics_engine = context_.getPhysicsEngine();
+        for (const auto phase : { ContactPhase::ENTER, ContactPhase::STAY, ContactPhase::EXIT }) {
+            for (const auto& [obj1, obj2] : physics_engine.getCollisionEvents(phase)) {
+                if (collision_dispatcher_->dispatch(obj1, obj2, phase)) {
+                    return; // 场景即将替换，跳出循环
                 }
-                return false;
-            };
-
-            if (checkLevelSwitch(obj1, obj2) || checkLevelSwitch(obj2, obj1)) {
-                return; // 场景即将替换，跳出循环
             }
+        }
+    }
 
-            // 处理玩家与敌人的碰撞
-            if (obj1->getTag() == "player" && obj2->getTag() == "enemy") {
-                PlayerVSEnemyCollision(obj1, obj2);
-            }
-            else if (obj2->getTag() == "player" && obj1->getTag() == "enemy") {
-                PlayerVSEnemyCollision(obj2, obj1);
-            }
-            // 处理玩家与道具的碰撞
-            else if (obj1->getTag() == "player" && obj2->getTag() == "item") {
-                PlayerVSItemCollision(obj1, obj2);
-            }
-            else if (obj2->getTag() == "player" && obj1->getTag() == "item") {
-                PlayerVSItemCollision(obj2, obj1);
-            }
-            // 处理玩家与危险物品（如尖刺对象）的碰撞
-            else if (obj1->getTag() == "player" && obj2->getTag() == "hazard") {
-                processHazardDamage(obj1);
-            }
-            else if (obj2->getTag() == "player" && obj1->getTag() == "hazard") {
-                processHazardDamage(obj2);
+    bool GameScene::handleLevelTrigger(engine::object::GameObject* /*player*/, engine::object::GameObject* trigger) {
+        if (trigger->getName() == "win") {
+            spdlog::info("恭喜！你赢了！");
+            if (session_data_) {
+                session_data_->setIsWin(true);
             }
+            auto end_scene = std::make_unique<EndScene>(context_, scene_manager_, session_data_);
+            scene_manager_.requestReplaceScene(std::move(end_scene));
+            return true;
+        }
+
+        std::string next_level_path = "assets/maps/" + trigger->getName() + ".tmj";
+        spdlog::info("玩家触碰关卡切换触发器，准备加载: {}", next_level_path);
+
+        if (session_data_) {
+            // 准备保存数据
+            session_data_->prepareToSaveData();
+            // 设置新的地图路径
+            session_data_->setMapPath(next_level_path);
+            // 保存游戏状态
+            session_data_->save();
+            // 取消保存数据标志
+            session_data_->cancelSaveData();
         }
+
+        requestNextLevel(next_level_path);
+        return true;
+    }
+
+    void GameScene::requestNextLevel(const std::string& next_level_path) {
+        // 取出预加载的结果（尚未完成时等待工作线程；没有预加载时新场景照常同步加载）
+        auto level_loader = scene_manager_.getLevelPreloader().take(next_level_path);
+        auto next_scene = std::make_unique<GameScene>("GameScene", context_, scene_manager_, session_data_, next_level_path, std::move(level_loader));
+        scene_manager_.requestReplaceScene(std::move(next_scene));
     }
 
     void GameScene::PlayerVSEnemyCollision(engine::object::GameObject* player, engine::object::GameObject* enemy)
@@ -730,8 +765,16 @@ void GameScene::updateHUD() {
 
     void GameScene::handleTileTriggers()
     {
-        const auto& tile_trigger_events = context_.getPhysicsEngine().getTileTriggerEvents();
-        for (const auto& event : tile_trigger_events) {
+        using engine::physics::ContactPhase;
+        const auto& physics_engine = context_.getPhysicsEngine();
+        // 危险瓦片在持续接触期间也会造成伤害（受无敌时间限制）
+        for (const auto& [obj, tile_type] : physics_engine.getTileTriggerEvents(ContactPhase::STAY)) {
+            if (tile_type == engine::component::TileType::HAZARD && obj->getTag() == "player") {
+                processHazardDamage(obj);
+            }
+        }
+
+        for (const auto& event : physics_engine.getTileTriggerEvents(ContactPhase::ENTER)) {
             auto* obj = event.first;      // 触发事件的对象
             auto tile_type = event.second;  // 瓦片类型
             
@@ -747,14 +790,7 @@ void GameScene::updateHUD() {
                     spdlog::info("玩家到达关卡出口，准备进入下一关");
                     
                     // 确定下一关的路径
-                    std::string next_level_path;
-                    if (level_path_ == "assets/maps/level1.tmj") {
-                        next_level_path = "assets/maps/level2.tmj";
-                    } else if (level_path_ == "assets/maps/level2.tmj") {
-                        next_level_path = "assets/maps/level1.tmj"; // 循环回第一关
-                    } else {
-                        next_level_path = "assets/maps/level1.tmj"; // 默认回第一关
-                    }
+                    const std::string next_level_path = getExitTileLevelPath();
                     
                     // 保存当前状态（包含更新后的路径）
                     if (session_data_) {
@@ -766,13 +802,7 @@ void GameScene::updateHUD() {
                     }
                     
                     // 请求切换到下一关
-                    auto new_scene = std::make_unique<GameScene>(
-                        "GameScene", 
-                        context_, 
-                        scene_manager_, 
-                        session_data_,
-                        next_level_path);
-                    scene_manager_.requestReplaceScene(std::move(new_scene));
+                    requestNextLevel(next_level_path);
                     
                     break; // 只处理第一个出口触发事件
                 }
@@ -780,6 +810,76 @@ void GameScene::updateHUD() {
         }
     }
 
+    std::string GameScene::getExitTileLevelPath() const
+    {
+        if (level_path_ == "assets/maps/level1.tmj") {
+            return "assets/maps/level2.tmj";
+        }
+        else if (level_path_ == "assets/maps/level2.tmj") {
+            return "assets/maps/level1.tmj"; // 循环回第一关
+        }
+        return "assets/maps/level1.tmj"; // 默认回第一关
+    }
+
+    void GameScene::initLevelExits()
+    {
+        level_exits_.clear();
+
+        // 关卡切换触发器（名称即目标关卡）
+        for (const auto& object : game_objects_) {
+            if (object->getTag() != "next_level") continue;
+            auto* collider = object->getComponent<engine::component::ColliderComponent>();
+            if (!collider) continue;
+            level_exits_.push_back({ "assets/maps/" + object->getName() + ".tmj", collider->getWorldAABB() });
+        }
+
+        // 出口瓦片：合并为一个包围盒
+        auto* main_layer = findGameObjectByName("main");
+        auto* tile_layer = main_layer ? main_layer->getComponent<engine::component::TileLayerComponent>() : nullptr;
+        if (!tile_layer) return;
+        const auto& prototypes = tile_layer->getPrototypes();
+        const auto& cells = tile_layer->getCells();
+        const glm::ivec2 map_size = tile_layer->getMapSize();
+        glm::ivec2 min_tile(std::numeric_limits<int>::max());
+        glm::ivec2 max_tile(std::numeric_limits<int>::min());
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (prototypes[cells[i]].type != engine::component::TileType::LEVEL_EXIT) continue;
+            const glm::ivec2 tile(static_cast<int>(i) % map_size.x, static_cast<int>(i) / map_size.x);
+            min_tile = glm::min(min_tile, tile);
+            max_tile = glm::max(max_tile, tile);
+        }
+        if (min_tile.x <= max_tile.x) {
+            const glm::vec2 tile_size(tile_layer->getTileSize());
+            level_exits_.push_back({ getExitTileLevelPath(),
+                engine::utils::Rect(tile_layer->getWorldOffset() + glm::vec2(min_tile) * tile_size, glm::vec2(max_tile - min_tile + 1) * tile_size) });
+        }
+    }
+
+    void GameScene::updateLevelPreload()
+    {
+        auto* player = current_controlled_player_ ? current_controlled_player_ : player_;
+        if (level_exits_.empty() || !player) return;
+        auto* transform = player->getComponent<engine::component::TransformComponent>();
+        if (!transform) return;
+
+        // 距离某个出口不到一屏宽时开始预加载它通往的关卡（按玩家速度需要数秒才能到达，足够后台完成）
+        const glm::vec2 position = transform->getPosition();
+        const float preload_distance = context_.getCamera().getViewportSize().x;
+        const LevelExit* nearest = nullptr;
+        float nearest_distance = preload_distance;
+        for (const auto& exit : level_exits_) {
+            const glm::vec2 closest = glm::clamp(position, exit.area.position, exit.area.position + exit.area.size);
+            const float distance = glm::length(position - closest);
+            if (distance <= nearest_distance) {
+                nearest = &exit;
+                nearest_distance = distance;
+            }
+        }
+        if (nearest) {
+            scene_manager_.getLevelPreloader().request(nearest->level_path);
+        }
+    }
+
     void GameScene::processHazardDamage(engine::object::GameObject* player)
     {
         auto* player_comp = player->getComponent<game::component::PlayerComponent>();
@@ -812,11 +912,15 @@ void GameScene::updateHUD() {
         auto effect_obj = std::make_unique<engine::object::GameObject>("effect_" + tag);
         effect_obj->addComponent<engine::component::TransformComponent>(center_pos - offset);
 
+        engine::component::SpriteComponent* effect_sprite = nullptr;
         if (tag == "enemy") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png", context_.getResourceManager());
+            effect_sprite = effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png", context_.getResourceManager());
         }
         else if (tag == "item") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png", context_.getResourceManager());
+            effect_sprite = effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png", context_.getResourceManager());
+        }
+        if (effect_sprite) {
+            effect_sprite->setZOrder(1); // 特效显示在同层的角色与道具之上
         }
 
         // 添加动画组件，并设置为单次播放后自动移除
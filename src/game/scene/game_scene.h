@@ -3,13 +3,19 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include "../command/command_mapper.h"
+#include "../../engine/physics/collision_dispatcher.h"
 #include "../../engine/interface/observer.h"
+#include "../../engine/utils/math.h"
 
 // 前置声明
 namespace engine::object {
     class GameObject;
 }
 
+namespace engine::scene {
+    class LevelLoader;
+}
+
 namespace engine::ui {
     class UIPanel;
     class UIImage;
@@ -34,8 +40,17 @@ namespace game::scene {
         game::component::PlayerComponent* player_component_{ nullptr }; ///< 玩家组件指针
         engine::object::GameObject* current_controlled_player_{ nullptr }; ///< 当前被控制的玩家对象
         std::unique_ptr<game::command::CommandMapper> command_mapper_; ///< 命令映射器
+        std::unique_ptr<engine::physics::CollisionDispatcher> collision_dispatcher_; ///< 按碰撞层组合分发的碰撞处理表
         std::string level_path_;                         ///< 当前关卡的文件路径
         std::shared_ptr<game::data::SessionData> session_data_; ///< 共享游戏数据
+        std::unique_ptr<engine::scene::LevelLoader> preloaded_level_loader_; ///< 已在后台读取本关地图的加载器（可为空）
+
+        /// 关卡出口（关卡切换触发器或出口瓦片）及其通往的关卡，玩家接近时预加载
+        struct LevelExit {
+            std::string level_path;
+            engine::utils::Rect area;
+        };
+        std::vector<LevelExit> level_exits_;
         
         // HUD相关成员变量
         engine::ui::UIPanel* hud_panel_ = nullptr;       ///< HUD面板
@@ -44,6 +59,10 @@ namespace game::scene {
     public:
         GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager, std::string level_path = "assets/maps/level1.tmj");
         GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager, std::shared_ptr<game::data::SessionData> session_data, std::string level_path = "assets/maps/level1.tmj");
+        /// 使用已预加载本关地图的 LevelLoader（见 engine::scene::LevelPreloader）
+        GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager, std::shared_ptr<game::data::SessionData> session_data, std::string level_path,
+            std::unique_ptr<engine::scene::LevelLoader> preloaded_level_loader);
+        ~GameScene() override;
 
         // 覆盖场景基类的核心方法
         void init() override;
@@ -68,10 +87,16 @@ namespace game::scene {
         void switchPlayer();                         ///< @brief 切换控制的玩家对象（双人模式）
         void rebindCommandMapper(game::component::PlayerComponent* player_component); ///< @brief 重新绑定命令映射器到新的玩家
 
+        void initCollisionHandlers();               ///< @brief 注册各碰撞层组合的处理函数
         void handleObjectCollisions();              ///< @brief 处理游戏对象间的碰撞逻辑（从PhysicsEngine获取信息）
+        bool handleLevelTrigger(engine::object::GameObject* player, engine::object::GameObject* trigger); ///< @brief 玩家触碰关卡切换/胜利区域，返回 true 表示场景将被替换
         void PlayerVSEnemyCollision(engine::object::GameObject* player, engine::object::GameObject* enemy);  ///< @brief 玩家与敌人碰撞处理
         void PlayerVSItemCollision(engine::object::GameObject* player, engine::object::GameObject* item);    ///< @brief 玩家与道具碰撞处理
         void handleTileTriggers();					 ///< @brief 处理游戏对象与瓦片触发事件的逻辑
+        std::string getExitTileLevelPath() const;    ///< @brief 出口瓦片通往的关卡
+        void initLevelExits();                       ///< @brief 收集关卡出口的位置，用于预加载下一关
+        void updateLevelPreload();                   ///< @brief 玩家接近关卡出口时请求预加载对应关卡
+        void requestNextLevel(const std::string& next_level_path); ///< @brief 切换到下一关（使用预加载的结果）
         void processHazardDamage(engine::object::GameObject* player); ///< @brief 处理玩家受到的危险伤害 (尖刺、陷阱等)
         void exampleUsageOfGameObjectBuilder();     ///< @brief GameObjectBuilder使用示例（生成器模式）
         
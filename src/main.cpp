@@ -6,7 +6,11 @@
 #include "engine/core/game_app.h"
 #include<spdlog/spdlog.h>
 #include "engine/scene/scene_manager.h"
+#include "engine/scene/level_loader.h"
+#include "engine/scene/level_binary.h"
 #include "game/scene/title_scene.h"
+#include <filesystem>
+#include <string_view>
 
 /**
  * @brief 游戏的主入口函数。
@@ -24,7 +28,37 @@ void onInitSceneManager(engine::scene::SceneManager& scene_manager) {
     scene_manager.requestPushScene(std::make_unique<game::scene::TitleScene>(scene_manager.getContext(), scene_manager));
 }
 
-int main(int /* argc */, char* /* argv */[]) {
+/**
+ * @brief 把目录下的所有 Tiled 地图（.tmj）转换为预编译关卡文件（.lvb），不启动游戏。
+ * @param map_dir 地图目录。
+ * @return 全部成功返回 0，否则返回 1。
+ */
+int bakeLevels(const std::string& map_dir) {
+    std::error_code ec;
+    std::filesystem::directory_iterator it(map_dir, ec);
+    if (ec) {
+        spdlog::error("无法打开地图目录 '{}': {}", map_dir, ec.message());
+        return 1;
+    }
+    int failed = 0;
+    for (const auto& entry : it) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".tmj") continue;
+        const std::string map_path = entry.path().generic_string();
+        engine::scene::LevelLoader level_loader;
+        if (!level_loader.bakeLevel(map_path, engine::scene::level_binary::bakedPathFor(map_path))) {
+            ++failed;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    spdlog::set_level(spdlog::level::info);
+    // --bake-levels [目录]：离线预编译关卡（默认 assets/maps）
+    if (argc >= 2 && std::string_view(argv[1]) == "--bake-levels") {
+        return bakeLevels(argc >= 3 ? argv[2] : "assets/maps");
+    }
+
     engine::core::GameApp app;
     spdlog::set_level(spdlog::level::info);
     app.setOnInitCallback(onInitSceneManager);